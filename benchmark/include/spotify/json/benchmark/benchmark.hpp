@@ -20,7 +20,11 @@
 #include <iostream>
 
 template <typename test_fn>
-void benchmark(const char *name, const size_t count, const test_fn &test) {
+void benchmark(
+    const char *name,
+    const size_t count,
+    const test_fn &test,
+    const size_t bytes_per_run = 0) {
   using namespace std::chrono;
   const auto before = high_resolution_clock::now();
   for (unsigned i = 0; i < count; i++) {
@@ -35,9 +39,16 @@ void benchmark(const char *name, const size_t count, const test_fn &test) {
   std::cerr
       << name << ": "
       << duration_us_avg << " us avg (" << count << " runs), "
-      << duration_ms << " ms total"
-      << std::endl;
+      << duration_ms << " ms total";
+  if (bytes_per_run && duration_us) {
+    const auto bytes_total = static_cast<double>(bytes_per_run) * count;
+    std::cerr << ", " << (bytes_total / duration_us) << " MB/s";
+  }
+  std::cerr << std::endl;
 }
 
 #define JSON_BENCHMARK(n, test) \
   benchmark(typeid(*this).name(), static_cast<size_t>(n), (test))
+
+#define JSON_BENCHMARK_THROUGHPUT(n, bytes_per_run, test) \
+  benchmark(typeid(*this).name(), static_cast<size_t>(n), (test), static_cast<size_t>(bytes_per_run))
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/empty_as.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode_context.hpp>
+
+#include <spotify/json/benchmark/benchmark.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(codec)
+
+namespace {
+
+/**
+ * An array of n values, every other of which is null.
+ */
+std::string make_half_null_json(const std::string &value, const size_t n) {
+  std::string json = "[";
+  for (size_t i = 0; i < n; i++) {
+    json += (i ? "," : "") + (i % 2 ? std::string("null") : value);
+  }
+  return json + "]";
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_empty_as_null_string_half_null) {
+  const auto codec = array<std::vector<std::string>>(empty_as_null(string()));
+  const auto json = make_half_null_json("\"abc\"", 1000);
+
+  JSON_BENCHMARK(1e3, [&]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_empty_as_null_integer_half_null) {
+  const auto codec = array<std::vector<int>>(empty_as_null(number<int>()));
+  const auto json = make_half_null_json("123", 1000);
+
+  JSON_BENCHMARK(1e3, [&]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // codec
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
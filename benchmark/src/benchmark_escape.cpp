@@ -14,11 +14,13 @@
  * the License.
  */
 
+#include <iostream>
 #include <string>
 
 #include <boost/test/unit_test.hpp>
 
 #include <spotify/json/detail/escape.hpp>
+#include <spotify/json/instruction_set.hpp>
 
 #include <spotify/json/benchmark/benchmark.hpp>
 
@@ -44,6 +46,53 @@ std::string generate_string(size_t size, bool add_special_characters) {
   return string;
 }
 
+/**
+ * A string where every period:th character is a quotation mark, backslash,
+ * newline or tab, which all have two character escape sequences.
+ */
+std::string generate_escaped_string(size_t size, size_t period) {
+  static const char special[] = { '"', '\\', '\n', '\t' };
+  std::string string;
+  for (size_t i = 0; i < size; i++) {
+    string += (i % period) ? char('a' + i % 26) : special[(i / period) % 4];
+  }
+  return string;
+}
+
+/**
+ * Escape a long string like input once into an empty context, and report the
+ * size of the buffer that it ended up with relative to the escaped size.
+ */
+/**
+ * A mostly ASCII string with some UTF-8 sequences and characters that are
+ * special in HTML, like a text in a European language with some markup.
+ */
+std::string generate_text_string(size_t size) {
+  static const char *special[] = { "\xC3\xA5", "<", "\xC3\xA9", ">", "&" };
+  std::string string;
+  for (size_t i = 0; string.size() < size; i++) {
+    if (i % 40 == 0) {
+      string += special[(i / 40) % 5];
+    } else {
+      string += char('a' + i % 26);
+    }
+  }
+  return string;
+}
+
+void report_peak_buffer_size(const std::string &input, kernel_table::escape_function write_escaped) {
+  std::string long_input;
+  while (long_input.size() < 10 * 1024 * 1024) {
+    long_input += input;
+  }
+
+  encode_context context(0);
+  write_escaped(context, long_input.data(), long_input.data() + long_input.size());
+  std::cerr
+      << "  peak buffer size: " << context.capacity() << " bytes for "
+      << context.size() << " escaped bytes" << std::endl;
+}
+
 void check_escaped(const std::string &expected, const std::string &input) {
   encode_context context;
   write_escaped(context, input.data(), input.data() + input.size());
@@ -58,8 +107,7 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_simple_string) {
   volatile size_t n = 0;
   JSON_BENCHMARK(1e5, [&] {
     encode_context context;
-    *const_cast<bool *>(&context.has_sse42) = false;
-    write_escaped(context, begin, begin + input.size());
+    write_escaped_scalar(context, begin, begin + input.size());
     n += context.size();
   });
 }
@@ -67,19 +115,44 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_simple_string) {
 #if defined(json_arch_x86_sse42)
 
 BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_simple_string_sse42) {
+  if (supported_instruction_set() < instruction_set::sse42) {
+    return;
+  }
+
   const auto input = generate_string(8192, false);
   const auto begin = input.data();
 
   volatile size_t n = 0;
   JSON_BENCHMARK(1e5, [&] {
     encode_context context;
-    write_escaped(context, begin, begin + input.size());
+    write_escaped_sse42(context, begin, begin + input.size());
     n += context.size();
   });
 }
 
 #endif  // defined(json_arch_x86_sse42)
 
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_simple_string_avx2) {
+  if (supported_instruction_set() < instruction_set::avx2) {
+    return;
+  }
+
+  const auto input = generate_string(8192, false);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped_avx2(context, begin, begin + input.size());
+    n += context.size();
+  });
+  report_peak_buffer_size(input, &write_escaped_avx2);
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
 BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_complex_string) {
   const auto input = generate_string(8192, true);
   const auto begin = input.data();
@@ -87,8 +160,7 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_complex_string) {
   volatile size_t n = 0;
   JSON_BENCHMARK(1e5, [&] {
     encode_context context;
-    *const_cast<bool *>(&context.has_sse42) = false;
-    write_escaped(context, begin, begin + input.size());
+    write_escaped_scalar(context, begin, begin + input.size());
     n += context.size();
   });
 }
@@ -96,19 +168,270 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_complex_string) {
 #if defined(json_arch_x86_sse42)
 
 BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_complex_string_sse42) {
+  if (supported_instruction_set() < instruction_set::sse42) {
+    return;
+  }
+
   const auto input = generate_string(8192, true);
   const auto begin = input.data();
 
   volatile size_t n = 0;
   JSON_BENCHMARK(1e5, [&] {
     encode_context context;
-    write_escaped(context, begin, begin + input.size());
+    write_escaped_sse42(context, begin, begin + input.size());
     n += context.size();
   });
 }
 
 #endif  // defined(json_arch_x86_sse42)
 
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_complex_string_avx2) {
+  if (supported_instruction_set() < instruction_set::avx2) {
+    return;
+  }
+
+  const auto input = generate_string(8192, true);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped_avx2(context, begin, begin + input.size());
+    n += context.size();
+  });
+  report_peak_buffer_size(input, &write_escaped_avx2);
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_sparse_escapes) {
+  const auto input = generate_escaped_string(8192, 64);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped_scalar(context, begin, begin + input.size());
+    n += context.size();
+  });
+  report_peak_buffer_size(input, &write_escaped_scalar);
+}
+
+#if defined(json_arch_x86_sse42)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_sparse_escapes_sse42) {
+  if (supported_instruction_set() < instruction_set::sse42) {
+    return;
+  }
+
+  const auto input = generate_escaped_string(8192, 64);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped_sse42(context, begin, begin + input.size());
+    n += context.size();
+  });
+  report_peak_buffer_size(input, &write_escaped_sse42);
+}
+
+#endif  // defined(json_arch_x86_sse42)
+
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_sparse_escapes_avx2) {
+  if (supported_instruction_set() < instruction_set::avx2) {
+    return;
+  }
+
+  const auto input = generate_escaped_string(8192, 64);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped_avx2(context, begin, begin + input.size());
+    n += context.size();
+  });
+  report_peak_buffer_size(input, &write_escaped_avx2);
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_dense_escapes) {
+  const auto input = generate_escaped_string(8192, 4);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped_scalar(context, begin, begin + input.size());
+    n += context.size();
+  });
+  report_peak_buffer_size(input, &write_escaped_scalar);
+}
+
+#if defined(json_arch_x86_sse42)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_dense_escapes_sse42) {
+  if (supported_instruction_set() < instruction_set::sse42) {
+    return;
+  }
+
+  const auto input = generate_escaped_string(8192, 4);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped_sse42(context, begin, begin + input.size());
+    n += context.size();
+  });
+  report_peak_buffer_size(input, &write_escaped_sse42);
+}
+
+#endif  // defined(json_arch_x86_sse42)
+
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_dense_escapes_avx2) {
+  if (supported_instruction_set() < instruction_set::avx2) {
+    return;
+  }
+
+  const auto input = generate_escaped_string(8192, 4);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped_avx2(context, begin, begin + input.size());
+    n += context.size();
+  });
+  report_peak_buffer_size(input, &write_escaped_avx2);
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_ascii_text_string) {
+  const auto input = generate_text_string(8192);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped_ascii_scalar(context, begin, begin + input.size());
+    n += context.size();
+  });
+}
+
+#if defined(json_arch_x86_sse42)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_ascii_text_string_sse42) {
+  if (supported_instruction_set() < instruction_set::sse42) {
+    return;
+  }
+
+  const auto input = generate_text_string(8192);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped_ascii_sse42(context, begin, begin + input.size());
+    n += context.size();
+  });
+}
+
+#endif  // defined(json_arch_x86_sse42)
+
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_ascii_text_string_avx2) {
+  if (supported_instruction_set() < instruction_set::avx2) {
+    return;
+  }
+
+  const auto input = generate_text_string(8192);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped_ascii_avx2(context, begin, begin + input.size());
+    n += context.size();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_html_text_string) {
+  const auto input = generate_text_string(8192);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped_html_scalar(context, begin, begin + input.size());
+    n += context.size();
+  });
+}
+
+#if defined(json_arch_x86_sse42)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_html_text_string_sse42) {
+  if (supported_instruction_set() < instruction_set::sse42) {
+    return;
+  }
+
+  const auto input = generate_text_string(8192);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped_html_sse42(context, begin, begin + input.size());
+    n += context.size();
+  });
+}
+
+#endif  // defined(json_arch_x86_sse42)
+
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_html_text_string_avx2) {
+  if (supported_instruction_set() < instruction_set::avx2) {
+    return;
+  }
+
+  const auto input = generate_text_string(8192);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped_html_avx2(context, begin, begin + input.size());
+    n += context.size();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_write_escaped_trusted_text_string) {
+  const auto input = generate_text_string(8192);
+  const auto begin = input.data();
+
+  volatile size_t n = 0;
+  JSON_BENCHMARK(1e5, [&] {
+    encode_context context;
+    write_escaped(context, begin, begin + input.size(), escape_policy::trusted);
+    n += context.size();
+  });
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // detail
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
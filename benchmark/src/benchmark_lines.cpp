@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode_lines.hpp>
+
+#include <spotify/json/benchmark/benchmark.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+struct log_record {
+  std::string uri;
+  std::string user;
+  int duration_ms;
+  std::vector<int> positions;
+};
+
+codec::object_t<log_record> log_record_codec() {
+  auto codec = codec::object<log_record>();
+  codec.required("uri", &log_record::uri);
+  codec.required("user", &log_record::user);
+  codec.required("duration_ms", &log_record::duration_ms);
+  codec.optional("positions", &log_record::positions);
+  return codec;
+}
+
+std::string generate_log(const size_t num_lines) {
+  std::string json;
+  for (size_t i = 0; i < num_lines; i++) {
+    json += R"({"uri":"spotify:track:)" + std::to_string(i * 7919) + R"(",)";
+    json += R"("user":"user)" + std::to_string(i % 1000) + R"(",)";
+    json += R"("duration_ms":)" + std::to_string(i % 300000) + ",";
+    json += R"("positions":[1,2,3,5,8,13],"ignored":{"a":[true,null]}})" "\n";
+  }
+  return json;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_json_decode_lines) {
+  const auto codec = log_record_codec();
+  const auto json = generate_log(100000);
+  const auto max_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+  for (size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    const auto name = "decode_lines with " + std::to_string(num_threads) + " threads";
+    benchmark(name.c_str(), 10, [&]{
+      decode_lines(codec, json, num_threads);
+    }, json.size());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -14,10 +14,15 @@
  * the License.
  */
 
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <string>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
+#include <spotify/json/codec/array.hpp>
 #include <spotify/json/codec/number.hpp>
 #include <spotify/json/decode.hpp>
 #include <spotify/json/encode.hpp>
@@ -29,6 +34,70 @@ BOOST_AUTO_TEST_SUITE(spotify)
 BOOST_AUTO_TEST_SUITE(json)
 BOOST_AUTO_TEST_SUITE(codec)
 
+namespace {
+
+/**
+ * A comma separated list of integers spread over the range of the type, so
+ * that most of them have as many digits as the type allows, like IDs and
+ * timestamps. Every other integer is negative for signed types.
+ */
+template <typename T>
+std::string generate_integers(const size_t count) {
+  std::string json;
+  const auto step = std::numeric_limits<T>::max() / T(count);
+  for (size_t i = 1; i <= count; i++) {
+    const auto value = T(step * T(i));
+    json += std::to_string((std::numeric_limits<T>::is_signed && i % 2) ? T(-value) : value);
+    json += ',';
+  }
+  return json;
+}
+
+template <typename T>
+void benchmark_decode_integers(const char *name) {
+  const auto codec = number<T>();
+  const auto json = generate_integers<T>(100);
+  volatile T sum = 0;
+  benchmark(name, 1e5, [&]{
+    decode_context context(json.data(), json.data() + json.size());
+    while (context.remaining()) {
+      sum += codec.decode(context);
+      context.position++;  // skip the comma
+    }
+  }, json.size());
+}
+
+/**
+ * A feature vector: values in (-1, 1) that use all the precision of the type,
+ * so that most of them are printed with as many digits as the type needs.
+ */
+template <typename T>
+std::vector<T> generate_feature_vector(const size_t count) {
+  std::vector<T> values;
+  for (size_t i = 0; i < count; i++) {
+    values.push_back(T(std::sin(double(i) * 0.7)));
+  }
+  return values;
+}
+
+template <typename T>
+void benchmark_encode_feature_vector(const char *name) {
+  const auto values = generate_feature_vector<T>(1000);
+  benchmark(name, 1e3, [&]{
+    encode(values);
+  });
+}
+
+template <typename T>
+void benchmark_decode_feature_vector(const char *name) {
+  const auto json = encode(generate_feature_vector<T>(1000));
+  benchmark(name, 1e3, [&]{
+    decode<std::vector<T>>(json);
+  }, json.size());
+}
+
+}  // namespace
+
 BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_encode_positive_int32_t) {
   const auto codec = number<int32_t>();
   JSON_BENCHMARK(1e6, [=]{
@@ -73,6 +142,54 @@ BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_encode_positive_uint64_t) {
   });
 }
 
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_decode_int8_t) {
+  benchmark_decode_integers<int8_t>(typeid(*this).name());
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_decode_int16_t) {
+  benchmark_decode_integers<int16_t>(typeid(*this).name());
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_decode_int32_t) {
+  benchmark_decode_integers<int32_t>(typeid(*this).name());
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_decode_int64_t) {
+  benchmark_decode_integers<int64_t>(typeid(*this).name());
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_decode_uint8_t) {
+  benchmark_decode_integers<uint8_t>(typeid(*this).name());
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_decode_uint16_t) {
+  benchmark_decode_integers<uint16_t>(typeid(*this).name());
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_decode_uint32_t) {
+  benchmark_decode_integers<uint32_t>(typeid(*this).name());
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_decode_uint64_t) {
+  benchmark_decode_integers<uint64_t>(typeid(*this).name());
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_encode_float_feature_vector) {
+  benchmark_encode_feature_vector<float>(typeid(*this).name());
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_encode_double_feature_vector) {
+  benchmark_encode_feature_vector<double>(typeid(*this).name());
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_decode_float_feature_vector) {
+  benchmark_decode_feature_vector<float>(typeid(*this).name());
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_number_decode_double_feature_vector) {
+  benchmark_decode_feature_vector<double>(typeid(*this).name());
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // codec
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
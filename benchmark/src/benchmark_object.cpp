@@ -14,21 +14,49 @@
  * the License.
  */
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include <sstream>
 
 #include <boost/test/unit_test.hpp>
 
+#include <spotify/json/chunked_decoder.hpp>
+#include <spotify/json/codec/array.hpp>
 #include <spotify/json/codec/object.hpp>
 #include <spotify/json/decode.hpp>
+#include <spotify/json/decode_error.hpp>
 #include <spotify/json/decode_exception.hpp>
 #include <spotify/json/encode.hpp>
+#include <spotify/json/padded_string.hpp>
 
 #include <spotify/json/benchmark/benchmark.hpp>
 
 BOOST_AUTO_TEST_SUITE(spotify)
 BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+struct track_t {
+  std::string uri;
+  std::string name;
+  int duration;
+};
+
+}  // namespace
+
+template <>
+struct default_codec_t<track_t> {
+  static codec::object_t<track_t> codec() {
+    auto codec = codec::object<track_t>();
+    codec.required("uri", &track_t::uri);
+    codec.required("name", &track_t::name);
+    codec.required("duration", &track_t::duration);
+    return codec;
+  }
+};
+
 BOOST_AUTO_TEST_SUITE(codec)
 
 struct struct_t {
@@ -84,6 +112,159 @@ BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_with_many_required_field
   });
 }
 
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_with_many_required_fields_padded) {
+  const auto codec = required_codec(1000);
+  const auto json = padded_string(make_json(1000));
+
+  JSON_BENCHMARK(1e4, [&]{
+    auto context = decode_context(json.data(), json.size(), decode_context::padded_input());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_with_few_required_fields_predicted) {
+  auto codec = required_codec(50);
+  codec.predict_field_order();
+  const auto json = make_json(50);
+
+  JSON_BENCHMARK(1e5, [=]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_with_many_required_fields_predicted) {
+  auto codec = required_codec(1000);
+  codec.predict_field_order();
+  const auto json = make_json(1000);
+
+  JSON_BENCHMARK(1e4, [=]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_with_long_and_unknown_keys) {
+  auto codec = codec::object<struct_t>();
+  std::string json = "{";
+  for (size_t i = 0; i < 20; i++) {
+    const auto key = "a_field_name_beyond_the_sso_limit_" + std::to_string(i);
+    codec.required(key, &struct_t::integer);
+    json += "\"" + key + "\":0,\"an_unknown_field_name_beyond_the_sso_limit_" + std::to_string(i) + "\":0,";
+  }
+  json.back() = '}';
+
+  JSON_BENCHMARK(1e5, [=]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_encode_with_few_fields) {
+  const auto codec = required_codec(50);
+  const auto object = struct_t{ 1234 };
+
+  JSON_BENCHMARK(1e5, [=]{
+    encode_context context;
+    codec.encode(context, object);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_encode_with_many_fields) {
+  const auto codec = required_codec(1000);
+  const auto object = struct_t{ 1234 };
+
+  JSON_BENCHMARK(1e4, [=]{
+    encode_context context;
+    codec.encode(context, object);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_with_new_default_codec) {
+  const std::string json = R"({"uri":"spotify:track:1","name":"Song","duration":180000})";
+
+  JSON_BENCHMARK(1e5, [&]{
+    decode(default_codec<track_t>(), json);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_with_cached_default_codec) {
+  const std::string json = R"({"uri":"spotify:track:1","name":"Song","duration":180000})";
+
+  JSON_BENCHMARK(1e5, [&]{
+    decode<track_t>(json);
+  });
+}
+
+std::string make_json_array(size_t num_elements, size_t n) {
+  const auto element = make_json(n);
+  std::string json = "[";
+  for (size_t i = 0; i < num_elements; i++) {
+    json += (i ? "," : "") + element;
+  }
+  return json + "]";
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_array_in_accumulated_chunks) {
+  const auto codec = codec::array<std::vector<struct_t>>(required_codec(20));
+  const auto json = make_json_array(10000, 20);
+  const size_t chunk_size = 16384;
+
+  JSON_BENCHMARK(10, [&]{
+    std::string buffer;
+    for (size_t i = 0; i < json.size(); i += chunk_size) {
+      buffer.append(json.data() + i, std::min(chunk_size, json.size() - i));
+    }
+    decode(codec, buffer);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_decode_array_with_chunked_decoder) {
+  const auto codec = codec::array<std::vector<struct_t>>(required_codec(20));
+  const auto json = make_json_array(10000, 20);
+  const size_t chunk_size = 16384;
+
+  JSON_BENCHMARK(10, [&]{
+    auto decoder = make_chunked_decoder(codec);
+    for (size_t i = 0; i < json.size(); i += chunk_size) {
+      decoder.append(json.data() + i, std::min(chunk_size, json.size() - i));
+    }
+    decoder.finish();
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_try_decode_valid) {
+  const auto codec = required_codec(50);
+  const auto json = make_json(50);
+
+  JSON_BENCHMARK(1e5, [&]{
+    struct_t object;
+    decode_error error;
+    try_decode(object, codec, json, error);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_try_decode_invalid) {
+  const auto codec = required_codec(50);
+  const auto json = make_json(50).substr(0, 200);
+
+  JSON_BENCHMARK(1e5, [&]{
+    struct_t object;
+    try_decode(object, codec, json);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_object_try_decode_invalid_with_error) {
+  const auto codec = required_codec(50);
+  const auto json = make_json(50).substr(0, 200);
+
+  JSON_BENCHMARK(1e5, [&]{
+    struct_t object;
+    decode_error error;
+    try_decode(object, codec, json, error);
+  });
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // codec
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
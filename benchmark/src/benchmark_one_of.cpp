@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/boolean.hpp>
+#include <spotify/json/codec/null.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/one_of.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/codec/transform.hpp>
+#include <spotify/json/decode_context.hpp>
+
+#include <spotify/json/benchmark/benchmark.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(codec)
+
+namespace {
+
+auto two_alternatives() -> decltype(one_of(string(), null<std::string>())) {
+  return one_of(string(), null<std::string>());
+}
+
+int encode_int(const std::string &value) {
+  return std::stoi(value);
+}
+
+std::string decode_int(const int value) {
+  return std::to_string(value);
+}
+
+bool encode_bool(const std::string &value) {
+  return (value == "true");
+}
+
+std::string decode_bool(const bool value) {
+  return (value ? "true" : "false");
+}
+
+auto four_alternatives() -> decltype(one_of(
+    string(),
+    transform(number<int>(), &encode_int, &decode_int),
+    transform(boolean(), &encode_bool, &decode_bool),
+    null<std::string>())) {
+  return one_of(
+      string(),
+      transform(number<int>(), &encode_int, &decode_int),
+      transform(boolean(), &encode_bool, &decode_bool),
+      null<std::string>());
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_one_of_2_first) {
+  const auto codec = two_alternatives();
+  const std::string json = "\"abc\"";
+
+  JSON_BENCHMARK(1e6, [&]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_one_of_2_last) {
+  const auto codec = two_alternatives();
+  const std::string json = "null";
+
+  JSON_BENCHMARK(1e6, [&]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_one_of_4_first) {
+  const auto codec = four_alternatives();
+  const std::string json = "\"abc\"";
+
+  JSON_BENCHMARK(1e6, [&]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_one_of_4_last) {
+  const auto codec = four_alternatives();
+  const std::string json = "null";
+
+  JSON_BENCHMARK(1e6, [&]{
+    auto context = decode_context(json.data(), json.data() + json.size());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // codec
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
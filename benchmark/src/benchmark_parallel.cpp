@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/decode_parallel.hpp>
+
+#include <spotify/json/benchmark/benchmark.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+struct play {
+  std::string uri;
+  int duration_ms;
+  int position;
+};
+
+codec::object_t<play> play_codec() {
+  auto codec = codec::object<play>();
+  codec.required("uri", &play::uri);
+  codec.required("duration_ms", &play::duration_ms);
+  codec.required("position", &play::position);
+  return codec;
+}
+
+/**
+ * A JSON array of 'size' bytes or a little more, with one small object per
+ * element.
+ */
+std::string generate_plays(const size_t size) {
+  std::string json;
+  json.reserve(size + 256);
+  json += "[";
+  for (size_t i = 0; json.size() < size; i++) {
+    json += (i ? "," : "");
+    json += R"({"uri":"spotify:track:)" + std::to_string(i * 7919) + R"(","duration_ms":)";
+    json += std::to_string(i % 300000) + R"(,"position":)" + std::to_string(i % 100) + "}";
+  }
+  json += "]";
+  return json;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_json_decode_parallel_large_array) {
+  const auto codec = codec::array<std::vector<play>>(play_codec());
+  const auto json = generate_plays(1024 * 1024 * 1024);
+  const auto max_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+  benchmark("decode", 1, [&]{
+    decode(codec, json);
+  }, json.size());
+
+  for (size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    const auto name = "decode_parallel with " + std::to_string(num_threads) + " threads";
+    benchmark(name.c_str(), 1, [&]{
+      decode_parallel(codec, json, num_threads);
+    }, json.size());
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
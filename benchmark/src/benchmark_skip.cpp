@@ -14,6 +14,7 @@
  * the License.
  */
 
+#include <cstring>
 #include <string>
 
 #include <boost/test/unit_test.hpp>
@@ -21,6 +22,8 @@
 #include <spotify/json/decode_context.hpp>
 #include <spotify/json/detail/macros.hpp>
 #include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/detail/skip_value.hpp>
+#include <spotify/json/instruction_set.hpp>
 
 #include <spotify/json/benchmark/benchmark.hpp>
 
@@ -44,11 +47,11 @@ std::string generate_simple_string(size_t size) {
 
 BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_simple_characters) {
   const auto json = generate_simple_string(8192);
+  auto context = decode_context(json.data(), json.data() + json.size());
   volatile size_t n = 0;
-  JSON_BENCHMARK(1e6, [&]{
-    auto context = decode_context(json.data(), json.data() + json.size());
-    *const_cast<bool *>(&context.has_sse42) = false;
-    detail::skip_any_simple_characters(context);
+  JSON_BENCHMARK_THROUGHPUT(1e6, json.size(), [&]{
+    context.position = context.begin;
+    skip_any_simple_characters_scalar(context);
     n += context.offset();
   });
 }
@@ -56,17 +59,60 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_simple_characters) {
 #if defined(json_arch_x86_sse42)
 
 BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_simple_characters_sse42) {
+  if (supported_instruction_set() < instruction_set::sse42) {
+    return;
+  }
+
   const auto json = generate_simple_string(8192);
+  auto context = decode_context(json.data(), json.data() + json.size());
   volatile size_t n = 0;
-  JSON_BENCHMARK(1e6, [&]{
-    auto context = decode_context(json.data(), json.data() + json.size());
-    detail::skip_any_simple_characters(context);
+  JSON_BENCHMARK_THROUGHPUT(1e6, json.size(), [&]{
+    context.position = context.begin;
+    skip_any_simple_characters_sse42(context);
     n += context.offset();
   });
 }
 
 #endif  // defined(json_arch_x86_sse42)
 
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_simple_characters_avx2) {
+  if (supported_instruction_set() < instruction_set::avx2) {
+    return;
+  }
+
+  const auto json = generate_simple_string(8192);
+  auto context = decode_context(json.data(), json.data() + json.size());
+  volatile size_t n = 0;
+  JSON_BENCHMARK_THROUGHPUT(1e6, json.size(), [&]{
+    context.position = context.begin;
+    skip_any_simple_characters_avx2(context);
+    n += context.offset();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
+#if defined(json_arch_x86_avx512bw)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_simple_characters_avx512bw) {
+  if (supported_instruction_set() < instruction_set::avx512bw) {
+    return;
+  }
+
+  const auto json = generate_simple_string(8192);
+  auto context = decode_context(json.data(), json.data() + json.size());
+  volatile size_t n = 0;
+  JSON_BENCHMARK_THROUGHPUT(1e6, json.size(), [&]{
+    context.position = context.begin;
+    skip_any_simple_characters_avx512bw(context);
+    n += context.offset();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx512bw)
+
 std::string generate_whitespace_string(size_t size) {
   std::string string;
   for (size_t i = 0; i < size; i++) {
@@ -84,11 +130,11 @@ std::string generate_whitespace_string(size_t size) {
 
 BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_whitespace) {
   const auto json = generate_whitespace_string(8192);
+  auto context = decode_context(json.data(), json.data() + json.size());
   volatile size_t n = 0;
-  JSON_BENCHMARK(1e6, [&]{
-    auto context = decode_context(json.data(), json.data() + json.size());
-    *const_cast<bool *>(&context.has_sse42) = false;
-    detail::skip_any_whitespace(context);
+  JSON_BENCHMARK_THROUGHPUT(1e6, json.size(), [&]{
+    context.position = context.begin;
+    skip_any_whitespace_scalar(context);
     n += context.offset();
   });
 }
@@ -96,17 +142,233 @@ BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_whitespace) {
 #if defined(json_arch_x86_sse42)
 
 BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_whitespace_sse42) {
+  if (supported_instruction_set() < instruction_set::sse42) {
+    return;
+  }
+
   const auto json = generate_whitespace_string(8192);
+  auto context = decode_context(json.data(), json.data() + json.size());
   volatile size_t n = 0;
-  JSON_BENCHMARK(1e6, [&]{
-    auto context = decode_context(json.data(), json.data() + json.size());
-    detail::skip_any_whitespace(context);
+  JSON_BENCHMARK_THROUGHPUT(1e6, json.size(), [&]{
+    context.position = context.begin;
+    skip_any_whitespace_sse42(context);
     n += context.offset();
   });
 }
 
 #endif  // defined(json_arch_x86_sse42)
 
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_whitespace_avx2) {
+  if (supported_instruction_set() < instruction_set::avx2) {
+    return;
+  }
+
+  const auto json = generate_whitespace_string(8192);
+  auto context = decode_context(json.data(), json.data() + json.size());
+  volatile size_t n = 0;
+  JSON_BENCHMARK_THROUGHPUT(1e6, json.size(), [&]{
+    context.position = context.begin;
+    skip_any_whitespace_avx2(context);
+    n += context.offset();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
+#if defined(json_arch_x86_avx512bw)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_any_whitespace_avx512bw) {
+  if (supported_instruction_set() < instruction_set::avx512bw) {
+    return;
+  }
+
+  const auto json = generate_whitespace_string(8192);
+  auto context = decode_context(json.data(), json.data() + json.size());
+  volatile size_t n = 0;
+  JSON_BENCHMARK_THROUGHPUT(1e6, json.size(), [&]{
+    context.position = context.begin;
+    skip_any_whitespace_avx512bw(context);
+    n += context.offset();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx512bw)
+
+/**
+ * Skip 'count' short runs of simple characters (like object keys) or
+ * whitespace at different alignments, as padded input or not.
+ */
+template <void (*skip)(decode_context &)>
+void benchmark_skip_short(const char *name, const char *tpl, const bool padded) {
+  const auto size = std::strlen(tpl);
+  const auto count = size_t(1024);
+  std::string json;
+  for (size_t i = 0; i < count; i++) {
+    json += std::string(tpl, tpl + size - (i % 4)) + "\"";
+  }
+  json.append(decode_padding, ' ');
+
+  const auto begin = json.data();
+  const auto end = json.data() + json.size() - decode_padding;
+  volatile size_t n = 0;
+  benchmark(name, static_cast<size_t>(1e4), [&]{
+    auto context = (padded ?
+        decode_context(begin, end, decode_context::padded_input()) :
+        decode_context(begin, end));
+    for (size_t i = 0; i < count; i++) {
+      skip(context);
+      context.position++;
+    }
+    n += context.offset();
+  }, end - begin);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_short_runs) {
+  benchmark_skip_short<skip_any_simple_characters>("simple characters", "spotify:track:", false);
+  benchmark_skip_short<skip_any_simple_characters>("simple characters, padded", "spotify:track:", true);
+  benchmark_skip_short<skip_any_whitespace>("whitespace", "\n            ", false);
+  benchmark_skip_short<skip_any_whitespace>("whitespace, padded", "\n            ", true);
+}
+
+/**
+ * An object with 'size' fields with numbers, strings, arrays and objects, like
+ * the unknown fields that are skipped when decoding a larger document.
+ */
+std::string generate_wide_object(size_t size) {
+  std::string string = "{";
+  for (size_t i = 0; i < size; i++) {
+    string += (i ? ",\n  \"field_" : "\n  \"field_") + std::to_string(i) + "\": ";
+    switch (i % 4) {
+      case 0: string += std::to_string(i * 7919); break;
+      case 1: string += "\"value number " + std::to_string(i) + " with \\\"quotes\\\"\""; break;
+      case 2: string += "[true, false, null, -1.25e-3]"; break;
+      case 3: string += "{ \"id\": " + std::to_string(i) + ", \"name\": \"field name\" }"; break;
+    }
+  }
+  return string + "\n}";
+}
+
+/**
+ * An array of 'size' elements that each consist of 'depth' nested objects and
+ * arrays: [{"k":[{"k":[ ... ]}]}, ...].
+ */
+std::string generate_nested_array(size_t size, size_t depth) {
+  std::string element;
+  for (size_t i = 0; i < depth; i++) {
+    element += "{\"k\":[";
+  }
+  element += "1,\"leaf\"";
+  for (size_t i = 0; i < depth; i++) {
+    element += "]}";
+  }
+
+  std::string string = "[";
+  for (size_t i = 0; i < size; i++) {
+    string += (i ? "," : "") + element;
+  }
+  return string + "]";
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_value_wide) {
+  const auto json = generate_wide_object(2000);
+  auto context = decode_context(json.data(), json.data() + json.size());
+  volatile size_t n = 0;
+  JSON_BENCHMARK_THROUGHPUT(1e4, json.size(), [&]{
+    context.position = context.begin;
+    skip_value_scalar(context);
+    n += context.offset();
+  });
+}
+
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_value_wide_avx2) {
+  if (supported_instruction_set() < instruction_set::avx2) {
+    return;
+  }
+
+  const auto json = generate_wide_object(2000);
+  auto context = decode_context(json.data(), json.data() + json.size());
+  volatile size_t n = 0;
+  JSON_BENCHMARK_THROUGHPUT(1e4, json.size(), [&]{
+    context.position = context.begin;
+    skip_value_avx2(context);
+    n += context.offset();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
+#if defined(json_arch_x86_avx512bw)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_value_wide_avx512bw) {
+  if (supported_instruction_set() < instruction_set::avx512bw) {
+    return;
+  }
+
+  const auto json = generate_wide_object(2000);
+  auto context = decode_context(json.data(), json.data() + json.size());
+  volatile size_t n = 0;
+  JSON_BENCHMARK_THROUGHPUT(1e4, json.size(), [&]{
+    context.position = context.begin;
+    skip_value_avx512bw(context);
+    n += context.offset();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx512bw)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_value_nested) {
+  const auto json = generate_nested_array(100, 15);
+  auto context = decode_context(json.data(), json.data() + json.size());
+  volatile size_t n = 0;
+  JSON_BENCHMARK_THROUGHPUT(1e4, json.size(), [&]{
+    context.position = context.begin;
+    skip_value_scalar(context);
+    n += context.offset();
+  });
+}
+
+#if defined(json_arch_x86_avx2)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_value_nested_avx2) {
+  if (supported_instruction_set() < instruction_set::avx2) {
+    return;
+  }
+
+  const auto json = generate_nested_array(100, 15);
+  auto context = decode_context(json.data(), json.data() + json.size());
+  volatile size_t n = 0;
+  JSON_BENCHMARK_THROUGHPUT(1e4, json.size(), [&]{
+    context.position = context.begin;
+    skip_value_avx2(context);
+    n += context.offset();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx2)
+
+#if defined(json_arch_x86_avx512bw)
+
+BOOST_AUTO_TEST_CASE(benchmark_json_detail_skip_value_nested_avx512bw) {
+  if (supported_instruction_set() < instruction_set::avx512bw) {
+    return;
+  }
+
+  const auto json = generate_nested_array(100, 15);
+  auto context = decode_context(json.data(), json.data() + json.size());
+  volatile size_t n = 0;
+  JSON_BENCHMARK_THROUGHPUT(1e4, json.size(), [&]{
+    context.position = context.begin;
+    skip_value_avx512bw(context);
+    n += context.offset();
+  });
+}
+
+#endif  // defined(json_arch_x86_avx512bw)
+
 BOOST_AUTO_TEST_SUITE_END()  // detail
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
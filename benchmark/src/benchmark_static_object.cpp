@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/boolean.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/static_object.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/encode.hpp>
+
+#include <spotify/json/benchmark/benchmark.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(codec)
+
+namespace {
+
+struct track_t {
+  std::string uri;
+  std::string name;
+  std::string album;
+  int duration = 0;
+  int popularity = 0;
+  int disc_number = 0;
+  int track_number = 0;
+  bool explicit_content = false;
+};
+
+object_t<track_t> dynamic_codec() {
+  auto codec = object<track_t>();
+  codec.required("uri", &track_t::uri);
+  codec.required("name", &track_t::name);
+  codec.optional("album", &track_t::album);
+  codec.required("duration", &track_t::duration);
+  codec.optional("popularity", &track_t::popularity);
+  codec.optional("disc_number", &track_t::disc_number);
+  codec.optional("track_number", &track_t::track_number);
+  codec.optional("explicit", &track_t::explicit_content);
+  return codec;
+}
+
+auto static_codec() -> decltype(static_object<track_t>(
+    required_field("uri", &track_t::uri),
+    required_field("name", &track_t::name),
+    optional_field("album", &track_t::album),
+    required_field("duration", &track_t::duration),
+    optional_field("popularity", &track_t::popularity),
+    optional_field("disc_number", &track_t::disc_number),
+    optional_field("track_number", &track_t::track_number),
+    optional_field("explicit", &track_t::explicit_content))) {
+  return static_object<track_t>(
+      required_field("uri", &track_t::uri),
+      required_field("name", &track_t::name),
+      optional_field("album", &track_t::album),
+      required_field("duration", &track_t::duration),
+      optional_field("popularity", &track_t::popularity),
+      optional_field("disc_number", &track_t::disc_number),
+      optional_field("track_number", &track_t::track_number),
+      optional_field("explicit", &track_t::explicit_content));
+}
+
+const std::string track_json =
+    R"({"uri":"spotify:track:6rqhFgbbKwnb9MLmUQDhG6","name":"Speak to Me",)"
+    R"("album":"The Dark Side of the Moon","duration":90000,"popularity":60,)"
+    R"("disc_number":1,"track_number":1,"explicit":false})";
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_static_object_decode_object) {
+  const auto codec = dynamic_codec();
+  JSON_BENCHMARK(1e6, [&]{
+    auto context = decode_context(track_json.data(), track_json.data() + track_json.size());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_static_object_decode_static_object) {
+  const auto codec = static_codec();
+  JSON_BENCHMARK(1e6, [&]{
+    auto context = decode_context(track_json.data(), track_json.data() + track_json.size());
+    codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_static_object_encode_object) {
+  const auto codec = dynamic_codec();
+  auto context = decode_context(track_json.data(), track_json.data() + track_json.size());
+  const auto track = codec.decode(context);
+  JSON_BENCHMARK(1e6, [&]{
+    encode_context context;
+    codec.encode(context, track);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_static_object_encode_static_object) {
+  const auto codec = static_codec();
+  auto context = decode_context(track_json.data(), track_json.data() + track_json.size());
+  const auto track = codec.decode(context);
+  JSON_BENCHMARK(1e6, [&]{
+    encode_context context;
+    codec.encode(context, track);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_static_object_construct_object) {
+  JSON_BENCHMARK(1e5, [&]{
+    dynamic_codec();
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_static_object_construct_static_object) {
+  JSON_BENCHMARK(1e5, [&]{
+    static_codec();
+  });
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // codec
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -18,10 +18,13 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <spotify/json/codec/lazy_string.hpp>
 #include <spotify/json/codec/string.hpp>
+#include <spotify/json/codec/string_view.hpp>
 #include <spotify/json/decode.hpp>
 #include <spotify/json/decode_exception.hpp>
 #include <spotify/json/encode.hpp>
+#include <spotify/json/padded_string.hpp>
 
 #include <spotify/json/benchmark/benchmark.hpp>
 
@@ -48,6 +51,35 @@ std::string generate_simple_json_string(size_t size) {
   return "\"" + generate_simple_string(size) + "\"";
 }
 
+/**
+ * A string like lyrics or a description, with an escape sequence every
+ * run_length characters on average.
+ */
+std::string generate_escaped_json_string(size_t size, size_t run_length) {
+  static const char *escape_sequences[] = { "\\n", "\\\"", "\\u2019", "\\/", "\\\\" };
+  std::string string("\"");
+  for (size_t i = 0; string.size() < size; i++) {
+    string += generate_simple_string(run_length);
+    string += escape_sequences[i % 5];
+  }
+  string += "\"";
+  return string;
+}
+
+/**
+ * A string in a mix of scripts, where most characters are two, three or four
+ * bytes of UTF-8, like the titles of a non-English catalog.
+ */
+std::string generate_multibyte_json_string(size_t size) {
+  static const char *words[] = { "Bj\xC3\xB6rk ", "\xE6\x9D\xB1\xE4\xBA\xAC ", "\xD0\x9C\xD0\xBE\xD1\x81\xD0\xBA\xD0\xB2\xD0\xB0 ", "\xF0\x9F\x8E\xB5 " };
+  std::string string("\"");
+  for (size_t i = 0; string.size() < size; i++) {
+    string += words[i % 4];
+  }
+  string += "\"";
+  return string;
+}
+
 /*
  * Decoding
  */
@@ -76,6 +108,163 @@ BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_simple_tiny_string) {
   });
 }
 
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_simple_long_padded_string) {
+  const auto codec = default_codec<std::string>();
+  const auto json = padded_string(generate_simple_json_string(10000));
+  JSON_BENCHMARK(1e5, [&]{
+    auto context = decode_context(json.data(), json.size(), decode_context::padded_input());
+    const auto decoded_string = codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_simple_tiny_padded_string) {
+  const auto codec = default_codec<std::string>();
+  const auto json = padded_string("\"spotify:track:05341EWu6uHUg2BojF3Cyw\"");
+  JSON_BENCHMARK(1e5, [&]{
+    for (int i = 0; i < 100; i++) {
+      auto context = decode_context(json.data(), json.size(), decode_context::padded_input());
+      const auto decoded_string = codec.decode(context);
+    }
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_simple_tiny_string_view) {
+  const auto codec = string_view();
+  const auto json = std::string("\"spotify:track:05341EWu6uHUg2BojF3Cyw\"");
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  JSON_BENCHMARK(1e5, [=]{
+    for (int i = 0; i < 100; i++) {
+      auto context = decode_context(json_begin, json_end);
+      const auto decoded_string = codec.decode(context);
+    }
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_simple_tiny_lazy_string) {
+  const auto codec = lazy_string();
+  const auto json = std::string("\"spotify:track:05341EWu6uHUg2BojF3Cyw\"");
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  JSON_BENCHMARK(1e5, [=]{
+    for (int i = 0; i < 100; i++) {
+      auto context = decode_context(json_begin, json_end);
+      const auto decoded_string = codec.decode(context);
+    }
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_escaped_long_string) {
+  const auto codec = default_codec<std::string>();
+  const auto json = generate_escaped_json_string(10000, 40);
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  JSON_BENCHMARK(1e4, [=]{
+    auto context = decode_context(json_begin, json_end);
+    const auto decoded_string = codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_escape_dense_long_string) {
+  const auto codec = default_codec<std::string>();
+  const auto json = generate_escaped_json_string(10000, 2);
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  JSON_BENCHMARK(1e4, [=]{
+    auto context = decode_context(json_begin, json_end);
+    const auto decoded_string = codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_escaped_tiny_string) {
+  const auto codec = default_codec<std::string>();
+  const auto json = std::string("\"Guns N\\u2019 Roses \\/ Sweet Child O\\u2019 Mine\"");
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  JSON_BENCHMARK(1e5, [=]{
+    for (int i = 0; i < 100; i++) {
+      auto context = decode_context(json_begin, json_end);
+      const auto decoded_string = codec.decode(context);
+    }
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_escaped_tiny_lazy_string) {
+  const auto codec = lazy_string();
+  const auto json = std::string("\"Guns N\\u2019 Roses \\/ Sweet Child O\\u2019 Mine\"");
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  JSON_BENCHMARK(1e5, [=]{
+    for (int i = 0; i < 100; i++) {
+      auto context = decode_context(json_begin, json_end);
+      const auto decoded_string = codec.decode(context);
+    }
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_escaped_tiny_lazy_string_view) {
+  const auto codec = lazy_string();
+  const auto json = std::string("\"Guns N\\u2019 Roses \\/ Sweet Child O\\u2019 Mine\"");
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  auto buffer = std::string();
+  JSON_BENCHMARK(1e5, [&]{
+    for (int i = 0; i < 100; i++) {
+      auto context = decode_context(json_begin, json_end);
+      const auto decoded_string = codec.decode(context).view(buffer);
+    }
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_simple_long_string_strict_utf8) {
+  const auto codec = default_codec<std::string>();
+  const auto json = generate_simple_json_string(10000);
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  JSON_BENCHMARK(1e5, [=]{
+    auto context = decode_context(json_begin, json_end);
+    context.strict_utf8 = true;
+    const auto decoded_string = codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_simple_tiny_string_strict_utf8) {
+  const auto codec = default_codec<std::string>();
+  const auto json = std::string("\"spotify:track:05341EWu6uHUg2BojF3Cyw\"");
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  JSON_BENCHMARK(1e5, [=]{
+    for (int i = 0; i < 100; i++) {
+      auto context = decode_context(json_begin, json_end);
+      context.strict_utf8 = true;
+      const auto decoded_string = codec.decode(context);
+    }
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_multibyte_long_string) {
+  const auto codec = default_codec<std::string>();
+  const auto json = generate_multibyte_json_string(10000);
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  JSON_BENCHMARK(1e5, [=]{
+    auto context = decode_context(json_begin, json_end);
+    const auto decoded_string = codec.decode(context);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(benchmark_json_codec_string_decode_multibyte_long_string_strict_utf8) {
+  const auto codec = default_codec<std::string>();
+  const auto json = generate_multibyte_json_string(10000);
+  const auto json_begin = json.data();
+  const auto json_end = json.data() + json.size();
+  JSON_BENCHMARK(1e5, [=]{
+    auto context = decode_context(json_begin, json_end);
+    context.strict_utf8 = true;
+    const auto decoded_string = codec.decode(context);
+  });
+}
+
 /*
  * Encoding
  */
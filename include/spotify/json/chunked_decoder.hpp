@@ -0,0 +1,477 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/decode_string.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/detail/value_scanner.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * The input of a chunked decoder for arrays or objects that has not been
+ * decoded yet. On every append, the decoder decodes what it can and moves
+ * _position past it. The bytes before _position are dropped once they make up
+ * half of the buffer, rather than after every chunk, so that each byte is only
+ * moved once on average. The buffer is then at most twice the size of the
+ * incomplete element or member, plus one chunk.
+ */
+template <typename decoder_type>
+class chunked_buffer {
+ public:
+  /**
+   * Only the element or member that is currently incomplete is kept in the
+   * buffer, so there is nothing to reserve.
+   */
+  void reserve(const std::size_t) {}
+
+  void append(const char *data, const std::size_t size) {
+    _buffer.append(data, size);
+    with_document_offsets([&]{
+      static_cast<decoder_type &>(*this).decode_available();
+    });
+
+    if (_position * 2 >= _buffer.size()) {
+      _buffer.erase(0, _position);
+      _discarded += _position;
+      // _scanned is only used while a value is incomplete, and then it is at
+      // or after _position. Otherwise it is stale and begin_value resets it.
+      _scanned = (_scanned > _position ? _scanned - _position : 0);
+      _position = 0;
+    }
+  }
+
+ protected:
+  chunked_buffer()
+      : _position(0),
+        _scanned(0),
+        _discarded(0) {}
+
+  /**
+   * A context over the buffer that starts at _position.
+   */
+  decode_context available() const {
+    decode_context context(_buffer.data(), _buffer.size());
+    context.position += _position;
+    return context;
+  }
+
+  /**
+   * A context at the end of the buffer, for reporting errors in finish().
+   */
+  decode_context at_end() const {
+    decode_context context(_buffer.data(), _buffer.size());
+    context.position = context.end;
+    return context;
+  }
+
+  /**
+   * Call function, and make the offsets of the decode errors that it throws
+   * count from the beginning of the document rather than of the buffer.
+   */
+  template <typename function_type>
+  void with_document_offsets(const function_type &function) {
+    try {
+      function();
+    } catch (decode_exception &exception) {
+      const auto offset = exception.offset() + _discarded;
+      throw decode_exception(std::move(exception), offset);
+    }
+  }
+
+  /**
+   * Start scanning a value at _position.
+   */
+  void begin_value() {
+    _scanner.reset();
+    _scanned = _position;
+  }
+
+  /**
+   * The end of the value that begin_value started, or nullptr if the buffer
+   * ends before it does.
+   */
+  const char *scan_value(const decode_context &context) {
+    const auto end = _scanner.scan(context.begin + _scanned, context.end);
+    if (!end) {
+      _scanned = _buffer.size();
+    }
+    return end;
+  }
+
+  /**
+   * Check that the value that was decoded is the one that was scanned, and
+   * continue after it.
+   */
+  void end_value(const decode_context &context, const char *end) {
+    detail::fail_if(context, context.position != end, decode_error::unexpected_input);
+    _position = context.offset();
+  }
+
+  std::string _buffer;
+  detail::value_scanner _scanner;
+  std::size_t _position;
+  std::size_t _scanned;
+  std::size_t _discarded;
+};
+
+}  // namespace detail
+
+/**
+ * Decodes a JSON document that arrives in chunks, for example from a socket,
+ * with the same result as json::decode on the concatenated chunks. Chunks are
+ * scanned as they arrive, so complete() tells when the whole document has been
+ * received without waiting for the connection to close.
+ *
+ * Arrays (array_t, such as the default codec for std::vector) are decoded one
+ * element at a time, and objects (object_t and map_t) one member at a time, as
+ * soon as each element or member is complete. Only the one that is still
+ * incomplete is kept in the buffer. The elements and members themselves are
+ * decoded in one go, so an array of objects keeps at most one object in the
+ * buffer. Documents of any other type, like strings and numbers, are kept in
+ * the buffer until finish() decodes them.
+ *
+ * If append or finish throws a decode_exception, the chunked_decoder must not
+ * be used again. Exception offsets count from the beginning of the document.
+ */
+template <typename codec_type, typename enable = void>
+class chunked_decoder final {
+ public:
+  using object_type = typename codec_type::object_type;
+
+  explicit chunked_decoder(codec_type codec)
+      : _codec(std::move(codec)),
+        _scanned(0),
+        _complete(false) {}
+
+  /**
+   * Reserve space for a document of the given size, for example as given by a
+   * Content-Length header, so that the buffer never has to grow and be copied.
+   */
+  void reserve(const std::size_t size) {
+    _buffer.reserve(size);
+  }
+
+  void append(const char *data, const std::size_t size) {
+    _buffer.append(data, size);
+    if (!_complete) {
+      const auto begin = _buffer.data();
+      const auto end = begin + _buffer.size();
+      _complete = (_scanner.scan(begin + _scanned, end) != nullptr);
+      _scanned = _buffer.size();
+    }
+  }
+
+  /**
+   * True if a complete JSON value has been received. Numbers and literals
+   * are only known to be complete when they are followed by another byte.
+   */
+  bool complete() const {
+    return _complete;
+  }
+
+  /**
+   * Decode the document, after the last chunk has been appended.
+   *
+   * @throws decode_exception if the JSON parsing fails.
+   */
+  object_type finish() {
+    decode_context context(_buffer.data(), _buffer.size());
+    return detail::decode_document(_codec, context);
+  }
+
+ private:
+  codec_type _codec;
+  std::string _buffer;
+  detail::value_scanner _scanner;
+  std::size_t _scanned;
+  bool _complete;
+};
+
+template <typename T, typename inner_codec_type>
+class chunked_decoder<codec::array_t<T, inner_codec_type>> final
+    : public detail::chunked_buffer<chunked_decoder<codec::array_t<T, inner_codec_type>>> {
+ public:
+  using object_type = T;
+
+  explicit chunked_decoder(codec::array_t<T, inner_codec_type> codec)
+      : _inner_codec(codec.inner_codec()),
+        _state(before_array),
+        _inserter_state(inserter::init_state) {}
+
+  bool complete() const {
+    return (_state == after_array);
+  }
+
+  object_type finish() {
+    this->with_document_offsets([&]{
+      auto context = this->at_end();
+      detail::fail_if(context, _state != after_array, decode_error::unexpected_end_of_input);
+      inserter::validate(context, _inserter_state, _output);
+    });
+    return std::move(_output);
+  }
+
+ private:
+  friend class detail::chunked_buffer<chunked_decoder>;
+  using inserter = detail::container_inserter<T>;
+
+  enum state {
+    before_array,
+    before_first_element,
+    before_element,
+    in_element,
+    after_element,
+    after_array
+  };
+
+  /**
+   * Decode as much of the buffer as possible, leaving _position at the first
+   * byte that is still needed.
+   */
+  void decode_available() {
+    auto context = this->available();
+
+    while (true) {
+      if (_state != in_element) {
+        detail::skip_any_whitespace(context);
+        this->_position = context.offset();
+        if (!context.remaining()) {
+          return;
+        }
+      }
+
+      switch (_state) {
+        case before_array:
+          detail::skip_1(context, '[');
+          _state = before_first_element;
+          break;
+        case before_first_element:
+          if (detail::peek_unchecked(context) == ']') {
+            detail::skip_unchecked_1(context);
+            _state = after_array;
+            break;
+          }
+          // fall through
+        case before_element:
+          this->begin_value();
+          _state = in_element;
+          break;
+        case in_element:
+          if (!decode_element(context)) {
+            return;
+          }
+          _state = after_element;
+          break;
+        case after_element:
+          if (detail::peek_unchecked(context) == ']') {
+            detail::skip_unchecked_1(context);
+            _state = after_array;
+          } else {
+            detail::skip_1(context, ',');
+            _state = before_element;
+          }
+          break;
+        case after_array:
+          detail::fail(context, decode_error::unexpected_trailing_input);
+      }
+    }
+  }
+
+  bool decode_element(decode_context &context) {
+    const auto end = this->scan_value(context);
+    if (!end) {
+      return false;
+    }
+
+    _inserter_state = inserter::insert(
+        context, _inserter_state, _output, _inner_codec.decode(context));
+    this->end_value(context, end);
+    return true;
+  }
+
+  inner_codec_type _inner_codec;
+  state _state;
+  typename inserter::state _inserter_state;
+  object_type _output;
+};
+
+template <typename codec_type>
+class chunked_decoder<
+    codec_type,
+    typename std::enable_if<detail::has_partial_decode_methods<codec_type>::value>::type> final
+    : public detail::chunked_buffer<chunked_decoder<codec_type>> {
+ public:
+  using object_type = typename codec_type::object_type;
+
+  explicit chunked_decoder(codec_type codec)
+      : _codec(std::move(codec)),
+        _state(before_object) {}
+
+  bool complete() const {
+    return (_state == after_object);
+  }
+
+  object_type finish() {
+    this->with_document_offsets([&]{
+      detail::fail_if(this->at_end(), _state != after_object, decode_error::unexpected_end_of_input);
+    });
+    return std::move(_partial->object);
+  }
+
+ private:
+  friend class detail::chunked_buffer<chunked_decoder>;
+  using partial_object = typename std::decay<decltype(std::declval<const codec_type>().begin_partial_decode())>::type;
+
+  enum state {
+    before_object,
+    before_first_key,
+    before_key,
+    in_key,
+    after_key,
+    before_value,
+    in_value,
+    after_value,
+    after_object
+  };
+
+  /**
+   * Decode as much of the buffer as possible, leaving _position at the first
+   * byte that is still needed. Keys are copied out of the buffer, since the
+   * buffer may be compacted before their values are complete.
+   */
+  void decode_available() {
+    auto context = this->available();
+
+    while (true) {
+      if (_state != in_key && _state != in_value) {
+        detail::skip_any_whitespace(context);
+        this->_position = context.offset();
+        if (!context.remaining()) {
+          return;
+        }
+      }
+
+      switch (_state) {
+        case before_object:
+          detail::skip_1(context, '{');
+          _partial.reset(new partial_object(_codec.begin_partial_decode()));
+          _state = before_first_key;
+          break;
+        case before_first_key:
+          if (detail::peek_unchecked(context) == '}') {
+            end_object(context);
+            break;
+          }
+          // fall through
+        case before_key:
+          if (detail::peek_unchecked(context) != '"') {
+            detail::skip_1(context, '"');
+          }
+          this->begin_value();
+          _state = in_key;
+          break;
+        case in_key:
+          if (!decode_key(context)) {
+            return;
+          }
+          _state = after_key;
+          break;
+        case after_key:
+          detail::skip_1(context, ':');
+          _state = before_value;
+          break;
+        case before_value:
+          this->begin_value();
+          _state = in_value;
+          break;
+        case in_value:
+          if (!decode_value(context)) {
+            return;
+          }
+          _state = after_value;
+          break;
+        case after_value:
+          if (detail::peek_unchecked(context) == '}') {
+            end_object(context);
+          } else {
+            detail::skip_1(context, ',');
+            _state = before_key;
+          }
+          break;
+        case after_object:
+          detail::fail(context, decode_error::unexpected_trailing_input);
+      }
+    }
+  }
+
+  bool decode_key(decode_context &context) {
+    const auto end = this->scan_value(context);
+    if (!end) {
+      return false;
+    }
+
+    detail::decode_raw_key(context, [&](const char *key, const std::size_t key_size) {
+      _key.assign(key, key_size);
+    });
+    this->end_value(context, end);
+    return true;
+  }
+
+  bool decode_value(decode_context &context) {
+    const auto end = this->scan_value(context);
+    if (!end) {
+      return false;
+    }
+
+    _codec.decode_partial_field(context, *_partial, _key.data(), _key.size());
+    this->end_value(context, end);
+    return true;
+  }
+
+  void end_object(decode_context &context) {
+    detail::skip_unchecked_1(context);
+    _codec.end_partial_decode(context, *_partial);
+    _state = after_object;
+  }
+
+  codec_type _codec;
+  state _state;
+  std::unique_ptr<partial_object> _partial;
+  std::string _key;
+};
+
+template <typename codec_type>
+chunked_decoder<typename std::decay<codec_type>::type> make_chunked_decoder(codec_type &&codec) {
+  return chunked_decoder<typename std::decay<codec_type>::type>(std::forward<codec_type>(codec));
+}
+
+}  // namespace json
+}  // namespace spotify
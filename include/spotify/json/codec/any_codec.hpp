@@ -41,6 +41,10 @@ class any_codec_t final {
     return _codec->decode(context);
   }
 
+  unsigned first_tokens() const {
+    return _codec->first_tokens();
+  }
+
   void encode(encode_context &context, const object_type &value) const {
     _codec->encode(context, value);
   }
@@ -55,6 +59,7 @@ class any_codec_t final {
     virtual ~erased_codec() = default;
 
     virtual object_type decode(decode_context &context) const = 0;
+    virtual unsigned first_tokens() const = 0;
     virtual void encode(encode_context &context, const object_type &value) const = 0;
     virtual bool should_encode(const object_type &value) const = 0;
   };
@@ -69,6 +74,10 @@ class any_codec_t final {
       return _codec.decode(context);
     }
 
+    unsigned first_tokens() const override {
+      return detail::first_tokens(_codec);
+    }
+
     void encode(encode_context &context, const object_type &value) const override {
       _codec.encode(context, value);
     }
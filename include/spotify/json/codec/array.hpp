@@ -150,6 +150,10 @@ class array_t final {
     return output;
   }
 
+  unsigned first_tokens() const {
+    return detail::token_array;
+  }
+
   void encode(encode_context &context, const object_type &array) const {
     context.append('[');
     for (const auto &element : array) {
@@ -161,6 +165,10 @@ class array_t final {
     context.append_or_replace(',', ']');
   }
 
+  const codec_type &inner_codec() const {
+    return _inner_codec;
+  }
+
  private:
   codec_type _inner_codec;
 };
@@ -39,10 +39,14 @@ class boolean_t final {
     switch (detail::peek(context)) {
       case 'f': detail::skip_false(context); return false;
       case 't': detail::skip_true(context); return true;
-      default: detail::fail(context, "Unexpected input, expected boolean");
+      default: detail::fail(context, "Unexpected input, expected boolean"); return false;
     }
   }
 
+  unsigned first_tokens() const {
+    return detail::token_boolean;
+  }
+
   void encode(encode_context &context, const object_type value) const {
     const auto needed = 5 - size_t(value);  // true: 4, false: 5
     const auto buffer = context.reserve(needed);
@@ -69,6 +69,10 @@ class optional_t final {
     return _inner_codec.decode(context);
   }
 
+  unsigned first_tokens() const {
+    return detail::first_tokens(_inner_codec);
+  }
+
   template <typename value_type>
   void encode(encode_context &context, const boost::optional<value_type> &value) const {
     detail::fail_if(context, !value, "Cannot encode uninitialized optional");
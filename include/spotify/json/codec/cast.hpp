@@ -20,6 +20,7 @@
 #include <utility>
 
 #include <spotify/json/decode_context.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
 #include <spotify/json/encode_context.hpp>
 
 namespace spotify {
@@ -48,6 +49,10 @@ class cast_t {
     return _inner_codec.decode(context);
   }
 
+  unsigned first_tokens() const {
+    return detail::first_tokens(_inner_codec);
+  }
+
   void encode(encode_context &context, object_type value) const {
     using inner_type = typename codec_type::object_type;
     _inner_codec.encode(context, codec_cast<inner_type, T>::cast(value));
@@ -26,6 +26,7 @@
 #include <spotify/json/codec/enumeration.hpp>
 #include <spotify/json/codec/eq.hpp>
 #include <spotify/json/codec/ignore.hpp>
+#include <spotify/json/codec/lazy_string.hpp>
 #include <spotify/json/codec/map.hpp>
 #include <spotify/json/codec/null.hpp>
 #include <spotify/json/codec/number.hpp>
@@ -33,6 +34,9 @@
 #include <spotify/json/codec/omit.hpp>
 #include <spotify/json/codec/one_of.hpp>
 #include <spotify/json/codec/smart_ptr.hpp>
+#include <spotify/json/codec/static_object.hpp>
 #include <spotify/json/codec/string.hpp>
+#include <spotify/json/codec/string_view.hpp>
+#include <spotify/json/codec/tagged_union.hpp>
 #include <spotify/json/codec/transform.hpp>
 #include <spotify/json/codec/tuple.hpp>
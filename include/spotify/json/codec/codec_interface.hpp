@@ -57,6 +57,17 @@ class codec_interface final {
    */
   object_type decode(decode_context &context) const;
 
+  /**
+   * This method is optional.
+   *
+   * If it is present, it returns the kinds of JSON values that decode is able
+   * to decode, as a bitwise or of detail::token_kind values. one_of_t does not
+   * try codecs that cannot decode the kind of value that it sees, so decode
+   * must fail for any other kind of value. Codecs without this method are
+   * assumed to decode any kind of value.
+   */
+  unsigned first_tokens() const;
+
   /**
    * Write an object to an encoding context.
    */
@@ -17,11 +17,13 @@
 #pragma once
 
 #include <type_traits>
+#include <utility>
 
 #include <spotify/json/codec/null.hpp>
 #include <spotify/json/codec/omit.hpp>
 #include <spotify/json/decode_context.hpp>
 #include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/macros.hpp>
 #include <spotify/json/encode_context.hpp>
 
 namespace spotify {
@@ -46,21 +48,22 @@ class empty_as_t final {
         _inner_codec(std::move(inner_codec)) {}
 
   object_type decode(decode_context &context) const {
-    const auto original_position = context.position;
-    try {
+    // Only try the codecs that can decode the kind of value at hand, if they
+    // say what they can decode, because every failed attempt costs a throw.
+    const auto kind = detail::token_kind_of(detail::peek(context));
+    if (!(detail::first_tokens(_empty_codec) & kind)) {
       return _inner_codec.decode(context);
-    } catch (const decode_exception &exception) {
-      try {
-        context.position = original_position;
-        return _empty_codec.decode(context);
-      } catch (const decode_exception &) {
-        // The error of the inner codec is more interesting than saying, for
-        // example, that the object is not a valid null.
-        throw exception;
-      }
+    } else if (!(detail::first_tokens(_inner_codec) & kind)) {
+      return decode_empty(context);
+    } else {
+      return decode_inner_or_empty(context);
     }
   }
 
+  unsigned first_tokens() const {
+    return detail::first_tokens(_empty_codec) | detail::first_tokens(_inner_codec);
+  }
+
   void encode(encode_context &context, const object_type &value) const {
     if (value == _default) {
       _empty_codec.encode(context, value);
@@ -78,6 +81,64 @@ class empty_as_t final {
   }
 
  private:
+  /**
+   * The codecs may fail by throwing, or by recording the error in the context,
+   * see decode_context::error. Both are handled the same way.
+   */
+  json_never_inline object_type decode_empty(decode_context &context) const {
+    const auto original_position = context.position;
+    try {
+      auto result = _empty_codec.decode(context);
+      if (json_likely(!context.has_failed())) {
+        return result;
+      }
+      *context.error = decode_error();
+    } catch (const decode_exception &) {
+    }
+
+    // Fail with the error of the inner codec, as decode_inner_or_empty does.
+    context.position = original_position;
+    return _inner_codec.decode(context);
+  }
+
+  json_never_inline object_type decode_inner_or_empty(decode_context &context) const {
+    const auto original_position = context.position;
+    try {
+      auto result = _inner_codec.decode(context);
+      if (json_likely(!context.has_failed())) {
+        return result;
+      }
+    } catch (const decode_exception &exception) {
+      context.position = original_position;
+      try {
+        auto result = _empty_codec.decode(context);
+        if (json_likely(!context.has_failed())) {
+          return result;
+        }
+        *context.error = decode_error();
+      } catch (const decode_exception &) {
+      }
+      // The error of the inner codec is more interesting than saying, for
+      // example, that the object is not a valid null.
+      throw exception;
+    }
+
+    const auto inner_position = context.position;
+    auto inner_error = std::move(*context.error);
+    *context.error = decode_error();
+    context.position = original_position;
+    try {
+      auto result = _empty_codec.decode(context);
+      if (json_likely(!context.has_failed())) {
+        return result;
+      }
+    } catch (const decode_exception &) {
+    }
+    context.position = inner_position;
+    *context.error = std::move(inner_error);
+    return _default;
+  }
+
   empty_codec_type _empty_codec;
   inner_codec_type _inner_codec;
   object_type _default = object_type();
@@ -52,10 +52,17 @@ class enumeration_t final {
     const auto it = std::find_if(_mapping.begin(), _mapping.end(), [&](const std::pair<outer_type, inner_type> &pair) {
       return pair.second == result;
     });
-    detail::fail_if(context, it == _mapping.end(), "Encountered unknown enumeration value");
+    if (json_unlikely(it == _mapping.end())) {
+      detail::fail(context, "Encountered unknown enumeration value");
+      return object_type();
+    }
     return it->first;
   }
 
+  unsigned first_tokens() const {
+    return detail::first_tokens(_inner_codec);
+  }
+
   void encode(encode_context &context, const object_type &value) const {
     const auto it = find(value);
     detail::fail_if(context, it == _mapping.end(), "Encoding unknown enumeration value");
@@ -18,6 +18,7 @@
 
 #include <spotify/json/decode_context.hpp>
 #include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
 #include <spotify/json/detail/encode_helpers.hpp>
 
 namespace spotify {
@@ -48,6 +49,10 @@ class eq_t final {
     return result;
   }
 
+  unsigned first_tokens() const {
+    return detail::first_tokens(_inner_codec);
+  }
+
   void encode(encode_context &context, const object_type &value) const {
     _inner_codec.encode(context, _value);
   }
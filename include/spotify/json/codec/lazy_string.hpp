@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstring>
+#include <string>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/decode_string.hpp>
+#include <spotify/json/detail/encode_string.hpp>
+#include <spotify/json/detail/macros.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/encode_context.hpp>
+#include <spotify/json/escape_policy.hpp>
+#include <spotify/json/string_ref.hpp>
+
+namespace spotify {
+namespace json {
+namespace codec {
+
+/**
+ * Decodes strings into raw_strings that point into the input, with escape
+ * sequences left in place until the string is used. Escape sequences are
+ * validated when decoding, so unescaping a raw_string later cannot fail.
+ */
+class lazy_string_t final {
+ public:
+  using object_type = raw_string;
+
+  json_force_inline object_type decode(decode_context &context) const {
+    if (json_unlikely(!detail::skip_1(context, '"'))) {
+      return object_type();
+    }
+
+    const auto begin_simple = context.position;
+    detail::skip_any_simple_characters(context);
+
+    switch (detail::next(context, decode_error::unterminated_string)) {
+      case '"':
+        return object_type(begin_simple, context.position - 1 - begin_simple, false);
+      case '\\':
+        detail::skip_escaped_string(context);
+        return object_type(begin_simple, context.position - 1 - begin_simple, true);
+      default: return object_type();  // failed without throwing
+    }
+  }
+
+  unsigned first_tokens() const {
+    return detail::token_string;
+  }
+
+  /**
+   * The escaped string is already valid JSON, so with the standard and trusted
+   * escape policies it is written as is. The ascii and html_safe policies
+   * escape characters that it may have as is, so it is escaped again.
+   */
+  void encode(encode_context &context, const object_type &value) const {
+    if (json_unlikely(
+        context.escaping == escape_policy::ascii ||
+        context.escaping == escape_policy::html_safe)) {
+      return encode_escaped(context, value);
+    }
+
+    const auto size = value.escaped_size();
+    const auto buffer = context.reserve(size + 2);
+    buffer[0] = '"';
+    std::memcpy(buffer + 1, value.escaped_data(), size);
+    buffer[size + 1] = '"';
+    context.advance(size + 2);
+  }
+
+ private:
+  json_never_inline static void encode_escaped(encode_context &context, const object_type &value) {
+    std::string buffer;
+    detail::encode_string(context, value.view(buffer), context.escaping);
+  }
+};
+
+inline lazy_string_t lazy_string() {
+  return lazy_string_t();
+}
+
+}  // namespace codec
+
+template <>
+struct default_codec_t<raw_string> {
+  static codec::lazy_string_t codec() {
+    return codec::lazy_string_t();
+  }
+};
+
+}  // namespace json
+}  // namespace spotify
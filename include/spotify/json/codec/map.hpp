@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <map>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
 
@@ -63,6 +65,32 @@ class map_t final {
     return output;
   }
 
+  unsigned first_tokens() const {
+    return detail::token_object;
+  }
+
+  /**
+   * A map that is decoded one member at a time, like object_t::partial_object.
+   */
+  struct partial_object {
+    object_type object;
+  };
+
+  partial_object begin_partial_decode() const {
+    return partial_object{ object_type() };
+  }
+
+  void decode_partial_field(
+      decode_context &context,
+      partial_object &partial,
+      const char *key,
+      const std::size_t key_size) const {
+    using value_type = typename object_type::value_type;
+    partial.object.insert(value_type(std::string(key, key_size), _inner_codec.decode(context)));
+  }
+
+  void end_partial_decode(const decode_context &, const partial_object &) const {}
+
   void encode(encode_context &context, const object_type &map) const {
     context.append('{');
     for (const auto &element : map) {
@@ -76,6 +104,10 @@ class map_t final {
     context.append_or_replace(',', '}');
   }
 
+  const codec_type &inner_codec() const {
+    return _inner_codec;
+  }
+
  private:
   string_t _string_codec;
   codec_type _inner_codec;
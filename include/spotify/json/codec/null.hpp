@@ -42,6 +42,10 @@ class null_t final {
     return _value;
   }
 
+  unsigned first_tokens() const {
+    return detail::token_null;
+  }
+
   void encode(encode_context &context, const object_type value) const {
     context.append("null", 4);
   }
@@ -18,15 +18,18 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <type_traits>
 
-#include <double-conversion/double-conversion.h>
-
 #include <spotify/json/decode_context.hpp>
 #include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/decode_float.hpp>
 #include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/digits.hpp>
+#include <spotify/json/detail/encode_float.hpp>
 #include <spotify/json/detail/encode_helpers.hpp>
 #include <spotify/json/detail/encode_integer.hpp>
 #include <spotify/json/encode_context.hpp>
@@ -35,76 +38,30 @@ namespace spotify {
 namespace json {
 namespace detail {
 
-template <typename T>
-T decode_floating_point(
-    const double_conversion::StringToDoubleConverter &converter,
-    const char* buffer,
-    int length,
-    int* processed_characters_count);
-
-template <>
-inline float decode_floating_point(
-    const double_conversion::StringToDoubleConverter &converter,
-    const char* buffer,
-    int length,
-    int* processed_characters_count) {
-  return converter.StringToFloat(buffer, length, processed_characters_count);
-}
-
-template <>
-inline double decode_floating_point(
-    const double_conversion::StringToDoubleConverter &converter,
-    const char* buffer,
-    int length,
-    int* processed_characters_count) {
-  return converter.StringToDouble(buffer, length, processed_characters_count);
-}
-
 template <typename T>
 class floating_point_t {
  public:
   using object_type = T;
 
   object_type decode(decode_context &context) const {
-    using atod_converter = double_conversion::StringToDoubleConverter;
-    static const atod_converter converter(
-        atod_converter::ALLOW_TRAILING_JUNK,
-        std::numeric_limits<object_type>::quiet_NaN(),
-        std::numeric_limits<object_type>::quiet_NaN(),
-        nullptr,
-        nullptr);
-
-    int bytes_read = 0;
-    const auto result = decode_floating_point<object_type>(
-        converter,
-        context.position,
-        static_cast<int>(context.end - context.position),
-        &bytes_read);
-    fail_if(context, std::isnan(result), "Invalid floating point number");
-    skip_unchecked_n(context, bytes_read);
+    object_type result;
+    const auto position = detail::decode_float(context.position, context.end, result);
+    if (json_unlikely(!position)) {
+      fail(context, "Invalid floating point number");
+      return object_type();
+    }
+    context.position = position;
     return result;
   }
 
+  unsigned first_tokens() const {
+    return detail::token_number;
+  }
+
   void encode(encode_context &context, const object_type &value) const {
-    // The maximum buffer size required to emit a double in base 10, for decimal
-    // and exponential representations, is 25 bytes; based on the settings used
-    // below for the DoubleToStringConverter. We add another byte for the null
-    // terminator, but it is not actually needed because we don't finalize the
-    // builder.
-    const auto max_required_size = 26;
-    const auto p = reinterpret_cast<char *>(context.reserve(max_required_size));
-
-    // The converter is based on the ECMAScript converter, but will not convert
-    // special values, like Infinity and NaN, since JSON does not support those.
-    using dtoa_converter = double_conversion::DoubleToStringConverter;
-    const dtoa_converter converter(
-        dtoa_converter::UNIQUE_ZERO | dtoa_converter::EMIT_POSITIVE_EXPONENT_SIGN,
-        nullptr, nullptr, 'e', -6, 21, 6, 0);
-
-    using dtoa_builder = double_conversion::StringBuilder;
-    dtoa_builder builder(p, max_required_size);
-    detail::fail_if(context, !converter.ToShortest(value, &builder), "Special values like 'Infinity' or 'NaN' are supported in JSON.");
-    context.advance(builder.position());
+    // JSON does not support special values, like Infinity and NaN.
+    detail::fail_if(context, !std::isfinite(value), "Special values like 'Infinity' or 'NaN' are supported in JSON.");
+    detail::encode_float(context, value);
   }
 };
 
@@ -168,7 +125,10 @@ json_force_inline T exp_10(
     for (unsigned i = 0; i < exponent; i++) {
       const auto old_value = value;
       value *= 10;
-      fail_if(context, intops::is_overflow(old_value, value), "Integer overflow");
+      if (json_unlikely(intops::is_overflow(old_value, value))) {
+        fail(context, "Integer overflow");
+        return value;
+      }
     }
   }
   return value;
@@ -354,11 +314,12 @@ json_never_inline T decode_integer_tricky(decode_context &context, const char *i
 }
 
 /**
- * Decode the integer at the context position. The integer can be specified
- * either as a pure integer: 'xxxx', where 'x' is a digit character between '0'
- * and '9'; and 'xxxx.yyyyE±zzzz', where 'y' and 'z' also are digit characters.
- * Pure integers are easy and fast to parse, but if we run into a decimal point
- * or an "exponent E", we need to switch over to a more complex parser. The same
+ * Decode the integer at the context position one digit at a time, checking for
+ * overflow after each digit. The integer can be specified either as a pure
+ * integer: 'xxxx', where 'x' is a digit character between '0' and '9'; and
+ * 'xxxx.yyyyE±zzzz', where 'y' and 'z' also are digit characters. Pure
+ * integers are easy and fast to parse, but if we run into a decimal point or
+ * an "exponent E", we need to switch over to a more complex parser. The same
  * thing happens if we overflow, because we cannot yet know if this was a true
  * overflow or if a negative exponent will reduce the integer into range again.
  * If the parsed number is too large to fit in the given integer type, a
@@ -366,12 +327,15 @@ json_never_inline T decode_integer_tricky(decode_context &context, const char *i
  * not used, i.e., if there is no positive exponent.
  */
 template <typename T, bool is_positive>
-json_never_inline T decode_integer(decode_context &context) {
+json_never_inline T decode_integer_digit_by_digit(decode_context &context) {
   using intops = integer_ops<T, is_positive>;
   const auto b = context.position;
   const auto c = next(context);
   const auto i = to_integer<T>(c);
-  fail_if(context, is_invalid_digit(i), "Invalid integer");
+  if (json_unlikely(is_invalid_digit(i))) {
+    fail(context, "Invalid integer");
+    return 0;
+  }
   T value = intops::accumulate(0, i);
 
   while (json_likely(context.remaining())) {
@@ -393,6 +357,119 @@ json_never_inline T decode_integer(decode_context &context) {
   return value;
 }
 
+/**
+ * The integer with the given magnitude, which was parsed from the digits in
+ * [begin, end), or, if it does not fit in the integer type, the result of
+ * decode_integer_tricky (which throws).
+ */
+template <typename T, bool is_positive>
+json_force_inline T finish_integer(
+    decode_context &context,
+    const char *begin,
+    const char *end,
+    const std::uint64_t magnitude) {
+  // The largest magnitude of the type; for negative numbers, that of the
+  // minimum value, which is one more than the maximum.
+  using unsigned_type = typename std::make_unsigned<T>::type;
+  const auto max_magnitude = std::uint64_t(unsigned_type(std::numeric_limits<T>::max())) + (is_positive ? 0 : 1);
+  if (json_unlikely(magnitude > max_magnitude)) {
+    return decode_integer_tricky<T, is_positive>(context, begin);
+  }
+
+  context.position = end;
+  return (is_positive ? T(magnitude) : T(unsigned_type(0) - unsigned_type(magnitude)));
+}
+
+/**
+ * Decode an integer with at least eight digits, the first eight of which are
+ * in first_chunk. Up to 19 digits always fit in 64 bits, and 20 digits do if
+ * the first 16 are small enough, so there is a single overflow check at the
+ * end.
+ */
+template <typename T, bool is_positive>
+json_never_inline T decode_long_integer(decode_context &context, const std::uint64_t first_chunk) {
+  static constexpr std::uint64_t powers_of_10[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+  };
+
+  const auto begin = context.position;
+  auto position = begin + 8;
+  auto magnitude = parse_digits_8(first_chunk, 8);
+  auto previous_magnitude = magnitude;
+  std::uint64_t last_digits = 0;
+  for (int i = 0; i < 2; i++) {
+    if (json_unlikely(!context.padded && context.end - position < 8)) {
+      return decode_integer_digit_by_digit<T, is_positive>(context);
+    }
+
+    std::uint64_t chunk;
+    std::memcpy(&chunk, position, 8);
+    const auto num_digits = unsigned(std::min<std::ptrdiff_t>(count_digits_8(chunk), context.end - position));
+    if (num_digits) {
+      previous_magnitude = magnitude;
+      last_digits = parse_digits_8(chunk, num_digits);
+      magnitude = magnitude * powers_of_10[num_digits] + last_digits;
+      position += num_digits;
+    }
+    if (num_digits < 8) {
+      break;
+    }
+  }
+
+  const auto num_digits = position - begin;
+  const auto c = (position != context.end ? *position : 0);
+  if (json_unlikely(num_digits > 20 || c == '.' || c == 'e' || c == 'E')) {
+    return decode_integer_digit_by_digit<T, is_positive>(context);
+  }
+
+  // With 20 digits, the last four were added to the first 16, possibly
+  // wrapping around.
+  const auto max_uint64 = std::numeric_limits<std::uint64_t>::max();
+  if (json_unlikely(num_digits == 20 && previous_magnitude > (max_uint64 - last_digits) / 10000)) {
+    return decode_integer_tricky<T, is_positive>(context, begin);
+  }
+
+  return finish_integer<T, is_positive>(context, begin, position, magnitude);
+}
+
+/**
+ * Decode the integer at the context position eight digits at a time, which is
+ * much faster for long integers, like timestamps and IDs, than going digit by
+ * digit, and about as fast for short ones. The digits are counted and
+ * converted without any branches per digit, and there is a single overflow
+ * check. Anything unusual, such as decimals, more than 20 digits, or too
+ * little input left to load eight bytes at a time, is handed over to
+ * decode_integer_digit_by_digit.
+ */
+template <typename T, bool is_positive>
+json_never_inline T decode_integer(decode_context &context) {
+  const auto begin = context.position;
+  if (json_unlikely(!context.padded && context.end - begin < 8)) {
+    return decode_integer_digit_by_digit<T, is_positive>(context);
+  }
+
+  // With padded input, the chunk can reach past the end into the padding,
+  // which must not be taken for digits.
+  std::uint64_t chunk;
+  std::memcpy(&chunk, begin, 8);
+  const auto available = context.end - begin;
+  const auto num_digits = unsigned(std::min<std::ptrdiff_t>(count_digits_8(chunk), available));
+  if (json_unlikely(num_digits - 1 >= 7)) {
+    return (num_digits ?
+        decode_long_integer<T, is_positive>(context, chunk) :
+        decode_integer_digit_by_digit<T, is_positive>(context));
+  }
+
+  // The integer ends within the chunk, so the character after it is in it,
+  // unless the integer ends the input.
+  const auto c = (std::ptrdiff_t(num_digits) < available ? char(chunk >> (8 * num_digits)) : '\0');
+  if (json_unlikely(c == '.' || c == 'e' || c == 'E')) {
+    return decode_integer_digit_by_digit<T, is_positive>(context);
+  }
+
+  return finish_integer<T, is_positive>(context, begin, begin + num_digits, parse_digits_8(chunk, num_digits));
+}
+
 template <typename T>
 json_force_inline T decode_negative_integer(decode_context &context) {
   skip_unchecked_1(context);  // Skip past leading '-' character (checked in decode(...)).
@@ -416,6 +493,10 @@ class integer_t<T, true, false> {
     return decode_positive_integer<object_type>(context);
   }
 
+  unsigned first_tokens() const {
+    return detail::token_number;
+  }
+
   json_force_inline void encode(encode_context &context, const object_type value) const {
     encode_positive_integer(context, value);
   }
@@ -432,6 +513,10 @@ class integer_t<T, true, true> {
         decode_positive_integer<object_type>(context));
   }
 
+  unsigned first_tokens() const {
+    return detail::token_number;
+  }
+
   json_force_inline void encode(encode_context &context, const object_type value) const {
     if (value < 0) {
       encode_negative_integer(context, value);
@@ -466,7 +551,7 @@ class number_t<double> final : public detail::floating_point_t<double> {
 };
 
 template <typename T>
-number_t<T> number() {
+constexpr number_t<T> number() {
   return number_t<T>();
 }
 
@@ -16,12 +16,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <cstring>
 #include <functional>
 #include <memory>
 #include <string>
 #include <type_traits>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -30,9 +31,13 @@
 #include <spotify/json/decode_context.hpp>
 #include <spotify/json/default_codec.hpp>
 #include <spotify/json/detail/bitset.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/decode_string.hpp>
+#include <spotify/json/detail/key_index.hpp>
 #include <spotify/json/detail/macros.hpp>
 #include <spotify/json/detail/skip_value.hpp>
 #include <spotify/json/encode_context.hpp>
+#include <spotify/json/escape_policy.hpp>
 
 namespace spotify {
 namespace json {
@@ -69,42 +74,124 @@ class object_t final {
     add_field(name, true, std::forward<args_type>(args)...);
   }
 
-  json_never_inline object_type decode(decode_context &context) const {
-    uint_fast32_t uniq_seen_required = 0;
-    detail::bitset<64> seen_required(_num_required_fields);
+  /**
+   * Learn the order in which fields appear in the input. Each key is first
+   * compared with the field that followed the previous field the last time,
+   * and only looked up if that guess is wrong. This makes decoding cheaper
+   * when, as is usually the case, all input is written by producers with the
+   * same field order. The learned order is shared by all copies of the codec
+   * and is updated without locks, so it may be decoded from many threads.
+   */
+  void predict_field_order(const bool enabled = true) {
+    _field_order = (enabled ? std::make_shared<field_order>(_field_list.size()) : nullptr);
+  }
 
-    object_type output = construct(std::is_default_constructible<T>());
-    detail::decode_object<string_t>(context, [&](const std::string &key) {
-      const auto field_it = _fields.find(key);
-      if (json_unlikely(field_it == _fields.end())) {
-        return detail::skip_value(context);
-      }
+  /**
+   * The number of keys that matched and did not match the predicted field,
+   * since predict_field_order was called or a field was added. Both are zero
+   * if the field order is not predicted.
+   */
+  uint64_t predicted_field_hits() const {
+    return (_field_order ? _field_order->hits.load(std::memory_order_relaxed) : 0);
+  }
 
-      const auto &field = *(*field_it).second;
-      field.decode(context, output);
-      if (field.is_required()) {
-        const auto seen = seen_required.test_and_set(field.required_field_idx());
-        uniq_seen_required += (1 - seen);  // 'seen' is 1 when the field is a duplicate; 0 otherwise
-      }
+  uint64_t predicted_field_misses() const {
+    return (_field_order ? _field_order->misses.load(std::memory_order_relaxed) : 0);
+  }
+
+  /**
+   * Escape the keys of the fields, which are escaped once when they are added
+   * rather than every time that an object is encoded, with the given policy.
+   * The default is escape_policy::standard, regardless of the escaping policy
+   * of the encode_context.
+   */
+  void escape_keys(const escape_policy escaping) {
+    _key_escaping = escaping;
+    _encoded_keys_size = 0;
+    for (size_t i = 0; i < _field_list.size(); i++) {
+      _field_list[i].first = escape_key(_field_index.key(i));
+      _encoded_keys_size += _field_list[i].first.size();
+    }
+  }
+
+  json_never_inline object_type decode(decode_context &context) const {
+    if (_field_order) {
+      return decode_predicting_order(context, *_field_order);
+    }
+
+    return decode_fields(context, [&](const char *key, const size_t key_size) {
+      return _field_index.find(key, key_size);
     });
+  }
 
-    const auto is_missing_req_fields = (uniq_seen_required != _num_required_fields);
-    detail::fail_if(context, is_missing_req_fields, "Missing required field(s)");
-    return output;
+  unsigned first_tokens() const {
+    return detail::token_object;
+  }
+
+  /**
+   * An object that is decoded one field at a time, by a decoder that receives
+   * the input in pieces, such as chunked_decoder, and so cannot call decode.
+   */
+  struct partial_object {
+    object_type object;
+    uint_fast32_t uniq_seen_required;
+    detail::bitset<64> seen_required;
+  };
+
+  partial_object begin_partial_decode() const {
+    return partial_object{
+        construct(std::is_default_constructible<T>()), 0, detail::bitset<64>(_num_required_fields) };
+  }
+
+  /**
+   * Decode the value of the field with the given key, or skip it if there is
+   * no such field, from the context, which must be at the start of the value.
+   */
+  void decode_partial_field(
+      decode_context &context,
+      partial_object &partial,
+      const char *key,
+      const size_t key_size) const {
+    const auto field_idx = _field_index.find(key, key_size);
+    if (json_unlikely(field_idx == detail::key_index::npos)) {
+      return detail::skip_value(context);
+    }
+    decode_field(context, partial.object, field_idx, partial.uniq_seen_required, partial.seen_required);
   }
 
+  /**
+   * Check that all required fields were decoded, after the closing brace.
+   */
+  void end_partial_decode(const decode_context &context, const partial_object &partial) const {
+    check_required_fields(context, partial.uniq_seen_required);
+  }
+
+  /**
+   * Every field writes its key prefixed with a comma, ',"key":', as a single
+   * fragment that was rendered when the field was added, followed by its
+   * value. The comma of the first field that is written is then turned into
+   * the opening brace, so that no field has to know whether it is the first.
+   */
   void encode(encode_context &context, const object_type &value) const {
-    context.append('{');
+    context.reserve(_encoded_keys_size + 2);  // the keys and "{}"
+    const auto begin = context.size();
     for (const auto &field : _field_list) {
       field.second->encode(context, field.first, value);
     }
-    context.append_or_replace(',', '}');
+
+    if (json_likely(context.size() != begin)) {
+      context.replace(begin, '{');
+      context.append('}');
+    } else {
+      context.append("{}", 2);
+    }
   }
 
  private:
-  static std::string escape_key(const std::string &key) {
+  std::string escape_key(const std::string &key) const {
     encode_context context;
-    string().encode(context, key);
+    context.append(',');
+    string(_key_escaping).encode(context, key);
     context.append(':');
     return std::string(context.data(), context.size());
   }
@@ -121,16 +208,104 @@ class object_t final {
       const codec_type &codec,
       const value_type &value) {
     codec.encode(context, value);
-    context.append(',');
   }
 
-  T construct(std::true_type is_default_constructible) const {
+  struct field_order {
+    explicit field_order(const size_t num_fields)
+        : first(detail::key_index::npos),
+          next(new std::atomic<size_t>[num_fields]),
+          hits(0),
+          misses(0) {
+      for (size_t i = 0; i < num_fields; i++) {
+        next[i].store(detail::key_index::npos, std::memory_order_relaxed);
+      }
+    }
+
+    // The field that came first, and the field that came after each field,
+    // the last time that the prediction was wrong.
+    std::atomic<size_t> first;
+    std::unique_ptr<std::atomic<size_t>[]> next;
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+  };
+
+  template <typename find_function>
+  json_force_inline object_type decode_fields(
+      decode_context &context,
+      const find_function &find_field) const {
+    uint_fast32_t uniq_seen_required = 0;
+    detail::bitset<64> seen_required(_num_required_fields);
+
+    object_type output = construct(std::is_default_constructible<T>());
+    detail::decode_object_raw_keys(context, [&](const char *key, const size_t key_size) {
+      const auto field_idx = find_field(key, key_size);
+      if (json_unlikely(field_idx == detail::key_index::npos)) {
+        return detail::skip_value(context);
+      }
+      decode_field(context, output, field_idx, uniq_seen_required, seen_required);
+    });
+
+    check_required_fields(context, uniq_seen_required);
+    return output;
+  }
+
+  json_force_inline void decode_field(
+      decode_context &context,
+      object_type &output,
+      const size_t field_idx,
+      uint_fast32_t &uniq_seen_required,
+      detail::bitset<64> &seen_required) const {
+    const auto &field = *_field_list[field_idx].second;
+    field.decode(context, output);
+    if (field.is_required()) {
+      const auto seen = seen_required.test_and_set(field.required_field_idx());
+      uniq_seen_required += (1 - seen);  // 'seen' is 1 when the field is a duplicate; 0 otherwise
+    }
+  }
+
+  json_force_inline void check_required_fields(
+      const decode_context &context,
+      const uint_fast32_t uniq_seen_required) const {
+    const auto is_missing_req_fields = (uniq_seen_required != _num_required_fields);
+    detail::fail_if(context, is_missing_req_fields, "Missing required field(s)");
+  }
+
+  object_type decode_predicting_order(decode_context &context, field_order &order) const {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    auto previous_idx = detail::key_index::npos;
+
+    auto output = decode_fields(context, [&](const char *key, const size_t key_size) {
+      auto &prediction = (previous_idx == detail::key_index::npos ? order.first : order.next[previous_idx]);
+      const auto predicted_idx = prediction.load(std::memory_order_relaxed);
+      if (json_likely(predicted_idx < _field_list.size() && _field_index.is_key(predicted_idx, key, key_size))) {
+        hits++;
+        return (previous_idx = predicted_idx);
+      }
+
+      // Unknown keys are not learned, so that the field after them is
+      // predicted from the last known field.
+      misses++;
+      const auto field_idx = _field_index.find(key, key_size);
+      if (field_idx != detail::key_index::npos) {
+        prediction.store(field_idx, std::memory_order_relaxed);
+        previous_idx = field_idx;
+      }
+      return field_idx;
+    });
+
+    order.hits.fetch_add(hits, std::memory_order_relaxed);
+    order.misses.fetch_add(misses, std::memory_order_relaxed);
+    return output;
+  }
+
+  T construct(std::true_type) const {
     // Avoid the cost of an std::function invocation if no construct function
     // is provided.
     return _construct ? _construct() : object_type();
   }
 
-  T construct(std::false_type is_default_constructible) const {
+  T construct(std::false_type) const {
     // T is not default constructible. Because _construct must be set if T is
     // not default constructible, there is no reason to test it in this case.
     return _construct();
@@ -160,14 +335,14 @@ class object_t final {
         : field(required, required_field_idx),
           codec(std::move(codec)) {}
 
-    void decode(decode_context &context, object_type &object) const override {
+    void decode(decode_context &context, object_type &) const override {
       codec.decode(context);
     }
 
     void encode(
         encode_context &context,
         const std::string &escaped_key,
-        const object_type &object) const override {
+        const object_type &) const override {
       const auto &value = typename codec_type::object_type();
       if (json_likely(detail::should_encode(codec, value))) {
         append_key_to_context(context, escaped_key);
@@ -353,15 +528,16 @@ class object_t final {
   }
 
   void save_field(const std::string &name, bool required, const std::shared_ptr<field> &f) {
-    const auto was_saved = _fields.insert(typename field_map::value_type(name, f)).second;
+    const auto was_saved = _field_index.insert(name);
     if (was_saved) {
       _field_list.push_back(std::make_pair(escape_key(name), f));
+      _encoded_keys_size += _field_list.back().first.size();
       _num_required_fields += size_t(required);
+      predict_field_order(_field_order != nullptr);
     }
   }
 
   using field_vec = std::vector<std::pair<std::string, std::shared_ptr<const field>>>;
-  using field_map = std::unordered_map<std::string, std::shared_ptr<const field>>;
 
   /**
    * _construct may be unset, but only if T is default constructible. This is
@@ -370,8 +546,11 @@ class object_t final {
    */
   const std::function<T ()> _construct;
   field_vec _field_list;
-  field_map _fields;
+  detail::key_index _field_index;  // maps field names to _field_list indices
+  std::shared_ptr<field_order> _field_order;
+  size_t _encoded_keys_size = 0;
   size_t _num_required_fields = 0;
+  escape_policy _key_escaping = escape_policy::standard;
 };
 
 template <typename T>
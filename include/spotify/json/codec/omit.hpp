@@ -34,6 +34,11 @@ class omit_t final {
 
   object_type decode(decode_context &context) const {
     detail::fail(context, "omit_t codec cannot decode");
+    return object_type();
+  }
+
+  unsigned first_tokens() const {
+    return 0;
   }
 
   void encode(encode_context &context, const object_type &value) const {
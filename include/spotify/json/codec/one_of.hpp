@@ -20,6 +20,9 @@
 #include <type_traits>
 
 #include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_error.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/encode_helpers.hpp>
 #include <spotify/json/encode_context.hpp>
 
 namespace spotify {
@@ -41,29 +44,64 @@ struct codecs_share_same_object_type<codec_type_1, codec_type_2, codecs_type...>
               typename codec_type_2::object_type>::value &&
           codecs_share_same_object_type<codec_type_2, codecs_type...>::value> {};
 
+/**
+ * Try the codecs in order, starting with the one at index (size - N), but skip
+ * those that cannot decode the kind of value at hand. The last codec is always
+ * tried, so that the error is the same as if all the codecs had been tried.
+ *
+ * The other codecs record their errors in a decode_error of their own rather
+ * than throwing, see decode_context::error, so that backtracking to the next
+ * codec does not cost an exception.
+ */
 template <typename tuple_type, size_t N>
 struct try_each_codec {
   using object_type = typename std::tuple_element<
       std::tuple_size<tuple_type>::value - N, tuple_type>::type::object_type;
 
   static object_type decode(const tuple_type &tuple, decode_context &context) {
+    const auto &codec = std::get<std::tuple_size<tuple_type>::value - N>(tuple);
+    if (!(first_tokens(codec) & token_kind_of(peek(context)))) {
+      return try_each_codec<tuple_type, N - 1>::decode(tuple, context);
+    }
+
+    // Codecs that do not record their errors may still throw; either way,
+    // try the next one.
     const auto original_position = context.position;
+    const auto original_error = context.error;
+    decode_error error;
+    context.error = &error;
     try {
-      return std::get<std::tuple_size<tuple_type>::value - N>(tuple).decode(context);
+      auto result = codec.decode(context);
+      context.error = original_error;
+      if (json_likely(!error)) {
+        return result;
+      }
     } catch (const decode_exception &) {
-      context.position = original_position;
-      return try_each_codec<tuple_type, N - 1>::decode(tuple, context);
+      context.error = original_error;
     }
+
+    context.position = original_position;
+    return try_each_codec<tuple_type, N - 1>::decode(tuple, context);
+  }
+
+  static unsigned first_tokens_of_all(const tuple_type &tuple) {
+    return first_tokens(std::get<std::tuple_size<tuple_type>::value - N>(tuple)) |
+        try_each_codec<tuple_type, N - 1>::first_tokens_of_all(tuple);
   }
 };
 
 template <typename tuple_type>
-struct try_each_codec<tuple_type, 0> {
-  using object_type = typename std::tuple_element<0, tuple_type>::type::object_type;
+struct try_each_codec<tuple_type, 1> {
+  using object_type = typename std::tuple_element<
+      std::tuple_size<tuple_type>::value - 1, tuple_type>::type::object_type;
 
   static object_type decode(const tuple_type &tuple, decode_context &context) {
     return std::get<std::tuple_size<tuple_type>::value - 1>(tuple).decode(context);
   }
+
+  static unsigned first_tokens_of_all(const tuple_type &tuple) {
+    return first_tokens(std::get<std::tuple_size<tuple_type>::value - 1>(tuple));
+  }
 };
 
 }  // namespace detail
@@ -72,7 +110,10 @@ namespace codec {
 
 /**
  * Takes an ordered list of codecs and applies them one by one. The first
- * one that succeeds will be used.
+ * one that succeeds will be used. Codecs that cannot decode the kind of value
+ * that is being decoded (according to their first_tokens methods, see
+ * codec_interface) are not tried, so for example one_of(string(), null())
+ * goes straight to the null codec when it sees a null.
  *
  * When encoding, the first codec is always used.
  */
@@ -94,6 +135,11 @@ class one_of_t final {
         decltype(_codecs), std::tuple_size<decltype(_codecs)>::value>::decode(_codecs, context);
   }
 
+  unsigned first_tokens() const {
+    return detail::try_each_codec<
+        decltype(_codecs), std::tuple_size<decltype(_codecs)>::value>::first_tokens_of_all(_codecs);
+  }
+
   void encode(encode_context &context, const object_type &value) const {
     std::get<0>(_codecs).encode(context, value);
   }
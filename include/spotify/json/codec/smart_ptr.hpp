@@ -20,6 +20,7 @@
 
 #include <spotify/json/decode_context.hpp>
 #include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
 #include <spotify/json/detail/encode_helpers.hpp>
 #include <spotify/json/encode_context.hpp>
 
@@ -64,6 +65,10 @@ class smart_ptr_t final {
     return codec::make_smart_ptr_t<object_type>::make(_inner_codec.decode(context));
   }
 
+  unsigned first_tokens() const {
+    return detail::first_tokens(_inner_codec);
+  }
+
   void encode(encode_context &context, const object_type &value) const {
     detail::fail_if(context, !value, "Cannot encode null smart pointer");
     _inner_codec.encode(context, *value);
@@ -73,6 +78,10 @@ class smart_ptr_t final {
     return bool(value);
   }
 
+  const codec_type &inner_codec() const {
+    return _inner_codec;
+  }
+
  protected:
   codec_type _inner_codec;
 };
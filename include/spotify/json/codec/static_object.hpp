@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/bitset.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/decode_string.hpp>
+#include <spotify/json/detail/encode_helpers.hpp>
+#include <spotify/json/detail/encode_string.hpp>
+#include <spotify/json/detail/macros.hpp>
+#include <spotify/json/detail/skip_value.hpp>
+#include <spotify/json/encode_context.hpp>
+#include <spotify/json/escape_policy.hpp>
+#include <spotify/json/string_ref.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+constexpr unsigned escape_policy_bit(const escape_policy policy) {
+  return (1u << static_cast<unsigned>(policy));
+}
+
+/**
+ * The escape policies that write the character as is, as a mask of
+ * escape_policy_bit.
+ */
+constexpr unsigned plain_char_policies(const char c) {
+  return escape_policy_bit(escape_policy::trusted) | (
+      (static_cast<unsigned char>(c) < 0x20 || c == '"' || c == '\\') ? 0 :
+      (static_cast<unsigned char>(c) >= 0x80) ?
+          escape_policy_bit(escape_policy::standard) | escape_policy_bit(escape_policy::html_safe) :
+      (c == '<' || c == '>' || c == '&') ?
+          escape_policy_bit(escape_policy::standard) | escape_policy_bit(escape_policy::ascii) :
+      escape_policy_bit(escape_policy::standard) |
+          escape_policy_bit(escape_policy::ascii) |
+          escape_policy_bit(escape_policy::html_safe));
+}
+
+/**
+ * The escape policies that write the key as is, so that it can be copied
+ * between quotes without escaping it, as a mask of escape_policy_bit.
+ */
+constexpr unsigned plain_key_policies(const char *key, const std::size_t size) {
+  return (size == 0 ? ~0u : plain_char_policies(key[0]) & plain_key_policies(key + 1, size - 1));
+}
+
+template <typename... fields_type>
+struct count_required_fields;
+
+template <>
+struct count_required_fields<> {
+  static constexpr std::size_t value = 0;
+};
+
+template <typename field_type, typename... fields_type>
+struct count_required_fields<field_type, fields_type...> {
+  static constexpr std::size_t value =
+      std::size_t(field_type::is_required) + count_required_fields<fields_type...>::value;
+};
+
+/**
+ * The fields of a static_object_t. This is like a std::tuple, but unlike the
+ * constructors of std::tuple, its constructor is constexpr in C++11.
+ */
+template <typename... fields_type>
+struct field_list;
+
+template <>
+struct field_list<> {
+  constexpr field_list() {}
+};
+
+template <typename field_type, typename... fields_type>
+struct field_list<field_type, fields_type...> {
+  constexpr explicit field_list(const field_type &head, const fields_type &...tail)
+      : head(head),
+        tail(tail...) {}
+
+  field_type head;
+  field_list<fields_type...> tail;
+};
+
+/**
+ * Decodes and encodes the fields of a static_object_t, one field_list at a
+ * time. Each field is handled by its own instantiation, so the key
+ * comparisons and the calls to the field codecs can all be inlined.
+ */
+template <typename T, std::size_t num_required, typename... fields_type>
+struct static_object_fields;
+
+template <typename T, std::size_t num_required>
+struct static_object_fields<T, num_required> {
+  template <typename seen_type>
+  json_force_inline static bool decode(
+      const field_list<> &,
+      const char *,
+      const std::size_t,
+      decode_context &,
+      T &,
+      seen_type &,
+      std::size_t &) {
+    return false;
+  }
+
+  json_force_inline static void encode(
+      const field_list<> &,
+      encode_context &,
+      const T &) {}
+};
+
+template <typename T, std::size_t num_required, typename field_type, typename... fields_type>
+struct static_object_fields<T, num_required, field_type, fields_type...> {
+  static constexpr std::size_t required_field_idx =
+      num_required - count_required_fields<field_type, fields_type...>::value;
+
+  using next = static_object_fields<T, num_required, fields_type...>;
+
+  template <typename seen_type>
+  json_force_inline static bool decode(
+      const field_list<field_type, fields_type...> &fields,
+      const char *key,
+      const std::size_t key_size,
+      decode_context &context,
+      T &object,
+      seen_type &seen_required,
+      std::size_t &uniq_seen_required) {
+    const auto &field = fields.head;
+    if (key_size != field_type::name_size || std::memcmp(key, field.name, field_type::name_size)) {
+      return next::decode(fields.tail, key, key_size, context, object, seen_required, uniq_seen_required);
+    }
+
+    object.*field.member = field.codec.decode(context);
+    if (field_type::is_required) {
+      const auto seen = seen_required.test_and_set(required_field_idx);
+      uniq_seen_required += (1 - seen);  // 'seen' is 1 when the field is a duplicate; 0 otherwise
+    }
+    return true;
+  }
+
+  json_force_inline static void encode(
+      const field_list<field_type, fields_type...> &fields,
+      encode_context &context,
+      const T &object) {
+    const auto &field = fields.head;
+    const auto &value = object.*field.member;
+    if (json_likely(should_encode(field.codec, value))) {
+      if (json_likely(field.plain_name_policies & escape_policy_bit(context.escaping))) {
+        const auto buffer = context.reserve(field_type::name_size + 3);
+        buffer[0] = '"';
+        std::memcpy(buffer + 1, field.name, field_type::name_size);
+        buffer[field_type::name_size + 1] = '"';
+        buffer[field_type::name_size + 2] = ':';
+        context.advance(field_type::name_size + 3);
+      } else {
+        encode_string(context, string_ref(field.name, field_type::name_size));
+        context.append(':');
+      }
+      field.codec.encode(context, value);
+      context.append(',');
+    }
+    next::encode(fields.tail, context, object);
+  }
+};
+
+}  // namespace detail
+
+namespace codec {
+
+/**
+ * A field of a static_object_t, created with required_field or optional_field.
+ * The name must be a string literal (or otherwise outlive the codec), because
+ * only a pointer to it is kept.
+ */
+template <bool required, std::size_t size, typename member_ptr, typename codec_type>
+struct static_field final {
+  static constexpr bool is_required = required;
+  static constexpr std::size_t name_size = size;
+
+  constexpr static_field(const char *name, member_ptr member, const codec_type &codec)
+      : name(name),
+        plain_name_policies(detail::plain_key_policies(name, size)),
+        member(member),
+        codec(codec) {}
+
+  const char *name;
+  unsigned plain_name_policies;  // see detail::plain_key_policies
+  member_ptr member;
+  codec_type codec;
+};
+
+/**
+ * An object codec with a fixed list of member variable fields. It decodes and
+ * encodes the same JSON as an object_t with the same fields, but because the
+ * fields are template parameters rather than virtual objects in a hash table,
+ * every key comparison and field codec call can be inlined, and creating the
+ * codec does not allocate. Keys are matched against the fields one by one, so
+ * object_t is the better choice for objects with many fields.
+ */
+template <typename T, typename... fields_type>
+class static_object_t final {
+ public:
+  using object_type = T;
+
+  static_assert(
+      std::is_default_constructible<T>::value,
+      "static_object_t requires a default constructible object type");
+
+  constexpr explicit static_object_t(const fields_type &...fields)
+      : _fields(fields...) {}
+
+  json_never_inline object_type decode(decode_context &context) const {
+    std::size_t uniq_seen_required = 0;
+    detail::bitset<num_required_fields> seen_required(num_required_fields);
+
+    object_type output = object_type();
+    detail::decode_object_raw_keys(context, [&](const char *key, const std::size_t key_size) {
+      const auto found = fields::decode(
+          _fields, key, key_size, context, output, seen_required, uniq_seen_required);
+      if (json_unlikely(!found)) {
+        detail::skip_value(context);
+      }
+    });
+
+    const auto is_missing_req_fields = (uniq_seen_required != num_required_fields);
+    detail::fail_if(context, is_missing_req_fields, "Missing required field(s)");
+    return output;
+  }
+
+  unsigned first_tokens() const {
+    return detail::token_object;
+  }
+
+  void encode(encode_context &context, const object_type &value) const {
+    context.append('{');
+    fields::encode(_fields, context, value);
+    context.append_or_replace(',', '}');
+  }
+
+ private:
+  static constexpr std::size_t num_required_fields =
+      detail::count_required_fields<fields_type...>::value;
+
+  using fields = detail::static_object_fields<T, num_required_fields, fields_type...>;
+
+  detail::field_list<fields_type...> _fields;
+};
+
+template <std::size_t name_size, typename value_type, typename object_type, typename codec_type>
+constexpr static_field<true, name_size - 1, value_type object_type::*, typename std::decay<codec_type>::type>
+required_field(const char (&name)[name_size], value_type object_type::*member, codec_type &&codec) {
+  return static_field<true, name_size - 1, value_type object_type::*, typename std::decay<codec_type>::type>(
+      name, member, static_cast<codec_type &&>(codec));  // std::forward is not constexpr in C++11
+}
+
+template <std::size_t name_size, typename value_type, typename object_type>
+constexpr auto required_field(const char (&name)[name_size], value_type object_type::*member)
+    -> decltype(required_field(name, member, default_codec<value_type>())) {
+  return required_field(name, member, default_codec<value_type>());
+}
+
+template <std::size_t name_size, typename value_type, typename object_type, typename codec_type>
+constexpr static_field<false, name_size - 1, value_type object_type::*, typename std::decay<codec_type>::type>
+optional_field(const char (&name)[name_size], value_type object_type::*member, codec_type &&codec) {
+  return static_field<false, name_size - 1, value_type object_type::*, typename std::decay<codec_type>::type>(
+      name, member, static_cast<codec_type &&>(codec));
+}
+
+template <std::size_t name_size, typename value_type, typename object_type>
+constexpr auto optional_field(const char (&name)[name_size], value_type object_type::*member)
+    -> decltype(optional_field(name, member, default_codec<value_type>())) {
+  return optional_field(name, member, default_codec<value_type>());
+}
+
+template <typename T, typename... fields_type>
+constexpr static_object_t<T, fields_type...> static_object(const fields_type &...fields) {
+  return static_object_t<T, fields_type...>(fields...);
+}
+
+}  // namespace codec
+}  // namespace json
+}  // namespace spotify
@@ -20,10 +20,12 @@
 
 #include <spotify/json/decode_context.hpp>
 #include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
 #include <spotify/json/detail/decode_string.hpp>
 #include <spotify/json/detail/encode_string.hpp>
 #include <spotify/json/detail/macros.hpp>
 #include <spotify/json/encode_context.hpp>
+#include <spotify/json/escape_policy.hpp>
 
 namespace spotify {
 namespace json {
@@ -33,19 +35,41 @@ class string_t final {
  public:
   using object_type = std::string;
 
+  string_t() = default;
+
+  /**
+   * Escape strings as the policy says, instead of as the escaping policy of
+   * the encode_context says.
+   */
+  constexpr explicit string_t(const escape_policy escaping)
+      : _escaping(escaping),
+        _has_escaping(true) {}
+
   json_never_inline object_type decode(decode_context &context) const {
     return detail::decode_string<object_type>(context);
   }
 
+  unsigned first_tokens() const {
+    return detail::token_string;
+  }
+
   json_never_inline void encode(encode_context &context, const object_type &value) const {
-    detail::encode_string(context, value);
+    detail::encode_string(context, value, _has_escaping ? _escaping : context.escaping);
   }
+
+ private:
+  escape_policy _escaping = escape_policy::standard;
+  bool _has_escaping = false;
 };
 
-inline string_t string() {
+constexpr string_t string() {
   return string_t();
 }
 
+constexpr string_t string(const escape_policy escaping) {
+  return string_t(escaping);
+}
+
 }  // namespace codec
 
 template <>
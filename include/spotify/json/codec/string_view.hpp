@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/encode_string.hpp>
+#include <spotify/json/detail/macros.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/encode_context.hpp>
+#include <spotify/json/string_ref.hpp>
+
+namespace spotify {
+namespace json {
+namespace codec {
+
+/**
+ * Decodes strings without copying them, into string_refs that point into the
+ * input. Only strings without escape sequences can be decoded this way; use
+ * lazy_string_t for input that may have them.
+ */
+class string_view_t final {
+ public:
+  using object_type = string_ref;
+
+  json_force_inline object_type decode(decode_context &context) const {
+    if (json_unlikely(!detail::skip_1(context, '"'))) {
+      return object_type();
+    }
+
+    const auto begin_simple = context.position;
+    detail::skip_any_simple_characters(context);
+
+    switch (detail::next(context, decode_error::unterminated_string)) {
+      case '"': return object_type(begin_simple, context.position - 1 - begin_simple);
+      case '\\': detail::fail(context, "Escaped strings can not be decoded in place", -1); return object_type();
+      default: return object_type();  // failed without throwing
+    }
+  }
+
+  unsigned first_tokens() const {
+    return detail::token_string;
+  }
+
+  void encode(encode_context &context, const object_type &value) const {
+    detail::encode_string(context, value);
+  }
+};
+
+inline string_view_t string_view() {
+  return string_view_t();
+}
+
+}  // namespace codec
+
+template <>
+struct default_codec_t<string_ref> {
+  static codec::string_view_t codec() {
+    return codec::string_view_t();
+  }
+};
+
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <spotify/json/codec/cast.hpp>
+#include <spotify/json/codec/smart_ptr.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/decode_string.hpp>
+#include <spotify/json/detail/encode_helpers.hpp>
+#include <spotify/json/detail/key_index.hpp>
+#include <spotify/json/detail/macros.hpp>
+#include <spotify/json/detail/skip_value.hpp>
+#include <spotify/json/encode_context.hpp>
+
+namespace spotify {
+namespace json {
+namespace codec {
+
+/**
+ * Codec for JSON objects that come in several variants, which are told apart
+ * by a tag field, for example {"type":"track",...} and {"type":"episode",...}.
+ * Each variant has its own codec, which decodes and encodes the whole object.
+ *
+ * When decoding, the values of the fields before the tag field are skipped
+ * over without being decoded, and the tag is looked up where it is in the
+ * input. Decoding then continues after the tag with the codec of the variant,
+ * which is given the fields before the tag, and the tag itself, first. Variant
+ * codecs that cannot decode an object one field at a time, see
+ * detail::has_partial_decode_methods, decode the whole object instead. The
+ * variant codecs do not need to know about the tag field, as long as they
+ * ignore unknown fields like object_t does. When encoding, the tag field is
+ * written first, followed by the fields that the variant codec writes.
+ */
+template <typename T>
+class tagged_union_t final {
+ public:
+  using object_type = T;
+
+  explicit tagged_union_t(std::string tag_field)
+      : _tag_field(std::move(tag_field)) {}
+
+  /**
+   * Decode objects with the given tag using codec, which must decode to
+   * object_type. Values for which is_variant returns true are encoded using
+   * codec. The first variant that is added for a tag is used.
+   */
+  template <typename codec_type, typename predicate_type>
+  void variant(const std::string &tag, codec_type &&codec, predicate_type &&is_variant) {
+    using variant_type = predicate_variant<
+        typename std::decay<codec_type>::type,
+        typename std::decay<predicate_type>::type>;
+    save_variant(tag, std::make_shared<variant_type>(
+        std::forward<codec_type>(codec),
+        std::forward<predicate_type>(is_variant)));
+  }
+
+  /**
+   * Decode objects with the given tag using codec, which must decode to a
+   * smart pointer that converts to object_type. Values that point to objects
+   * of the type that the codec encodes are encoded using codec, see cast_t.
+   */
+  template <typename codec_type>
+  void variant(const std::string &tag, codec_type &&codec) {
+    using variant_type = cast_variant<typename std::decay<codec_type>::type>;
+    save_variant(tag, std::make_shared<variant_type>(std::forward<codec_type>(codec)));
+  }
+
+  object_type decode(decode_context &context) const {
+    tag_position where;
+    const auto variant = find_variant(context, where);
+    if (json_unlikely(!variant)) {
+      return object_type();
+    }
+    return variant->decode(context, where);
+  }
+
+  unsigned first_tokens() const {
+    return detail::token_object;
+  }
+
+  void encode(encode_context &context, const object_type &value) const {
+    for (const auto &variant : _variant_list) {
+      if (variant.second->is_variant(value)) {
+        context.append(variant.first.data(), variant.first.size());
+        const auto begin = context.size();
+        variant.second->encode(context, value);
+        merge_objects(context, begin);
+        return;
+      }
+    }
+
+    detail::fail(context, "Encoding value of unknown variant");
+  }
+
+ private:
+  /**
+   * Where the tag field of an object is: the members before it span
+   * [object_begin + 1, tag_begin), and its value starts at tag_value. The
+   * context is right after the tag value.
+   */
+  struct tag_position {
+    const char *object_begin;
+    const char *tag_begin;
+    const char *tag_value;
+    const std::string *tag_field;
+  };
+
+  struct variant_codec {
+    virtual ~variant_codec() = default;
+
+    virtual object_type decode(decode_context &context, const tag_position &where) const = 0;
+    virtual void encode(encode_context &context, const object_type &value) const = 0;
+    virtual bool is_variant(const object_type &value) const = 0;
+  };
+
+  template <typename codec_type, typename predicate_type>
+  struct predicate_variant final : public variant_codec {
+    template <typename predicate_arg>
+    predicate_variant(codec_type codec, predicate_arg &&predicate)
+        : codec(std::move(codec)),
+          predicate(std::forward<predicate_arg>(predicate)) {}
+
+    object_type decode(decode_context &context, const tag_position &where) const override {
+      return decode_rest(codec, context, where);
+    }
+
+    void encode(encode_context &context, const object_type &value) const override {
+      codec.encode(context, value);
+    }
+
+    bool is_variant(const object_type &value) const override {
+      return predicate(value);
+    }
+
+    codec_type codec;
+    predicate_type predicate;
+  };
+
+  template <typename codec_type>
+  struct cast_variant final : public variant_codec {
+    using inner_type = typename codec_type::object_type;
+
+    explicit cast_variant(codec_type codec)
+        : codec(std::move(codec)) {}
+
+    object_type decode(decode_context &context, const tag_position &where) const override {
+      return object_type(decode_rest(codec, context, where));
+    }
+
+    void encode(encode_context &context, const object_type &value) const override {
+      codec.encode(context, codec_cast<inner_type, object_type>::cast(value));
+    }
+
+    bool is_variant(const object_type &value) const override {
+      return bool(codec_cast<inner_type, object_type>::cast(value));
+    }
+
+    codec_type codec;
+  };
+
+  /**
+   * Find the variant of the object at context.position by looking for its tag
+   * field. The keys and the tag are compared where they are in the input, and
+   * the values of the other fields are skipped without decoding them. Returns
+   * nullptr if it fails without throwing, see decode_context::error.
+   */
+  json_never_inline const variant_codec *find_variant(decode_context &context, tag_position &where) const {
+    where.object_begin = context.position;
+    where.tag_field = &_tag_field;
+    if (json_unlikely(!detail::skip_1(context, '{'))) {
+      return nullptr;
+    }
+    detail::skip_any_whitespace(context);
+
+    while (json_likely(detail::peek(context) != '}')) {
+      where.tag_begin = context.position;
+      auto is_tag = false;
+      detail::decode_raw_key(context, [&](const char *key, const size_t key_size) {
+        is_tag = (key_size == _tag_field.size() && std::memcmp(key, _tag_field.data(), key_size) == 0);
+      });
+      detail::skip_any_whitespace(context);
+      if (json_unlikely(context.has_failed() || !detail::skip_1(context, ':'))) {
+        return nullptr;
+      }
+      detail::skip_any_whitespace(context);
+
+      if (is_tag) {
+        where.tag_value = context.position;
+        auto index = detail::key_index::npos;
+        detail::decode_raw_key(context, [&](const char *tag, const size_t tag_size) {
+          index = _tags.find(tag, tag_size);
+        });
+        if (json_unlikely(index == detail::key_index::npos)) {
+          if (!context.has_failed()) {
+            detail::fail(context, "Encountered unknown variant tag", where.tag_value - context.position);
+          }
+          return nullptr;
+        }
+        return _variant_list[index].second.get();
+      }
+
+      detail::skip_value(context);
+      detail::skip_any_whitespace(context);
+      if (detail::peek(context) != '}') {
+        detail::skip_1(context, ',');
+        detail::skip_any_whitespace(context);
+      }
+      if (json_unlikely(context.has_failed())) {
+        return nullptr;
+      }
+    }
+
+    detail::fail(context, "Missing variant tag field");
+    return nullptr;
+  }
+
+  /**
+   * Decode the rest of the object with a codec that decodes one field at a
+   * time: first the fields before the tag and the tag itself, which have
+   * already been scanned, from contexts of their own, and then the fields
+   * after the tag, from where the context is.
+   */
+  template <typename codec_type>
+  static typename std::enable_if<
+      detail::has_partial_decode_methods<codec_type>::value,
+      typename codec_type::object_type>::type
+  decode_rest(const codec_type &codec, decode_context &context, const tag_position &where) {
+    auto partial = codec.begin_partial_decode();
+
+    auto before = sub_context(context, where.object_begin + 1, where.tag_begin);
+    detail::skip_any_whitespace(before);
+    while (before.position != before.end && !before.has_failed()) {
+      decode_partial_member(codec, before, partial);
+      detail::skip_any_whitespace(before);
+      detail::skip_1(before, ',');
+      detail::skip_any_whitespace(before);
+    }
+
+    auto tag = sub_context(context, where.tag_value, context.position);
+    codec.decode_partial_field(tag, partial, where.tag_field->data(), where.tag_field->size());
+
+    detail::skip_any_whitespace(context);
+    while (json_likely(!context.has_failed() && detail::peek(context) != '}')) {
+      detail::skip_1(context, ',');
+      detail::skip_any_whitespace(context);
+      decode_partial_member(codec, context, partial);
+      detail::skip_any_whitespace(context);
+    }
+
+    if (json_likely(!context.has_failed())) {
+      detail::skip_unchecked_1(context);
+      codec.end_partial_decode(context, partial);
+    }
+    return std::move(partial.object);
+  }
+
+  /**
+   * Decode the rest of the object with a smart pointer codec, using the
+   * partial decoding of the codec it wraps.
+   */
+  template <typename inner_codec_type, typename pointer_type>
+  static typename std::enable_if<
+      detail::has_partial_decode_methods<inner_codec_type>::value,
+      pointer_type>::type
+  decode_rest(
+      const detail::smart_ptr_t<inner_codec_type, pointer_type> &codec,
+      decode_context &context,
+      const tag_position &where) {
+    return make_smart_ptr_t<pointer_type>::make(decode_rest(codec.inner_codec(), context, where));
+  }
+
+  /**
+   * Decode the whole object with a codec that cannot decode one field at a
+   * time, from a context of its own that starts at the object.
+   */
+  template <typename codec_type>
+  static typename std::enable_if<
+      !detail::has_partial_decode_methods<codec_type>::value,
+      typename codec_type::object_type>::type
+  decode_rest(const codec_type &codec, decode_context &context, const tag_position &where) {
+    auto whole = sub_context(context, where.object_begin, context.end);
+    auto result = codec.decode(whole);
+    context.position = whole.position;
+    return result;
+  }
+
+  template <typename codec_type, typename partial_type>
+  static void decode_partial_member(const codec_type &codec, decode_context &context, partial_type &partial) {
+    detail::decode_raw_key(context, [&](const char *key, const size_t key_size) {
+      detail::skip_any_whitespace(context);
+      if (json_likely(detail::skip_1(context, ':'))) {
+        detail::skip_any_whitespace(context);
+        codec.decode_partial_field(context, partial, key, key_size);
+      }
+    });
+  }
+
+  /**
+   * A context for the part of the input that ends at end, with the same
+   * begin, so that errors have the same offsets, and the same settings.
+   */
+  static decode_context sub_context(const decode_context &context, const char *position, const char *end) {
+    auto sub = ((context.padded && end == context.end) ?
+        decode_context(context.begin, end, decode_context::padded_input()) :
+        decode_context(context.begin, end));
+    sub.position = position;
+    sub.strict_utf8 = context.strict_utf8;
+    sub.error = context.error;
+    return sub;
+  }
+
+  /**
+   * Merge the object that was just encoded at begin into the object that was
+   * opened before it, by replacing its opening brace with a comma, or with
+   * the closing brace if it is empty.
+   */
+  static void merge_objects(encode_context &context, const size_t begin) {
+    const auto size = context.size() - begin;
+    const auto inner = context.data() + begin;
+    detail::fail_if(
+        context,
+        size < 2 || inner[0] != '{' || inner[size - 1] != '}',
+        "The codecs of tagged_union_t variants must encode objects");
+
+    context.retreat(size);
+    const auto buffer = context.reserve(size);  // still holds the object
+    buffer[0] = (size == 2 ? '}' : ',');
+    context.advance(size == 2 ? 1 : size);
+  }
+
+  static std::string tag_prefix(const std::string &tag_field, const std::string &tag) {
+    encode_context context;
+    context.append('{');
+    string().encode(context, tag_field);
+    context.append(':');
+    string().encode(context, tag);
+    return std::string(context.data(), context.size());
+  }
+
+  void save_variant(const std::string &tag, const std::shared_ptr<const variant_codec> &v) {
+    if (_tags.insert(tag)) {
+      _variant_list.push_back(std::make_pair(tag_prefix(_tag_field, tag), v));
+    }
+  }
+
+  using variant_vec = std::vector<std::pair<std::string, std::shared_ptr<const variant_codec>>>;
+
+  std::string _tag_field;
+  variant_vec _variant_list;  // in the order of the tags in _tags
+  detail::key_index _tags;
+};
+
+template <typename T>
+tagged_union_t<T> tagged_union(std::string tag_field) {
+  return tagged_union_t<T>(std::move(tag_field));
+}
+
+}  // namespace codec
+}  // namespace json
+}  // namespace spotify
@@ -20,6 +20,7 @@
 
 #include <spotify/json/decode_context.hpp>
 #include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
 #include <spotify/json/encode_context.hpp>
 
 namespace spotify {
@@ -136,6 +137,10 @@ class transform_t final {
     }
   }
 
+  unsigned first_tokens() const {
+    return detail::first_tokens(_inner_codec);
+  }
+
   void encode(encode_context &context, const object_type &value) const {
     _inner_codec.encode(context, _encode_transform(value));
   }
@@ -19,6 +19,8 @@
 #include <tuple>
 #include <utility>
 
+#include <spotify/json/detail/decode_helpers.hpp>
+
 namespace spotify {
 namespace json {
 namespace detail {
@@ -33,12 +35,17 @@ struct tuple_field final {
       decode_context &context,
       T &object) {
     if (element_idx != 0) {
-      skip_1(context, ',');
+      if (json_unlikely(!skip_1(context, ','))) {
+        return;
+      }
       skip_any_whitespace(context);
     }
 
     const auto &codec = std::get<element_idx>(codecs);
     std::get<element_idx>(object) = codec.decode(context);
+    if (json_unlikely(context.has_failed())) {
+      return;
+    }
     skip_any_whitespace(context);
     tuple_field<T, remaining_count - 1, codecs_type...>::decode(codecs, context, object);
   }
@@ -78,7 +85,9 @@ class tuple_t final {
 
   object_type decode(decode_context &context) const {
     object_type output;
-    detail::skip_1(context, '[');
+    if (json_unlikely(!detail::skip_1(context, '['))) {
+      return output;
+    }
     detail::skip_any_whitespace(context);
     detail::tuple_field<object_type, element_count, codecs_type...>::decode(
         _codecs, context, output);
@@ -86,6 +95,10 @@ class tuple_t final {
     return output;
   }
 
+  unsigned first_tokens() const {
+    return detail::token_array;
+  }
+
   void encode(encode_context &context, const object_type &object) const {
     context.append('[');
     detail::tuple_field<object_type, element_count, codecs_type...>::encode(
@@ -17,11 +17,17 @@
 #pragma once
 
 #include <cstring>
+#include <string>
+#include <utility>
 
 #include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_error.hpp>
+#include <spotify/json/decode_exception.hpp>
 #include <spotify/json/default_codec.hpp>
 #include <spotify/json/detail/decode_helpers.hpp>
 #include <spotify/json/detail/macros.hpp>
+#include <spotify/json/mapped_file.hpp>
+#include <spotify/json/padded_string.hpp>
 
 namespace spotify {
 namespace json {
@@ -30,16 +36,25 @@ namespace json {
  * json::decode(codec, data...)
  */
 
+namespace detail {
+
 template <typename codec_type>
-typename codec_type::object_type decode(const codec_type &codec, const char *data, size_t size) {
-  decode_context c(data, data + size);
+typename codec_type::object_type decode_document(const codec_type &codec, decode_context &c) {
   detail::skip_any_whitespace(c);
   const auto result = codec.decode(c);
   detail::skip_any_whitespace(c);
-  detail::fail_if(c, c.position != c.end, "Unexpected trailing input");
+  detail::fail_if(c, c.position != c.end, decode_error::unexpected_trailing_input);
   return result;
 }
 
+}  // namespace detail
+
+template <typename codec_type>
+typename codec_type::object_type decode(const codec_type &codec, const char *data, size_t size) {
+  decode_context c(data, data + size);
+  return detail::decode_document(codec, c);
+}
+
 template <typename codec_type>
 typename codec_type::object_type decode(const codec_type &codec, const char *cstr) {
   return decode(codec, cstr, cstr ? std::strlen(cstr) : 0);
@@ -50,43 +65,184 @@ typename codec_type::object_type decode(const codec_type &codec, const string_ty
   return decode(codec, string.data(), string.size());
 }
 
+/*
+ * json::decode_padded(codec, data, size)
+ *
+ * Like json::decode, but for input that is followed by at least decode_padding
+ * readable bytes, see decode_context::padded_input.
+ */
+
+template <typename codec_type>
+typename codec_type::object_type decode_padded(const codec_type &codec, const char *data, size_t size) {
+  decode_context c(data, data + size, decode_context::padded_input());
+  return detail::decode_document(codec, c);
+}
+
+template <typename codec_type>
+typename codec_type::object_type decode(const codec_type &codec, const padded_string &string) {
+  return decode_padded(codec, string.data(), string.size());
+}
+
+template <typename codec_type>
+typename codec_type::object_type decode(const codec_type &codec, const mapped_file &file) {
+  return decode_padded(codec, file.data(), file.size());
+}
+
+/*
+ * json::decode_strict_utf8(codec, data...)
+ *
+ * Like json::decode, but rejects strings that are not valid UTF-8 and \u
+ * escape sequences with unpaired surrogates, see decode_context::strict_utf8.
+ */
+
+template <typename codec_type>
+typename codec_type::object_type decode_strict_utf8(const codec_type &codec, const char *data, size_t size) {
+  decode_context c(data, data + size);
+  c.strict_utf8 = true;
+  return detail::decode_document(codec, c);
+}
+
+template <typename codec_type, typename string_type>
+typename codec_type::object_type decode_strict_utf8(const codec_type &codec, const string_type &string) {
+  return decode_strict_utf8(codec, string.data(), string.size());
+}
+
+/*
+ * json::decode_file(codec, path)
+ *
+ * Decode the JSON file at path in place, without reading it into a string
+ * first, see mapped_file.
+ *
+ * @throws std::system_error if the file cannot be opened or mapped.
+ */
+
+template <typename codec_type>
+typename codec_type::object_type decode_file(const codec_type &codec, const std::string &path) {
+  return decode(codec, mapped_file(path));
+}
+
 /*
  * json::decode(data...)
  */
 
 template <typename value_type>
 value_type decode(const char *data, size_t size) {
-  return decode(default_codec<value_type>(), data, size);
+  return decode(cached_default_codec<value_type>(), data, size);
 }
 
 template <typename value_type>
 value_type decode(const char *cstr) {
-  return decode(default_codec<value_type>(), cstr);
+  return decode(cached_default_codec<value_type>(), cstr);
 }
 
 template <typename value_type, typename string_type>
 value_type decode(const string_type &string) {
-  return decode(default_codec<value_type>(), string);
+  return decode(cached_default_codec<value_type>(), string);
+}
+
+template <typename value_type>
+value_type decode_file(const std::string &path) {
+  return decode_file(cached_default_codec<value_type>(), path);
 }
 
 /*
- * json::try_decode(&object, codec, data...)
+ * json::try_decode(&object, codec, data..., &error)
+ *
+ * Like json::decode, but returns false and sets error to the reason that
+ * decoding failed instead of throwing. The codecs of this library record the
+ * error in the decode_context and return early, see decode_context::error, so
+ * rejecting input costs about as much as accepting it, and the input is only
+ * parsed once. Exceptions from other codecs and transform functions are
+ * caught and reported with their message. object is left untouched on error.
  */
 
+namespace detail {
+
 template <typename codec_type>
-bool try_decode(
+bool try_decode_document(
     typename codec_type::object_type &object,
     const codec_type &codec,
-    const char *data,
-    size_t size) noexcept {
+    decode_context &c,
+    decode_error &error) noexcept {
+  error = decode_error();
+  c.error = &error;
   try {
-    object = decode(codec, data, size);
+    detail::skip_any_whitespace(c);
+    auto result = codec.decode(c);
+    if (json_unlikely(c.has_failed())) {
+      return false;
+    }
+
+    detail::skip_any_whitespace(c);
+    if (json_unlikely(c.position != c.end)) {
+      detail::fail(c, decode_error::unexpected_trailing_input);
+      return false;
+    }
+
+    object = std::move(result);
     return true;
+  } catch (const decode_exception &exception) {
+    if (!error) {
+      error = decode_error(exception);
+    }
+    return false;
   } catch (...) {
+    if (!error) {
+      error = decode_error(decode_error::rejected_by_codec, 0);
+    }
     return false;
   }
 }
 
+}  // namespace detail
+
+template <typename codec_type>
+bool try_decode(
+    typename codec_type::object_type &object,
+    const codec_type &codec,
+    const char *data,
+    size_t size,
+    decode_error &error) noexcept {
+  decode_context c(data, size);
+  return detail::try_decode_document(object, codec, c, error);
+}
+
+template <typename codec_type>
+bool try_decode(
+    typename codec_type::object_type &object,
+    const codec_type &codec,
+    const padded_string &string,
+    decode_error &error) noexcept {
+  decode_context c(string.data(), string.size(), decode_context::padded_input());
+  return detail::try_decode_document(object, codec, c, error);
+}
+
+template <typename codec_type, typename string_type>
+bool try_decode(
+    typename codec_type::object_type &object,
+    const codec_type &codec,
+    const string_type &string,
+    decode_error &error) noexcept {
+  return try_decode(object, codec, string.data(), string.size(), error);
+}
+
+/*
+ * json::try_decode(&object, codec, data...)
+ *
+ * Like json::try_decode with a decode_error, for when the reason does not
+ * matter.
+ */
+
+template <typename codec_type>
+bool try_decode(
+    typename codec_type::object_type &object,
+    const codec_type &codec,
+    const char *data,
+    size_t size) noexcept {
+  decode_error error;
+  return try_decode(object, codec, data, size, error);
+}
+
 template <typename codec_type>
 bool try_decode(
     typename codec_type::object_type &object,
@@ -100,7 +256,8 @@ bool try_decode(
     typename codec_type::object_type &object,
     const codec_type &codec,
     const string_type &string) noexcept {
-  return try_decode(object, codec, string.data(), string.size());
+  decode_error error;
+  return try_decode(object, codec, string, error);
 }
 
 /*
@@ -109,17 +266,27 @@ bool try_decode(
 
 template <typename value_type>
 bool try_decode(value_type &object, const char *data, size_t size) noexcept {
-  return try_decode(object, default_codec<value_type>(), data, size);
+  return try_decode(object, cached_default_codec<value_type>(), data, size);
 }
 
 template <typename value_type>
 bool try_decode(value_type &object, const char *cstr) noexcept {
-  return try_decode(object, default_codec<value_type>(), cstr);
+  return try_decode(object, cached_default_codec<value_type>(), cstr);
 }
 
 template <typename value_type, typename string_type>
 bool try_decode(value_type &object, const string_type &string) noexcept {
-  return try_decode(object, default_codec<value_type>(), string);
+  return try_decode(object, cached_default_codec<value_type>(), string);
+}
+
+template <typename value_type>
+bool try_decode(value_type &object, const char *data, size_t size, decode_error &error) noexcept {
+  return try_decode(object, cached_default_codec<value_type>(), data, size, error);
+}
+
+template <typename value_type, typename string_type>
+bool try_decode(value_type &object, const string_type &string, decode_error &error) noexcept {
+  return try_decode(object, cached_default_codec<value_type>(), string, error);
 }
 
 }  // namespace json
@@ -18,30 +18,64 @@
 
 #include <cstddef>
 
+#include <spotify/json/decode_error.hpp>
 #include <spotify/json/decode_exception.hpp>
-#include <spotify/json/detail/cpuid.hpp>
 #include <spotify/json/detail/macros.hpp>
 
 namespace spotify {
 namespace json {
 
+/**
+ * The number of bytes after the end of padded input that must be readable, see
+ * decode_context::padded_input. Their values do not matter.
+ */
+constexpr size_t decode_padding = 64;
+
 /**
  * A decode_context has the information that is kept while decoding JSON with
  * codecs. It has information about the data to read and whether the decoding
  * has failed.
  */
 struct decode_context final {
+  /**
+   * Tag for input that is followed by at least decode_padding readable bytes,
+   * for example the contents of a padded_string. The SIMD kernels then read
+   * whole chunks past the end of the input instead of handling the first and
+   * last bytes one at a time. The bytes past the end are never decoded.
+   */
+  struct padded_input {};
+
   decode_context(const char *begin, const char *end)
-      : has_sse42(detail::cpuid().has_sse42()),
-        position(begin),
+      : position(begin),
         begin(begin),
-        end(end) {}
+        end(end),
+        padded(false),
+        strict_utf8(false),
+        error(nullptr) {}
 
   decode_context(const char *data, size_t size)
-      : has_sse42(detail::cpuid().has_sse42()),
-        position(data),
+      : position(data),
+        begin(data),
+        end(data + size),
+        padded(false),
+        strict_utf8(false),
+        error(nullptr) {}
+
+  decode_context(const char *begin, const char *end, const padded_input &)
+      : position(begin),
+        begin(begin),
+        end(end),
+        padded(true),
+        strict_utf8(false),
+        error(nullptr) {}
+
+  decode_context(const char *data, size_t size, const padded_input &)
+      : position(data),
         begin(data),
-        end(data + size) {}
+        end(data + size),
+        padded(true),
+        strict_utf8(false),
+        error(nullptr) {}
 
   json_force_inline size_t offset() const {
     return (position - begin);
@@ -55,10 +89,37 @@ struct decode_context final {
     return (end - position);
   }
 
-  const bool has_sse42;
+  /**
+   * True if decoding has failed and the failure was recorded in error rather
+   * than thrown, see the error member.
+   */
+  json_force_inline bool has_failed() const {
+    return (json_unlikely(error != nullptr) && json_unlikely(bool(*error)));
+  }
+
   const char *position;
   const char *const begin;
   const char *const end;
+  const bool padded;
+
+  /**
+   * In strict UTF-8 mode, all strings that are decoded or skipped must be valid
+   * UTF-8, and \u escape sequences must not have unpaired surrogates, so that
+   * decoded strings are always valid UTF-8. Input that is not is rejected with
+   * a decode_exception. The validation is done while scanning for the end of
+   * each string, so it costs little extra for mostly ASCII input. It is off by
+   * default; set it before decoding to turn it on.
+   */
+  bool strict_utf8;
+
+  /**
+   * If error is set, codecs record the first error in it instead of throwing
+   * a decode_exception, and return early with an unspecified value. Codecs
+   * that decode several values, like arrays and objects, check has_failed()
+   * after each one and stop, so rejecting input costs about as much as
+   * accepting it. This is how try_decode reports errors; it is off by default.
+   */
+  decode_error *error;
 };
 
 }  // namespace json
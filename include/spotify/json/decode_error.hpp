@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+
+/**
+ * A decode_error describes why decoding failed, without throwing. It is only a
+ * code and an offset, so that reporting an error costs about as much as not
+ * having one. The message and the line and column are formatted on demand.
+ *
+ * Errors that are raised by codecs, for example when the JSON does not conform
+ * to the schema, have the code rejected_by_codec and keep their message. When
+ * the message is a string literal, which it is for the codecs of this library,
+ * only a pointer to it is kept.
+ */
+class decode_error final {
+ public:
+  enum code_type {
+    none = 0,
+    unexpected_end_of_input,
+    unexpected_input,
+    unexpected_trailing_input,
+    unexpected_token,
+    unterminated_string,
+    invalid_escape_character,
+    invalid_unicode_escape,
+    unpaired_surrogate,
+    invalid_utf8,
+    expected_digit,
+    expected_digit_after_decimal_point,
+    expected_digit_after_exponent_sign,
+    expected_quote,
+    expected_comma_or_closing_brace,
+    expected_comma_or_closing_bracket,
+    expected_closing_brace,
+    expected_closing_bracket,
+    unexpected_eof,
+    rejected_by_codec
+  };
+
+  decode_error()
+      : _code(none),
+        _token(0),
+        _offset(0) {}
+
+  decode_error(const code_type code, const size_t offset, const char token = 0)
+      : _code(code),
+        _token(token),
+        _offset(offset) {}
+
+  /**
+   * An error with the code rejected_by_codec and the given message, as
+   * recorded by codecs that decode without throwing, see decode_context::error.
+   * The message must outlive the error, like a string literal does, since only
+   * a pointer to it is kept.
+   */
+  decode_error(const char *message, const size_t offset)
+      : _code(rejected_by_codec),
+        _token(0),
+        _offset(offset),
+        _message(message) {}
+
+  /**
+   * Like above, but with a copy of the message.
+   */
+  decode_error(const std::string &message, const size_t offset)
+      : _code(rejected_by_codec),
+        _token(0),
+        _offset(offset),
+        _message_copy(message) {}
+
+  explicit decode_error(const decode_exception &exception)
+      : decode_error(std::string(exception.what()), exception.offset()) {}
+
+  explicit operator bool() const {
+    return (_code != none);
+  }
+
+  code_type code() const {
+    return _code;
+  }
+
+  /**
+   * The offending character, for unexpected_token. It is '\0' if the input
+   * ended where a value was expected.
+   */
+  char token() const {
+    return _token;
+  }
+
+  size_t offset() const {
+    return _offset;
+  }
+
+  /**
+   * The same message as the decode_exception that decode() throws for the
+   * error, for example "Unterminated string".
+   */
+  std::string message() const;
+
+  /**
+   * The 1-based line and column of the error, given the input that was decoded.
+   * Lines are separated by '\n' and columns are counted in bytes.
+   */
+  size_t line(const char *data) const;
+  size_t column(const char *data) const;
+
+  /**
+   * Throw the decode_exception that decode() throws for the error.
+   */
+  json_noreturn void raise() const;
+
+ private:
+  code_type _code;
+  char _token;
+  size_t _offset;
+  const char *_message = nullptr;
+  std::string _message_copy;  // when there is no _message
+};
+
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <spotify/json/decode.hpp>
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_error.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/parallel_for.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+
+namespace spotify {
+namespace json {
+
+/**
+ * A line of JSON Lines input that could not be decoded.
+ */
+struct line_error {
+  line_error(std::size_t line, std::size_t offset, std::string what)
+      : line(line),
+        offset(offset),
+        what(std::move(what)) {}
+
+  std::size_t line;    // 1 for the first line
+  std::size_t offset;  // from the beginning of the line, like decode_error::offset
+  std::string what;
+};
+
+/**
+ * The result of json::decode_lines. values has the decoded value of every
+ * non-blank line that could be decoded, in input order. errors has the lines
+ * that could not be decoded, also in input order.
+ */
+template <typename object_type>
+struct decoded_lines {
+  std::vector<object_type> values;
+  std::vector<line_error> errors;
+};
+
+namespace detail {
+
+/**
+ * Input is split into batches of about this many bytes, so that threads that
+ * finish early can pick up more work, but each batch is still large enough
+ * that handing it out is cheap in comparison to decoding it.
+ */
+constexpr std::size_t decode_lines_batch_size = 256 * 1024;
+
+json_force_inline const char *find_line_end(const char *begin, const char *end) {
+  const auto newline = std::memchr(begin, '\n', end - begin);
+  return (newline ? static_cast<const char *>(newline) : end);
+}
+
+/**
+ * The start of the first line that begins at or after position.
+ */
+json_force_inline const char *find_line_start(const char *begin, const char *position, const char *end) {
+  if (position == begin || position[-1] == '\n') {
+    return position;
+  }
+
+  const auto line_end = find_line_end(position, end);
+  return (line_end == end ? end : line_end + 1);
+}
+
+template <typename object_type>
+struct decode_lines_batch {
+  decode_lines_batch() : num_lines(0) {}
+
+  std::vector<object_type> values;
+  std::vector<line_error> errors;  // with line numbers relative to the batch
+  std::size_t num_lines;
+};
+
+template <typename codec_type>
+void decode_lines_in_batch(
+    const codec_type &codec,
+    const char *begin,
+    const char *end,
+    decode_lines_batch<typename codec_type::object_type> &batch) {
+  decode_error error;
+  for (auto line = begin; line != end; batch.num_lines++) {
+    const auto line_end = find_line_end(line, end);
+
+    decode_context context(line, line_end);
+    skip_any_whitespace(context);
+    if (context.remaining()) {
+      batch.values.emplace_back();
+      if (json_unlikely(!try_decode_document(batch.values.back(), codec, context, error))) {
+        batch.values.pop_back();
+        batch.errors.emplace_back(batch.num_lines, error.offset(), error.message());
+      }
+    }
+
+    line = (line_end == end ? end : line_end + 1);
+  }
+}
+
+}  // namespace detail
+
+/*
+ * json::decode_lines(codec, data...)
+ *
+ * Decode JSON Lines (also known as newline delimited JSON) input, where each
+ * line is a separate JSON document. Lines are decoded in parallel on up to
+ * num_threads threads, or one per hardware thread if num_threads is 0. Blank
+ * lines are skipped. Lines that cannot be decoded are reported in the errors
+ * of the result, and do not stop the other lines from being decoded. Like
+ * json::try_decode, this does not throw for invalid lines, and object_type
+ * must be default constructible.
+ *
+ * The codec is shared between the threads, so its decode method must be safe
+ * to call concurrently. This is the case for all codecs in this library.
+ */
+
+template <typename codec_type>
+decoded_lines<typename codec_type::object_type> decode_lines(
+    const codec_type &codec,
+    const char *data,
+    size_t size,
+    size_t num_threads = 0) {
+  using object_type = typename codec_type::object_type;
+
+  const auto end = data + size;
+  const auto num_batches = size / detail::decode_lines_batch_size + 1;
+  std::vector<detail::decode_lines_batch<object_type>> batches(num_batches);
+  detail::parallel_for(
+      num_batches,
+      num_threads ? num_threads : detail::default_num_threads(),
+      [&](const std::size_t i) {
+        // Batches start at the first line that begins in their byte range,
+        // which every batch can find on its own.
+        const auto range_begin = data + i * detail::decode_lines_batch_size;
+        const auto range_end = (i + 1 == num_batches ? end : range_begin + detail::decode_lines_batch_size);
+        const auto begin = detail::find_line_start(data, range_begin, end);
+        const auto batch_end = (range_end == end ? end : detail::find_line_start(data, range_end, end));
+        detail::decode_lines_in_batch(codec, begin, batch_end, batches[i]);
+      });
+
+  decoded_lines<object_type> result;
+  std::size_t num_values = 0;
+  for (const auto &batch : batches) {
+    num_values += batch.values.size();
+  }
+
+  result.values.reserve(num_values);
+  std::size_t first_line = 1;
+  for (auto &batch : batches) {
+    std::move(batch.values.begin(), batch.values.end(), std::back_inserter(result.values));
+    for (auto &error : batch.errors) {
+      error.line += first_line;
+      result.errors.push_back(std::move(error));
+    }
+    first_line += batch.num_lines;
+  }
+
+  return result;
+}
+
+template <typename codec_type, typename string_type>
+decoded_lines<typename codec_type::object_type> decode_lines(
+    const codec_type &codec,
+    const string_type &string,
+    size_t num_threads = 0) {
+  return decode_lines(codec, string.data(), string.size(), num_threads);
+}
+
+template <typename value_type>
+decoded_lines<value_type> decode_lines(const char *data, size_t size, size_t num_threads = 0) {
+  return decode_lines(cached_default_codec<value_type>(), data, size, num_threads);
+}
+
+template <typename value_type, typename string_type>
+decoded_lines<value_type> decode_lines(const string_type &string, size_t num_threads = 0) {
+  return decode_lines(cached_default_codec<value_type>(), string.data(), string.size(), num_threads);
+}
+
+}  // namespace json
+}  // namespace spotify
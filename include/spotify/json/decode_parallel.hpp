@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/map.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/find_element_starts.hpp>
+#include <spotify/json/detail/parallel_for.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * Containers are split into slices of at least this many bytes, so that
+ * handing out a slice is cheap in comparison to decoding it.
+ */
+constexpr std::size_t decode_parallel_min_slice_size = 256 * 1024;
+
+/**
+ * The elements of the array or object in a document, split into slices at
+ * element boundaries. Slice i has the elements that begin in the range
+ * [starts[i], starts[i + 1]), and the last slice ends at end, which is the
+ * position of the closing bracket.
+ */
+struct container_slices {
+  std::vector<const char *> starts;
+  const char *end;
+};
+
+/**
+ * Find the slices of the array ('[', ']') or object ('{', '}') that the
+ * document [data, data + size) consists of, see find_element_starts. Throws
+ * a decode_exception if the document is not a container, but the error may
+ * not be the one that the codec would produce.
+ */
+inline container_slices find_container_slices(
+    const char *data,
+    const std::size_t size,
+    const char intro,
+    const char outro,
+    const std::size_t slice_size,
+    const std::size_t num_threads) {
+  decode_context context(data, size);
+  skip_any_whitespace(context);
+  skip_1(context, intro);
+  skip_any_whitespace(context);
+
+  // The closing bracket must be the last byte that is not whitespace.
+  auto end = context.end;
+  while (end != context.position && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\n' || end[-1] == '\r')) {
+    end--;
+  }
+  fail_if(context, end == context.position || end[-1] != outro, "Expected end of container");
+
+  container_slices slices;
+  slices.end = end - 1;
+  if (context.position != slices.end) {
+    slices.starts = find_element_starts(context.position, slices.end, slice_size, num_threads);
+  }
+  return slices;
+}
+
+/**
+ * Decode the elements of slice i with decode_element, with the same steps as
+ * decode_comma_separated. Throws a decode_exception if the codec does not end
+ * the elements where find_container_slices did.
+ */
+template <typename decode_function>
+void decode_container_slice(
+    const container_slices &slices,
+    const std::size_t i,
+    decode_context &context,
+    const decode_function &decode_element) {
+  const auto end = (i + 1 == slices.starts.size() ? slices.end : slices.starts[i + 1]);
+  context.position = slices.starts[i];
+
+  while (true) {
+    decode_element();
+    skip_any_whitespace(context);
+    if (context.position == slices.end) {
+      break;
+    }
+
+    skip_1(context, ',');
+    skip_any_whitespace(context);
+    if (context.position == end && end != slices.end) {
+      break;  // The next slice starts here
+    }
+  }
+
+  fail_if(context, context.position != end, decode_error::unexpected_input);
+}
+
+template <typename codec_type>
+struct parallel_decoder {
+  static typename codec_type::object_type decode(
+      const codec_type &codec,
+      const char *data,
+      const std::size_t size,
+      const std::size_t) {
+    return json::decode(codec, data, size);
+  }
+};
+
+/**
+ * Decodes each slice into a std::vector of elements, and then moves the
+ * elements into the output in order.
+ */
+template <typename container_type, typename element_type, typename decode_function, typename insert_function>
+container_type decode_container_parallel(
+    const char *data,
+    const std::size_t size,
+    const std::size_t num_threads,
+    const char intro,
+    const char outro,
+    const decode_function &decode_element,
+    const insert_function &insert) {
+  const auto slice_size = std::max(decode_parallel_min_slice_size, size / (8 * num_threads));
+  const auto slices = find_container_slices(data, size, intro, outro, slice_size, num_threads);
+
+  std::vector<std::vector<element_type>> elements(slices.starts.size());
+  parallel_for(elements.size(), num_threads, [&](const std::size_t i) {
+    decode_context slice_context(data, size);
+    decode_container_slice(slices, i, slice_context, [&]{
+      elements[i].push_back(decode_element(slice_context));
+    });
+  });
+
+  decode_context context(data, size);
+  container_type output;
+  for (auto &slice : elements) {
+    for (auto &element : slice) {
+      insert(context, output, std::move(element));
+    }
+    slice = std::vector<element_type>();
+  }
+  return output;
+}
+
+template <typename T, typename inner_codec_type>
+struct parallel_decoder<codec::array_t<T, inner_codec_type>> {
+  static T decode(
+      const codec::array_t<T, inner_codec_type> &codec,
+      const char *data,
+      const std::size_t size,
+      const std::size_t num_threads) {
+    using inserter = container_inserter<T>;
+    using element_type = typename inner_codec_type::object_type;
+
+    const auto &inner_codec = codec.inner_codec();
+    auto state = inserter::init_state;
+    auto output = decode_container_parallel<T, element_type>(
+        data, size, num_threads, '[', ']',
+        [&](decode_context &context) {
+          return inner_codec.decode(context);
+        },
+        [&](decode_context &context, T &container, element_type &&element) {
+          state = inserter::insert(context, state, container, std::move(element));
+        });
+
+    decode_context context(data, size);
+    inserter::validate(context, state, output);
+    return output;
+  }
+};
+
+template <typename T, typename inner_codec_type>
+struct parallel_decoder<codec::map_t<T, inner_codec_type>> {
+  static T decode(
+      const codec::map_t<T, inner_codec_type> &codec,
+      const char *data,
+      const std::size_t size,
+      const std::size_t num_threads) {
+    using element_type = std::pair<std::string, typename inner_codec_type::object_type>;
+
+    const auto &inner_codec = codec.inner_codec();
+    const codec::string_t key_codec;
+    return decode_container_parallel<T, element_type>(
+        data, size, num_threads, '{', '}',
+        [&](decode_context &context) {
+          auto key = key_codec.decode(context);
+          skip_any_whitespace(context);
+          skip_1(context, ':');
+          skip_any_whitespace(context);
+          return element_type(std::move(key), inner_codec.decode(context));
+        },
+        [](decode_context &, T &container, element_type &&element) {
+          container.insert(typename T::value_type(std::move(element.first), std::move(element.second)));
+        });
+  }
+};
+
+}  // namespace detail
+
+/*
+ * json::decode_parallel(codec, data...)
+ *
+ * Like json::decode, but documents that are one large array or map (decoded
+ * with an array_t or map_t codec) are split at element boundaries and decoded
+ * on up to num_threads threads, or one per hardware thread if num_threads is
+ * 0. Other documents are decoded like with json::decode.
+ *
+ * The element boundaries are found in parallel too, see find_element_starts.
+ * If the elements do not line up with them, or decoding any of the elements
+ * fails, the whole document is decoded again with json::decode, so that
+ * errors are reported exactly as json::decode would. The inner codec is
+ * shared between the threads, so its decode method must be safe to call
+ * concurrently, which is the case for all codecs in this library.
+ */
+
+template <typename codec_type>
+typename codec_type::object_type decode_parallel(
+    const codec_type &codec,
+    const char *data,
+    size_t size,
+    size_t num_threads = 0) {
+  const auto threads = (num_threads ? num_threads : detail::default_num_threads());
+  if (threads == 1) {
+    return decode(codec, data, size);
+  }
+
+  try {
+    return detail::parallel_decoder<codec_type>::decode(codec, data, size, threads);
+  } catch (const decode_exception &) {
+    return decode(codec, data, size);
+  }
+}
+
+template <typename codec_type, typename string_type>
+typename codec_type::object_type decode_parallel(
+    const codec_type &codec,
+    const string_type &string,
+    size_t num_threads = 0) {
+  return decode_parallel(codec, string.data(), string.size(), num_threads);
+}
+
+template <typename value_type>
+value_type decode_parallel(const char *data, size_t size, size_t num_threads = 0) {
+  return decode_parallel(cached_default_codec<value_type>(), data, size, num_threads);
+}
+
+template <typename value_type, typename string_type>
+value_type decode_parallel(const string_type &string, size_t num_threads = 0) {
+  return decode_parallel(cached_default_codec<value_type>(), string.data(), string.size(), num_threads);
+}
+
+}  // namespace json
+}  // namespace spotify
@@ -33,5 +33,18 @@ decltype(default_codec_t<T>::codec()) default_codec() {
   return default_codec_t<T>::codec();
 }
 
+/**
+ * A process-wide instance of default_codec<T>(), created the first time that
+ * it is asked for. This is what the convenience overloads of decode, encode
+ * and friends use, so that codecs that are expensive to set up, such as
+ * object_t codecs with many fields, are not rebuilt for every call. Creation
+ * is thread safe, and codecs are safe to use from many threads at once.
+ */
+template <typename T>
+const decltype(default_codec_t<T>::codec()) &cached_default_codec() {
+  static const decltype(default_codec_t<T>::codec()) codec = default_codec_t<T>::codec();
+  return codec;
+}
+
 }  // namespace json
 }  // namespace spotify
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * Index of the lowest set bit in a non-zero bit mask, as produced by the SIMD
+ * compare and movemask instructions. The result is undefined for zero.
+ */
+json_force_inline unsigned count_trailing_zeros(const uint32_t mask) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctz(mask));
+#endif  // defined(_MSC_VER)
+}
+
+json_force_inline unsigned count_trailing_zeros(const uint64_t mask) {
+#if defined(_MSC_VER) && defined(json_arch_x86_64)
+  unsigned long index;
+  _BitScanForward64(&index, mask);
+  return static_cast<unsigned>(index);
+#elif defined(_MSC_VER)
+  const auto lo = static_cast<uint32_t>(mask);
+  return (lo ? count_trailing_zeros(lo) : 32 + count_trailing_zeros(static_cast<uint32_t>(mask >> 32)));
+#else
+  return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif  // defined(_MSC_VER) && defined(json_arch_x86_64)
+}
+
+/**
+ * Number of zero bits above the highest set bit in a non-zero value. The
+ * result is undefined for zero.
+ */
+json_force_inline unsigned count_leading_zeros(const uint64_t value) {
+#if defined(_MSC_VER) && defined(json_arch_x86_64)
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return 63 - static_cast<unsigned>(index);
+#elif defined(_MSC_VER)
+  const auto hi = static_cast<uint32_t>(value >> 32);
+  unsigned long index;
+  _BitScanReverse(&index, hi ? hi : static_cast<uint32_t>(value));
+  return (hi ? 31 : 63) - static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_clzll(value));
+#endif  // defined(_MSC_VER) && defined(json_arch_x86_64)
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -20,6 +20,7 @@
 #include <cstdint>
 
 #if defined(_MSC_VER)
+#include <immintrin.h>
 #include <intrin.h>
 #endif
 
@@ -31,26 +32,51 @@ namespace detail {
 
 class cpuid {
  public:
-  cpuid() {
+  cpuid()
+      : _registers(),
+        _extended_registers(),
+        _xcr0(0) {
 #if defined(json_arch_x86)
-    const uint32_t cpuid_function(1);
-#if defined(_MSC_VER)
-    ::__cpuid(reinterpret_cast<int *>(_registers.data()), cpuid_function);
-#elif defined(__GNUC__)
-    __asm__ __volatile__ (
-        "cpuid ;\n"
-        : "=a" (_registers[cpu_register::eax]),
-          "=b" (_registers[cpu_register::ebx]),
-          "=c" (_registers[cpu_register::ecx]),
-          "=d" (_registers[cpu_register::edx])
-        : "a" (cpuid_function)
-        :);
-#endif  // defined(_MSC_VER)
+    std::array<uint32_t, 4> vendor_registers = {};
+    read_cpuid(vendor_registers, 0);
+    read_cpuid(_registers, 1);
+
+    // The extended feature flags (AVX2, AVX-512) live in leaf 7. That leaf is
+    // only valid if the CPU reports it as supported in leaf 0.
+    if (vendor_registers[cpu_register::eax] >= 7) {
+      read_cpuid(_extended_registers, 7);
+    }
+
+    // The CPU may support the AVX instructions without the operating system
+    // saving the wider registers on context switches, in which case they can
+    // not be used. This is reported by XCR0, which can be read with XGETBV
+    // when the OS has enabled it (OSXSAVE).
+    if (has_feature_bit(_registers, cpu_register::ecx, cpu_feature_bit::osxsave)) {
+      _xcr0 = read_xcr0();
+    }
 #endif  // defined(json_arch_x86)
   }
 
+  bool has_pclmulqdq() const {
+    return has_feature_bit(_registers, cpu_register::ecx, cpu_feature_bit::pclmulqdq);
+  }
+
   bool has_sse42() const {
-    return has_feature_bit(cpu_register::ecx, cpu_feature_bit::sse_42);
+    return has_feature_bit(_registers, cpu_register::ecx, cpu_feature_bit::sse_42);
+  }
+
+  bool has_avx2() const {
+    return
+        has_os_support(xcr0_bit::avx_state) &&
+        has_feature_bit(_registers, cpu_register::ecx, cpu_feature_bit::avx) &&
+        has_feature_bit(_extended_registers, cpu_register::ebx, cpu_feature_bit::avx2);
+  }
+
+  bool has_avx512bw() const {
+    return
+        has_os_support(xcr0_bit::avx512_state) &&
+        has_feature_bit(_extended_registers, cpu_register::ebx, cpu_feature_bit::avx512f) &&
+        has_feature_bit(_extended_registers, cpu_register::ebx, cpu_feature_bit::avx512bw);
   }
 
  private:
@@ -63,19 +89,76 @@ class cpuid {
     };
   };
 
+  /**
+   * Bit indices for leaf 1 (pclmulqdq, sse_42, osxsave, avx) and leaf 7 (avx2, avx512f,
+   * avx512bw). The leaf is implied by the register set that is tested.
+   */
   struct cpu_feature_bit {
     enum type {
+      pclmulqdq = 1,
       sse_42 = 20,
+      osxsave = 27,
+      avx = 28,
+      avx2 = 5,
+      avx512f = 16,
+      avx512bw = 30
+    };
+  };
+
+  struct xcr0_bit {
+    enum type : uint64_t {
+      avx_state = 0x06,  // XMM and YMM state
+      avx512_state = 0xE6  // XMM, YMM, opmask and upper ZMM state
     };
   };
 
-  bool has_feature_bit(
+  static void read_cpuid(std::array<uint32_t, 4> &registers, const uint32_t function) {
+#if defined(json_arch_x86) && defined(_MSC_VER)
+    ::__cpuidex(reinterpret_cast<int *>(registers.data()), function, 0);
+#elif defined(json_arch_x86) && defined(__GNUC__)
+    __asm__ __volatile__ (
+        "cpuid ;\n"
+        : "=a" (registers[cpu_register::eax]),
+          "=b" (registers[cpu_register::ebx]),
+          "=c" (registers[cpu_register::ecx]),
+          "=d" (registers[cpu_register::edx])
+        : "a" (function),
+          "c" (0)
+        :);
+#endif  // defined(json_arch_x86) && defined(_MSC_VER)
+  }
+
+  static uint64_t read_xcr0() {
+#if defined(json_arch_x86) && defined(_MSC_VER)
+    return _xgetbv(0);
+#elif defined(json_arch_x86) && defined(__GNUC__)
+    uint32_t eax, edx;
+    __asm__ __volatile__ (
+        "xgetbv ;\n"
+        : "=a" (eax),
+          "=d" (edx)
+        : "c" (0)
+        :);
+    return (uint64_t(edx) << 32) | eax;
+#else
+    return 0;
+#endif  // defined(json_arch_x86) && defined(_MSC_VER)
+  }
+
+  static bool has_feature_bit(
+      const std::array<uint32_t, 4> &registers,
       const cpu_register::type &reg,
-      const cpu_feature_bit::type &bit) const {
-    return (_registers[reg] & (1 << bit)) != 0;
+      const cpu_feature_bit::type &bit) {
+    return (registers[reg] & (1u << bit)) != 0;
+  }
+
+  bool has_os_support(const xcr0_bit::type &mask) const {
+    return (_xcr0 & mask) == mask;
   }
 
   std::array<uint32_t, 4> _registers;
+  std::array<uint32_t, 4> _extended_registers;
+  uint64_t _xcr0;
 };
 
 }  // namespace detail
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * Parse the number at the start of [begin, end) into the nearest float or
+ * double, and return the end of the number. Return nullptr if there is no
+ * number. Numbers with at most 19 significant digits are converted with the
+ * Clinger fast path or the Eisel-Lemire algorithm. Anything else, such as
+ * longer numbers or exponents beyond the range of the type, is handed to
+ * double-conversion, which is exact but slower.
+ */
+const char *decode_float(const char *begin, const char *end, float &value);
+const char *decode_float(const char *begin, const char *end, double &value);
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
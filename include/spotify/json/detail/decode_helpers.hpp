@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <cstring>
 #include <string>
+#include <type_traits>
 #include <unordered_set>
 #include <vector>
 
@@ -36,12 +37,26 @@ namespace spotify {
 namespace json {
 namespace detail {
 
+/**
+ * Throw a decode_exception, or record the error in context.error if it is set,
+ * see decode_context::error. In that case fail returns, and the caller must
+ * return early, without reading the input that it has failed to find. The
+ * error is either a decode_error code, for the errors that have one, or a
+ * message, which is only copied if it is not a string literal.
+ */
+void fail(const decode_context &context, decode_error::code_type code, ptrdiff_t d = 0);
+
 template <typename string_type>
-json_never_inline json_noreturn void fail(
+json_never_inline void fail(
     const decode_context &context,
     const string_type &error,
     const ptrdiff_t d = 0) {
-  throw decode_exception(error, context.offset(d));
+  if (json_likely(!context.error)) {
+    throw decode_exception(error, context.offset(d));
+  }
+  if (!*context.error) {
+    *context.error = decode_error(error, context.offset(d));
+  }
 }
 
 template <typename string_type, typename condition_type>
@@ -55,16 +70,24 @@ json_force_inline void fail_if(
   }
 }
 
+/**
+ * Fail unless there are at least num_required_bytes left. Returns false if it
+ * failed without throwing, see fail.
+ */
 template <size_t num_required_bytes, typename string_type>
-json_force_inline void require_bytes(
+json_force_inline bool require_bytes(
     const decode_context &context,
-    const string_type &error = "Unexpected end of input") {
-  fail_if(context, context.remaining() < num_required_bytes, error);
+    const string_type &error = decode_error::unexpected_end_of_input) {
+  if (json_unlikely(context.remaining() < num_required_bytes)) {
+    fail(context, error);
+    return false;
+  }
+  return true;
 }
 
 template <size_t num_required_bytes>
-json_force_inline void require_bytes(const decode_context &context) {
-  require_bytes<num_required_bytes>(context, "Unexpected end of input");
+json_force_inline bool require_bytes(const decode_context &context) {
+  return require_bytes<num_required_bytes>(context, decode_error::unexpected_end_of_input);
 }
 
 json_force_inline char peek_unchecked(const decode_context &context) {
@@ -85,14 +108,17 @@ json_force_inline char next_unchecked(decode_context &context) {
   return *(context.position++);
 }
 
+/**
+ * Read the current character and skip past it. At the end of the input, this
+ * fails, and returns '\0' if it does so without throwing.
+ */
 template <typename string_type>
 json_force_inline char next(decode_context &context, const string_type &error) {
-  require_bytes<1>(context, error);
-  return next_unchecked(context);
+  return (require_bytes<1>(context, error) ? next_unchecked(context) : 0);
 }
 
 json_force_inline char next(decode_context &context) {
-  return next(context, "Unexpected end of input");
+  return next(context, decode_error::unexpected_end_of_input);
 }
 
 json_force_inline void skip_unchecked_1(decode_context &context) {
@@ -104,32 +130,50 @@ json_force_inline void skip_unchecked_n(decode_context &context, const size_t nu
 }
 
 json_force_inline void skip_any_n(decode_context &context, const size_t num_bytes) {
-  fail_if(context, context.remaining() < num_bytes, "Unexpected end of input");
+  if (json_unlikely(context.remaining() < num_bytes)) {
+    return fail(context, decode_error::unexpected_end_of_input);
+  }
   skip_unchecked_n(context, num_bytes);
 }
 
 json_force_inline void skip_any_1(decode_context &context) {
-  require_bytes<1>(context, "Unexpected end of input");
-  context.position++;
+  if (json_likely(require_bytes<1>(context, decode_error::unexpected_end_of_input))) {
+    context.position++;
+  }
 }
 
 /**
  * Skip past a specific character. If the context position does not point to a
- * matching character, a decode_exception is thrown.
+ * matching character, a decode_exception is thrown. Returns false if it failed
+ * without throwing, see fail.
  */
-json_force_inline void skip_1(decode_context &context, char character) {
-  fail_if(context, next(context) != character, "Unexpected input", -1);
+json_force_inline bool skip_1(decode_context &context, char character) {
+  if (json_unlikely(!require_bytes<1>(context))) {
+    return false;
+  }
+  if (json_unlikely(next_unchecked(context) != character)) {
+    fail(context, decode_error::unexpected_input, -1);
+    return false;
+  }
+  return true;
 }
 
 /**
  * Skip past four specific characters. If the context position does not point to
  * matching characters, a decode_exception is thrown. 'characters' must be a C
  * string of at least length 4. Only the first four characters will be read.
+ * Returns false if it failed without throwing, see fail.
  */
-json_force_inline void skip_4(decode_context &context, const char characters[4]) {
-  require_bytes<4>(context);
-  fail_if(context, memcmp(characters, context.position, 4), "Unexpected input");
+json_force_inline bool skip_4(decode_context &context, const char characters[4]) {
+  if (json_unlikely(!require_bytes<4>(context))) {
+    return false;
+  }
+  if (json_unlikely(memcmp(characters, context.position, 4))) {
+    fail(context, decode_error::unexpected_input);
+    return false;
+  }
   context.position += 4;
+  return true;
 }
 
 /**
@@ -140,7 +184,8 @@ json_force_inline void skip_4(decode_context &context, const char characters[4])
  * after that element or mark the context as failed.
  *
  * The parse callback must mark the context as failed if it sees a premature end
- * of input, otherwise this function might enter an infinite loop!
+ * of input, otherwise this function might enter an infinite loop! It stops at
+ * the first element that fails without throwing.
  *
  * context.has_failed() must be false when this function is called.
  */
@@ -148,12 +193,18 @@ template <typename parse_function>
 json_never_inline void decode_comma_separated(decode_context &context, char intro, char outro, parse_function parse) {
   skip_1(context, intro);
   skip_any_whitespace(context);
+  if (json_unlikely(context.has_failed())) {
+    return;
+  }
 
   if (json_likely(peek(context) != outro)) {
     parse();
     skip_any_whitespace(context);
 
     while (json_likely(peek(context) != outro)) {
+      if (json_unlikely(context.has_failed())) {
+        return;
+      }
       skip_1(context, ',');
       skip_any_whitespace(context);
       parse();
@@ -176,23 +227,113 @@ json_force_inline void decode_object(decode_context &context, const callback_fun
   decode_comma_separated(context, '{', '}', [&]{
     auto key = codec.decode(context);
     skip_any_whitespace(context);
-    skip_1(context, ':');
-    skip_any_whitespace(context);
-    callback(std::move(key));
+    if (json_likely(skip_1(context, ':'))) {
+      skip_any_whitespace(context);
+      callback(std::move(key));
+    }
   });
 }
 
-json_force_inline void skip_true(decode_context &context) {
-  skip_4(context, "true");
+/**
+ * The kinds of JSON values, as bits, so that a set of them fits in an unsigned.
+ * A codec can have a method 'unsigned first_tokens() const' that returns the
+ * kinds of values that it is able to decode, which one_of_t uses to only try
+ * the codecs that might succeed. Codecs without it are assumed to accept any
+ * kind of value (token_any).
+ */
+enum token_kind : unsigned {
+  token_string = 1 << 0,
+  token_number = 1 << 1,
+  token_object = 1 << 2,
+  token_array = 1 << 3,
+  token_boolean = 1 << 4,
+  token_null = 1 << 5,
+  token_any = (1 << 6) - 1
+};
+
+/**
+ * The kind of value that starts with the character c. Anything that cannot
+ * start a valid value (including the '\0' that peek returns at the end of the
+ * input) is token_any, so that all codecs get the chance to report the error.
+ */
+json_force_inline unsigned token_kind_of(const char c) {
+  switch (c) {
+    case '"': return token_string;
+    case '{': return token_object;
+    case '[': return token_array;
+    case 't': return token_boolean;
+    case 'f': return token_boolean;
+    case 'n': return token_null;
+    case '-': case '+': case '.':  // fallthrough
+    case '0': case '1': case '2': case '3': case '4':  // fallthrough
+    case '5': case '6': case '7': case '8': case '9': return token_number;
+    default: return token_any;
+  }
+}
+
+template <typename T>
+struct has_first_tokens_method {
+  template <typename U>
+  static auto test(int) -> decltype(
+      std::declval<const U>().first_tokens(),
+      std::true_type());
+
+  template <typename>
+  static std::false_type test(...);
+
+ public:
+  static constexpr bool value = std::is_same<decltype(test<T>(0)), std::true_type>::value;
+};
+
+template <typename codec_type>
+typename std::enable_if<!has_first_tokens_method<codec_type>::value, unsigned>::type
+json_force_inline first_tokens(const codec_type &codec) {
+  return token_any;
+}
+
+template <typename codec_type>
+typename std::enable_if<has_first_tokens_method<codec_type>::value, unsigned>::type
+json_force_inline first_tokens(const codec_type &codec) {
+  return codec.first_tokens();
+}
+
+/**
+ * Codecs for objects can be decoded one member at a time, by chunked_decoder
+ * and tagged_union_t, if they have these methods, like object_t and map_t:
+ *
+ *   partial_object begin_partial_decode() const;
+ *   void decode_partial_field(decode_context &, partial_object &, const char *key, size_t key_size) const;
+ *   void end_partial_decode(const decode_context &, const partial_object &) const;
+ *
+ * where partial_object has an 'object' member with the decoded object.
+ */
+template <typename T>
+struct has_partial_decode_methods {
+  template <typename U>
+  static auto test(int) -> decltype(
+      std::declval<const U>().end_partial_decode(
+          std::declval<const decode_context &>(),
+          std::declval<const U>().begin_partial_decode()),
+      std::true_type());
+
+  template <typename>
+  static std::false_type test(...);
+
+ public:
+  static constexpr bool value = std::is_same<decltype(test<T>(0)), std::true_type>::value;
+};
+
+json_force_inline bool skip_true(decode_context &context) {
+  return skip_4(context, "true");
 }
 
-json_force_inline void skip_false(decode_context &context) {
+json_force_inline bool skip_false(decode_context &context) {
   context.position++;  // skip past the 'f' in 'false', we know it is there
-  skip_4(context, "alse");
+  return skip_4(context, "alse");
 }
 
-json_force_inline void skip_null(decode_context &context) {
-  skip_4(context, "null");
+json_force_inline bool skip_null(decode_context &context) {
+  return skip_4(context, "null");
 }
 
 }  // namespace detail
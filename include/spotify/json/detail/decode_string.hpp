@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
 
 #include <spotify/json/detail/decode_helpers.hpp>
 #include <spotify/json/detail/macros.hpp>
@@ -29,6 +31,12 @@ namespace detail {
 
 std::uint8_t decode_hex_nibble(decode_context &context, const char c);
 
+/**
+ * Validate the rest of a string whose first backslash has just been read, and
+ * skip past its closing quote, without unescaping it anywhere.
+ */
+void skip_escaped_string(decode_context &context);
+
 template <typename string_type>
 void encode_utf8_1(string_type &out, unsigned p) {
   const char c0 = (p & 0x7F);
@@ -52,31 +60,79 @@ void encode_utf8_3(string_type &out, unsigned p) {
   out.append(&cc[0], 3);
 }
 
+template <typename string_type>
+void encode_utf8_4(string_type &out, unsigned p) {
+  const char c0 = 0xF0 | ((p >> 18) & 0x07);
+  const char c1 = 0x80 | ((p >> 12) & 0x3F);
+  const char c2 = 0x80 | ((p >>  6) & 0x3F);
+  const char c3 = 0x80 | ((p >>  0) & 0x3F);
+  const char cc[] = { c0, c1, c2, c3 };
+  out.append(&cc[0], 4);
+}
+
 template <typename string_type>
 void encode_utf8(decode_context &context, string_type &out, unsigned p) {
   if (json_likely(p <= 0x7F)) {
     encode_utf8_1(out, p);
   } else if (json_likely(p <= 0x07FF)) {
     encode_utf8_2(out, p);
-  } else {
+  } else if (json_likely(p <= 0xFFFF)) {
     encode_utf8_3(out, p);
+  } else {
+    encode_utf8_4(out, p);
   }
 }
 
-template <typename string_type>
-void decode_unicode_escape_sequence(decode_context &context, string_type &out) {
-  detail::require_bytes<4>(context, "\\u must be followed by 4 hex digits");
+json_force_inline unsigned decode_code_unit(decode_context &context) {
+  if (json_unlikely(!detail::require_bytes<4>(context, decode_error::invalid_unicode_escape))) {
+    return 0;
+  }
   const auto a = decode_hex_nibble(context, *(context.position++));
   const auto b = decode_hex_nibble(context, *(context.position++));
   const auto c = decode_hex_nibble(context, *(context.position++));
   const auto d = decode_hex_nibble(context, *(context.position++));
-  const auto p = unsigned((a << 12) | (b << 8) | (c << 4) | d);
-  encode_utf8(context, out, p);
+  return unsigned((a << 12) | (b << 8) | (c << 4) | d);
+}
+
+/**
+ * Combine the high surrogate that was just decoded with the escaped low
+ * surrogate after it into one code point. Surrogates that are not part of
+ * such a pair are rejected in strict UTF-8 mode, and otherwise encoded on
+ * their own, like any other code unit.
+ */
+template <typename string_type>
+json_never_inline void decode_surrogate_pair(decode_context &context, string_type &out, unsigned high) {
+  if (high <= 0xDBFF &&
+      context.remaining() >= 6 &&
+      context.position[0] == '\\' &&
+      context.position[1] == 'u') {
+    const auto original_position = context.position;
+    context.position += 2;
+    const auto low = decode_code_unit(context);
+    if (low >= 0xDC00 && low <= 0xDFFF) {
+      encode_utf8_4(out, 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00));
+      return;
+    }
+    context.position = original_position;
+  }
+
+  detail::fail_if(context, context.strict_utf8, decode_error::unpaired_surrogate, -6);
+  encode_utf8_3(out, high);
+}
+
+template <typename string_type>
+void decode_unicode_escape_sequence(decode_context &context, string_type &out) {
+  const auto p = decode_code_unit(context);
+  if (json_unlikely(p >= 0xD800 && p <= 0xDFFF)) {
+    decode_surrogate_pair(context, out, p);
+  } else {
+    encode_utf8(context, out, p);
+  }
 }
 
 template <typename string_type>
 void decode_escape_sequence(decode_context &context, string_type &out) {
-  const auto escape_character = detail::next(context, "Unterminated string");
+  const auto escape_character = detail::next(context, decode_error::unterminated_string);
   switch (escape_character) {
     case '"':  out.push_back('"');  break;
     case '/':  out.push_back('/');  break;
@@ -87,13 +143,16 @@ void decode_escape_sequence(decode_context &context, string_type &out) {
     case 't':  out.push_back('\t'); break;
     case '\\': out.push_back('\\'); break;
     case 'u': decode_unicode_escape_sequence(context, out); break;
-    default: detail::fail(context, "Invalid escape character", -1);
+    default: detail::fail(context, decode_error::invalid_escape_character, -1);
   }
 }
 
+/**
+ * Append the rest of a string whose first backslash has just been read to
+ * unescaped, one escape sequence at a time, and skip past its closing quote.
+ */
 template <typename string_type>
-json_never_inline string_type decode_escaped_string(decode_context &context, const char *begin) {
-  string_type unescaped(begin, context.position - 1);
+json_never_inline void decode_escape_sequences(decode_context &context, string_type &unescaped) {
   decode_escape_sequence(context, unescaped);
 
   while (json_likely(context.remaining())) {
@@ -101,30 +160,90 @@ json_never_inline string_type decode_escaped_string(decode_context &context, con
     detail::skip_any_simple_characters(context);
     unescaped.append(begin_simple, context.position);
 
-    switch (detail::next(context, "Unterminated string")) {
-      case '"': return unescaped;
+    switch (detail::next(context, decode_error::unterminated_string)) {
+      case '"': return;
       case '\\': decode_escape_sequence(context, unescaped); break;
-      default: json_unreachable();
+      default: return;  // failed without throwing
     }
   }
 
-  detail::fail(context, "Unterminated string");
+  detail::fail(context, decode_error::unterminated_string);
+}
+
+template <typename string_type>
+json_never_inline string_type decode_escaped_string(decode_context &context, const char *begin) {
+  string_type unescaped(begin, context.position - 1);
+  decode_escape_sequences(context, unescaped);
+  return unescaped;
 }
 
+/**
+ * std::strings, which is what almost all strings are decoded into, are
+ * unescaped with the try_unescape kernel instead.
+ */
+template <>
+std::string decode_escaped_string<std::string>(decode_context &context, const char *begin);
+
 template <typename string_type>
 json_force_inline string_type decode_string(decode_context &context) {
-  detail::skip_1(context, '"');
+  if (json_unlikely(!detail::skip_1(context, '"'))) {
+    return string_type();
+  }
 
   const auto begin_simple = context.position;
   detail::skip_any_simple_characters(context);
 
-  switch (detail::next(context, "Unterminated string")) {
+  switch (detail::next(context, decode_error::unterminated_string)) {
     case '"': return string_type(begin_simple, context.position - 1);
     case '\\': return decode_escaped_string<string_type>(context, begin_simple);
-    default: json_unreachable();
+    default: return string_type();  // failed without throwing
   }
 }
 
+/**
+ * Decode the key of an object member and call callback(const char *key,
+ * size_t size) with it unescaped. Keys without escape sequences, which is
+ * nearly all of them, are passed as the range they occupy in the input, so
+ * that no string is allocated for them. The callback is not called if the key
+ * fails to decode without throwing.
+ */
+template <typename callback_function>
+json_force_inline void decode_raw_key(decode_context &context, const callback_function &callback) {
+  if (json_unlikely(!skip_1(context, '"'))) {
+    return;
+  }
+
+  const auto begin_simple = context.position;
+  skip_any_simple_characters(context);
+
+  switch (next(context, decode_error::unterminated_string)) {
+    case '"': return callback(begin_simple, static_cast<std::size_t>(context.position - 1 - begin_simple));
+    case '\\': {
+      const auto key = decode_escaped_string<std::string>(context, begin_simple);
+      return callback(key.data(), key.size());
+    }
+    default: return;  // failed without throwing
+  }
+}
+
+/**
+ * Like decode_object, but calls callback(const char *key, size_t size) with
+ * the unescaped key from decode_raw_key rather than a decoded string. The key
+ * is only valid until the callback starts decoding the value.
+ */
+template <typename callback_function>
+json_force_inline void decode_object_raw_keys(decode_context &context, const callback_function &callback) {
+  decode_comma_separated(context, '{', '}', [&]{
+    decode_raw_key(context, [&](const char *key, const std::size_t size) {
+      skip_any_whitespace(context);
+      if (json_likely(skip_1(context, ':'))) {
+        skip_any_whitespace(context);
+        callback(key, size);
+      }
+    });
+  });
+}
+
 }  // namespace detail
 }  // namespace json
 }  // namespace spotify
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <spotify/json/detail/bits.hpp>
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * The number of leading digit characters in eight bytes of input, loaded as a
+ * little-endian integer. Each byte is XORed with '0', which turns the digits
+ * into 0 through 9, and a byte is then not a digit if it has its high bit set
+ * or if adding 0x76 to its low seven bits (which can not carry into the next
+ * byte) does.
+ */
+json_force_inline unsigned count_digits_8(const std::uint64_t chunk) {
+  const std::uint64_t x = chunk ^ 0x3030303030303030ULL;
+  const std::uint64_t non_digits = (((x & 0x7F7F7F7F7F7F7F7FULL) + 0x7676767676767676ULL) | x) & 0x8080808080808080ULL;
+  return (non_digits ? count_trailing_zeros(non_digits) / 8 : 8);
+}
+
+/**
+ * The value of the first num_digits (1 through 8) bytes of eight bytes of
+ * input, which must be digits, in three multiplications. The other bytes are
+ * shifted out, so that the digits are preceded by zeros. Each step then adds
+ * up pairs of neighbouring numbers, with the more significant one (in the
+ * lower byte) scaled by 10, 100 and 10000 respectively.
+ */
+json_force_inline std::uint64_t parse_digits_8(const std::uint64_t chunk, const unsigned num_digits) {
+  auto x = (chunk ^ 0x3030303030303030ULL) << (8 * (8 - num_digits));
+  x = ((x * 10) + (x >> 8)) & 0x00FF00FF00FF00FFULL;
+  x = ((x * 100) + (x >> 16)) & 0x0000FFFF0000FFFFULL;
+  return ((x * 10000) + (x >> 32)) & 0xFFFFFFFFULL;
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
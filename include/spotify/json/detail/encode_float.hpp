@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <spotify/json/encode_context.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * Write the shortest decimal number that parses back to exactly the given
+ * value, which must be finite, with the Ryu algorithm. The layout is the one
+ * of ECMAScript's Number.prototype.toString: positional notation for exponents
+ * in [-6, 21) and 1.5e+21 style otherwise, and a plain 0 for negative zero.
+ * Floats get the shortest decimal that identifies the float, which is often
+ * shorter than the one for the same value as a double.
+ */
+void encode_float(encode_context &context, float value);
+void encode_float(encode_context &context, double value);
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
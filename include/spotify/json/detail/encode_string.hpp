@@ -16,38 +16,34 @@
 
 #pragma once
 
-#include <cstdint>
-
 #include <spotify/json/detail/escape.hpp>
 #include <spotify/json/detail/macros.hpp>
 #include <spotify/json/encode_context.hpp>
+#include <spotify/json/escape_policy.hpp>
 
 namespace spotify {
 namespace json {
 namespace detail {
 
 template <typename string_type>
-json_never_inline void encode_string(encode_context &context, const string_type &value) {
+json_never_inline void encode_string(
+    encode_context &context,
+    const string_type &value,
+    const escape_policy policy) {
   context.append('"');
 
-  // Write the strings in 1024 byte chunks, so that we do not have to reserve
-  // a potentially very large buffer for the escaped string. It is possible
-  // that the chunking will happen in the middle of a UTF-8 multi-byte
-  // character, but that is ok since write_escaped will not escape characters
-  // with the high bit set, so the combined escaped string will contain the
-  // correct UTF-8 characters in the end.
-  auto chunk_begin = value.data();
-  const auto string_end = chunk_begin + value.size();
-
-  while (chunk_begin != string_end) {
-    const auto chunk_end = std::min(chunk_begin + 1024, string_end);
-    detail::write_escaped(context, chunk_begin, chunk_end);
-    chunk_begin = chunk_end;
-  }
+  // The escape kernels reserve room one block at a time, so that we do not
+  // have to reserve a potentially very large buffer for the escaped string.
+  detail::write_escaped(context, value.data(), value.data() + value.size(), policy);
 
   context.append('"');
 }
 
+template <typename string_type>
+json_force_inline void encode_string(encode_context &context, const string_type &value) {
+  encode_string(context, value, context.escaping);
+}
+
 }  // namespace detail
 }  // namespace json
 }  // namespace spotify
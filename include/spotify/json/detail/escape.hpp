@@ -16,8 +16,12 @@
 
 #pragma once
 
-#include <spotify/json/encode_context.hpp>
+#include <atomic>
+
+#include <spotify/json/detail/kernels.hpp>
 #include <spotify/json/detail/macros.hpp>
+#include <spotify/json/encode_context.hpp>
+#include <spotify/json/escape_policy.hpp>
 
 namespace spotify {
 namespace json {
@@ -28,13 +32,50 @@ void write_escaped_scalar(
     const char *begin,
     const char *end);
 
+void write_escaped_ascii_scalar(
+    encode_context &context,
+    const char *begin,
+    const char *end);
+
+void write_escaped_html_scalar(
+    encode_context &context,
+    const char *begin,
+    const char *end);
+
 #if defined(json_arch_x86_sse42)
 void write_escaped_sse42(
     encode_context &context,
     const char *begin,
     const char *end);
+
+void write_escaped_ascii_sse42(
+    encode_context &context,
+    const char *begin,
+    const char *end);
+
+void write_escaped_html_sse42(
+    encode_context &context,
+    const char *begin,
+    const char *end);
 #endif  // defined(json_arch_x86_sse42)
 
+#if defined(json_arch_x86_avx2)
+void write_escaped_avx2(
+    encode_context &context,
+    const char *begin,
+    const char *end);
+
+void write_escaped_ascii_avx2(
+    encode_context &context,
+    const char *begin,
+    const char *end);
+
+void write_escaped_html_avx2(
+    encode_context &context,
+    const char *begin,
+    const char *end);
+#endif  // defined(json_arch_x86_avx2)
+
 /**
  * \brief Escape a string for use in a JSON string as per RFC 4627.
  *
@@ -42,17 +83,43 @@ void write_escaped_sse42(
  * backslashes and quotation marks.
  *
  * See: http://www.ietf.org/rfc/rfc4627.txt (Section 2.5)
+ *
+ * The implementation is chosen at runtime, see instruction_set.hpp.
  */
 json_force_inline void write_escaped(
     encode_context &context,
     const char *begin,
     const char *end) {
-#if defined(json_arch_x86_sse42)
-  if (json_likely(context.has_sse42)) {
-    return write_escaped_sse42(context, begin, end);
+  kernels.write_escaped.load(std::memory_order_relaxed)(context, begin, end);
+}
+
+/**
+ * \brief Escape a string for use in a JSON string as the policy says.
+ *
+ * See escape_policy. Each policy except trusted, which copies the string as
+ * is, has its own kernel, chosen at runtime like the one of write_escaped.
+ */
+json_force_inline void write_escaped(
+    encode_context &context,
+    const char *begin,
+    const char *end,
+    const escape_policy policy) {
+  switch (policy) {
+    case escape_policy::standard:
+      kernels.write_escaped.load(std::memory_order_relaxed)(context, begin, end);
+      break;
+    case escape_policy::ascii:
+      kernels.write_escaped_ascii.load(std::memory_order_relaxed)(context, begin, end);
+      break;
+    case escape_policy::html_safe:
+      kernels.write_escaped_html.load(std::memory_order_relaxed)(context, begin, end);
+      break;
+    case escape_policy::trusted:
+      if (begin != end) {
+        context.append(begin, end - begin);
+      }
+      break;
   }
-#endif  // defined(json_arch_x86_sse42)
-  write_escaped_scalar(context, begin, end);
 }
 
 }  // namespace detail
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * Find where elements start in the body of a JSON array or object, which is
+ * [begin, end) where begin is the first element and end is the closing
+ * bracket. Returns begin followed by the start of the first element after
+ * every slice_size bytes, in increasing order.
+ *
+ * The body is scanned on num_threads threads: first every slice counts its
+ * quotes and brackets, which gives whether each slice starts inside a string
+ * and at what depth, and then every slice looks for the first comma between
+ * elements after its start. The body is not validated, and any position may
+ * be returned for invalid input, so the elements must be decoded from the
+ * returned positions in a way that checks that they line up.
+ */
+std::vector<const char *> find_element_starts(
+    const char *begin,
+    const char *end,
+    std::size_t slice_size,
+    std::size_t num_threads);
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
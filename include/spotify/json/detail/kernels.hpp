@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_error.hpp>
+#include <spotify/json/encode_context.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * The process-wide table of kernels that are chosen at runtime, based on the
+ * features of the CPU. Each entry initially points to a function that fills
+ * in the table the first time it is called and then forwards the call, so the
+ * table can be used at any point, including during static initialization.
+ *
+ * The function pointers are atomic only to make the (rare) updates of the
+ * table well-defined; relaxed loads are plain loads on all relevant CPUs.
+ */
+struct kernel_table {
+  using skip_function = void (*)(decode_context &context);
+  using try_skip_function = bool (*)(decode_context &context, decode_error &error);
+  using escape_function = void (*)(encode_context &context, const char *begin, const char *end);
+  using unescape_function = bool (*)(decode_context &context, const char *begin, std::string &out);
+
+  std::atomic<skip_function> skip_any_simple_characters;
+  std::atomic<skip_function> skip_any_whitespace;
+  std::atomic<skip_function> skip_any_simple_characters_padded;
+  std::atomic<skip_function> skip_any_whitespace_padded;
+  std::atomic<skip_function> skip_any_simple_characters_utf8;
+  std::atomic<try_skip_function> skip_value;
+  std::atomic<escape_function> write_escaped;
+  std::atomic<escape_function> write_escaped_ascii;
+  std::atomic<escape_function> write_escaped_html;
+  std::atomic<unescape_function> unescape;
+};
+
+extern kernel_table kernels;
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
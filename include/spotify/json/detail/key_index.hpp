@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * Maps a set of keys to their insertion indices, for looking up object fields.
+ * Keys are added with insert() while a codec is being set up; find() is then
+ * safe to call from any number of threads.
+ *
+ * Up to max_linear_keys keys are kept in a flat array and compared by length
+ * and first eight bytes, which rejects almost all mismatches without touching
+ * the key strings. Larger sets are kept in an open addressing hash table that
+ * is at most half full, with the same length and prefix stored in each slot,
+ * so that a lookup usually touches one slot and no other memory.
+ */
+class key_index {
+ public:
+  static constexpr std::size_t npos = json_size_t_max;
+  static constexpr std::size_t max_linear_keys = 4;
+
+  /**
+   * Add a key with index size(). Returns false, and does nothing, if the key
+   * has already been added.
+   */
+  bool insert(const std::string &key);
+
+  /**
+   * The index of the key, or npos if it has not been added.
+   */
+  json_force_inline std::size_t find(const char *data, const std::size_t size) const {
+    const auto prefix = load_prefix(data, size);
+    if (_slots.empty()) {
+      for (std::size_t i = 0; i < _probes.size(); i++) {
+        if (_probes[i].matches(prefix, size) && matches_suffix(i, data, size)) {
+          return i;
+        }
+      }
+      return npos;
+    }
+
+    const auto mask = _slots.size() - 1;
+    for (auto i = slot_of(prefix, data, size); ; i = (i + 1) & mask) {
+      const auto &slot = _slots[i];
+      if (!slot.index) {
+        return npos;
+      }
+      if (slot.matches(prefix, size) && matches_suffix(slot.index - 1, data, size)) {
+        return slot.index - 1;
+      }
+    }
+  }
+
+  std::size_t find(const std::string &key) const {
+    return find(key.data(), key.size());
+  }
+
+  /**
+   * True if the key with the given index (which must be less than size()) is
+   * equal to the key in data. This is cheaper than find() when the caller has
+   * a good guess of which key it is.
+   */
+  json_force_inline bool is_key(const std::size_t index, const char *data, const std::size_t size) const {
+    return _probes[index].matches(load_prefix(data, size), size) && matches_suffix(index, data, size);
+  }
+
+  /**
+   * The key with the given index, which must be less than size().
+   */
+  const std::string &key(const std::size_t index) const {
+    return _keys[index];
+  }
+
+  std::size_t size() const {
+    return _keys.size();
+  }
+
+ private:
+  struct probe {
+    json_force_inline bool matches(const std::uint64_t prefix, const std::size_t size) const {
+      return (this->prefix == prefix && this->size == size);
+    }
+
+    std::uint64_t prefix;
+    std::uint32_t size;
+    std::uint32_t index;  // the key index plus one, or zero for empty slots
+  };
+
+  /**
+   * The first eight bytes of the key, padded with zeros, as a little-endian
+   * integer. Shorter keys are read with two overlapping loads rather than a
+   * variable length memcpy, which would be a function call.
+   */
+  json_force_inline static std::uint64_t load_prefix(const char *data, const std::size_t size) {
+    if (json_likely(size >= 8)) {
+      std::uint64_t prefix;
+      std::memcpy(&prefix, data, 8);
+      return prefix;
+    } else if (size >= 4) {
+      std::uint32_t lo, hi;
+      std::memcpy(&lo, data, 4);
+      std::memcpy(&hi, data + size - 4, 4);
+      return lo | (std::uint64_t(hi) << ((size - 4) * 8));
+    } else if (size) {
+      const auto byte = [=](std::size_t i) { return std::uint64_t(uint8_t(data[i])) << (i * 8); };
+      return byte(0) | byte(size / 2) | byte(size - 1);
+    } else {
+      return 0;
+    }
+  }
+
+  /**
+   * Multiplicative hashing of the key, eight bytes at a time, taking the top
+   * bits of the product. Most keys fit in the prefix, which has already been
+   * loaded, so they are hashed with a single multiplication.
+   */
+  json_force_inline std::size_t slot_of(
+      const std::uint64_t prefix,
+      const char *data,
+      const std::size_t size) const {
+    auto h = (prefix + size) * 0x9e3779b97f4a7c15ULL;
+    for (std::size_t i = 8; i < size; i += 8) {
+      h = ((h ^ (h >> 29)) + load_prefix(data + i, size - i)) * 0x9e3779b97f4a7c15ULL;
+    }
+    return static_cast<std::size_t>(h >> _slot_shift);
+  }
+
+  json_force_inline bool matches_suffix(
+      const std::size_t index,
+      const char *data,
+      const std::size_t size) const {
+    return (size <= 8 || std::memcmp(_keys[index].data() + 8, data + 8, size - 8) == 0);
+  }
+
+  void insert_slot(std::size_t index);
+
+  std::vector<std::string> _keys;
+  std::vector<probe> _probes;  // one per key, in the same order
+
+  // The hash table, which is empty while there are few enough keys for a
+  // linear scan of _probes. The number of slots is a power of two.
+  std::vector<probe> _slots;
+  unsigned _slot_shift = 64;
+};
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -65,6 +65,8 @@
 #define json_unaligned_4(p)  (reinterpret_cast<intptr_t>(p) & 0x3)
 #define json_unaligned_8(p)  (reinterpret_cast<intptr_t>(p) & 0x7)
 #define json_unaligned_16(p) (reinterpret_cast<intptr_t>(p) & 0xF)
+#define json_unaligned_32(p) (reinterpret_cast<intptr_t>(p) & 0x1F)
+#define json_unaligned_64(p) (reinterpret_cast<intptr_t>(p) & 0x3F)
 
 // http://sourceforge.net/p/predef/wiki/Architectures/
 // http://nadeausoftware.com/articles/2012/02/c_c_tip_how_detect_processor_type_using_compiler_predefined_macros
@@ -87,3 +89,11 @@
 #if defined(json_arch_x86) && defined(SPOTIFY_JSON_USE_SSE42)
   #define json_arch_x86_sse42
 #endif
+
+#if defined(json_arch_x86) && defined(SPOTIFY_JSON_USE_AVX2)
+  #define json_arch_x86_avx2
+#endif
+
+#if defined(json_arch_x86) && defined(SPOTIFY_JSON_USE_AVX512)
+  #define json_arch_x86_avx512bw
+#endif
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * The number of threads to use when the caller asks for 0: the number of
+ * hardware threads, or 1 if that is unknown.
+ */
+std::size_t default_num_threads();
+
+/**
+ * Call task(i) for every i in [0, num_tasks), on at most num_threads threads
+ * including the calling thread. Tasks are handed out in increasing order, one
+ * at a time, so that threads that finish early pick up more work. Returns when
+ * all tasks are done. If a task throws, no more tasks are started and the
+ * first exception is rethrown in the calling thread.
+ */
+void parallel_for(
+    std::size_t num_tasks,
+    std::size_t num_threads,
+    const std::function<void (std::size_t)> &task);
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <spotify/json/decode_context.hpp>
+#include <spotify/json/detail/kernels.hpp>
 #include <spotify/json/detail/macros.hpp>
 
 namespace spotify {
@@ -27,42 +30,105 @@ void skip_any_simple_characters_scalar(decode_context &context);
 #if defined(json_arch_x86_sse42)
 void skip_any_simple_characters_sse42(decode_context &context);
 #endif  // defined(json_arch_x86_sse42)
+#if defined(json_arch_x86_avx2)
+void skip_any_simple_characters_avx2(decode_context &context);
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_avx512bw)
+void skip_any_simple_characters_avx512bw(decode_context &context);
+#endif  // defined(json_arch_x86_avx512bw)
+
+#if defined(json_arch_x86_sse42)
+void skip_any_simple_characters_padded_sse42(decode_context &context);
+#endif  // defined(json_arch_x86_sse42)
+#if defined(json_arch_x86_avx2)
+void skip_any_simple_characters_padded_avx2(decode_context &context);
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_avx512bw)
+void skip_any_simple_characters_padded_avx512bw(decode_context &context);
+#endif  // defined(json_arch_x86_avx512bw)
+
+void skip_any_simple_characters_utf8_scalar(decode_context &context);
+#if defined(json_arch_x86_sse42)
+void skip_any_simple_characters_utf8_sse42(decode_context &context);
+#endif  // defined(json_arch_x86_sse42)
+#if defined(json_arch_x86_avx2)
+void skip_any_simple_characters_utf8_avx2(decode_context &context);
+#endif  // defined(json_arch_x86_avx2)
+
+void fail_invalid_utf8(const decode_context &context);
+
+/**
+ * Skip past the bytes of the string until either a " or a \ character is
+ * found, like skip_any_simple_characters, but without throwing. In strict
+ * UTF-8 mode (see decode_context::strict_utf8) the skipped bytes are also
+ * validated, and skipping stops at the first byte of a sequence that is not
+ * valid UTF-8, in which case false is returned.
+ */
+json_force_inline bool try_skip_any_simple_characters(decode_context &context) {
+  if (json_likely(!context.strict_utf8)) {
+    const auto &kernel = (context.padded ?
+        kernels.skip_any_simple_characters_padded :
+        kernels.skip_any_simple_characters);
+    kernel.load(std::memory_order_relaxed)(context);
+    return true;
+  }
+
+  kernels.skip_any_simple_characters_utf8.load(std::memory_order_relaxed)(context);
+  return !context.remaining() || !(*context.position & 0x80);
+}
 
 /**
  * Skip past the bytes of the string until either a " or a \ character is
  * found. This method attempts to skip as large chunks of memory as possible
  * at each step, by making sure that the context position is aligned to the
  * appropriate address and then reading and comparing several bytes in a
- * single read operation.
+ * single read operation. For padded input, whole chunks are read from the
+ * current position without any alignment. In strict UTF-8 mode, invalid UTF-8
+ * is reported by throwing a decode_exception, or by stopping at it if the
+ * error is recorded instead, see decode_context::error. The implementation is
+ * chosen at runtime, see instruction_set.hpp.
  */
 json_force_inline void skip_any_simple_characters(decode_context &context) {
-#if defined(json_arch_x86_sse42)
-  if (json_likely(context.has_sse42)) {
-    return skip_any_simple_characters_sse42(context);
+  if (json_unlikely(!try_skip_any_simple_characters(context))) {
+    fail_invalid_utf8(context);
   }
-#endif  // defined(json_arch_x86_sse42)
-  return skip_any_simple_characters_scalar(context);
 }
 
 void skip_any_whitespace_scalar(decode_context &context);
 #if defined(json_arch_x86_sse42)
 void skip_any_whitespace_sse42(decode_context &context);
 #endif  // defined(json_arch_x86_sse42)
+#if defined(json_arch_x86_avx2)
+void skip_any_whitespace_avx2(decode_context &context);
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_avx512bw)
+void skip_any_whitespace_avx512bw(decode_context &context);
+#endif  // defined(json_arch_x86_avx512bw)
+
+#if defined(json_arch_x86_sse42)
+void skip_any_whitespace_padded_sse42(decode_context &context);
+#endif  // defined(json_arch_x86_sse42)
+#if defined(json_arch_x86_avx2)
+void skip_any_whitespace_padded_avx2(decode_context &context);
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_avx512bw)
+void skip_any_whitespace_padded_avx512bw(decode_context &context);
+#endif  // defined(json_arch_x86_avx512bw)
 
 /**
  * Skip past the bytes of the string until a non-whitespace character is
  * found. This method attempts to skip as large chunks of memory as possible
  * at each step, by making sure that the context position is aligned to the
  * appropriate address and then reading and comparing several bytes in a
- * single read operation.
+ * single read operation. For padded input, whole chunks are read from the
+ * current position without any alignment. The implementation is chosen at
+ * runtime, see instruction_set.hpp.
  */
 json_force_inline void skip_any_whitespace(decode_context &context) {
-#if defined(json_arch_x86_sse42)
-  if (json_likely(context.has_sse42)) {
-    return skip_any_whitespace_sse42(context);
-  }
-#endif  // defined(json_arch_x86_sse42)
-  skip_any_whitespace_scalar(context);
+  const auto &kernel = (context.padded ?
+      kernels.skip_any_whitespace_padded :
+      kernels.skip_any_whitespace);
+  kernel.load(std::memory_order_relaxed)(context);
 }
 
 }  // namespace detail
@@ -16,20 +16,66 @@
 
 #pragma once
 
+#include <atomic>
+#include <utility>
+
 #include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_error.hpp>
+#include <spotify/json/detail/kernels.hpp>
+#include <spotify/json/detail/macros.hpp>
 
 namespace spotify {
 namespace json {
 namespace detail {
 
+bool try_skip_value_scalar(decode_context &context, decode_error &error);
+void skip_value_scalar(decode_context &context);
+#if defined(json_arch_x86_avx2)
+bool try_skip_value_avx2(decode_context &context, decode_error &error);
+void skip_value_avx2(decode_context &context);
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_avx512bw)
+bool try_skip_value_avx512bw(decode_context &context, decode_error &error);
+void skip_value_avx512bw(decode_context &context);
+#endif  // defined(json_arch_x86_avx512bw)
+
+/**
+ * Skip past one JSON value, like skip_value, but without throwing. Returns
+ * false and sets error if the value is invalid, in which case the
+ * context.position is unspecified.
+ */
+json_force_inline bool try_skip_value(decode_context &context, decode_error &error) {
+  if (json_unlikely(context.strict_utf8)) {
+    return try_skip_value_scalar(context, error);
+  }
+  return kernels.skip_value.load(std::memory_order_relaxed)(context, error);
+}
+
 /**
- * Skip past one JSON value. If parsing fails, context will be set to that it
- * has failed. If parsing suceeds, context.position will point to the character
- * after the last character of the JSON object that was parsed.
+ * Skip past one JSON value. If parsing fails, a decode_exception is thrown, or
+ * the error is recorded in context.error if it is set. If parsing succeeds,
+ * context.position will point to the character after the last character of
+ * the JSON object that was parsed.
+ *
+ * The AVX2 and AVX-512 implementations first find the structural characters
+ * of objects and arrays 64 bytes at a time, and then only visit those, while
+ * accepting and rejecting exactly the same input as the scalar one. In strict
+ * UTF-8 mode, see decode_context::strict_utf8, the scalar implementation is
+ * always used, since it validates strings as it skips them. The
+ * implementation is chosen at runtime, see instruction_set.hpp.
  *
  * context.has_failed() must be false when this function is called.
  */
-void skip_value(decode_context &context);
+json_force_inline void skip_value(decode_context &context) {
+  decode_error error;
+  if (json_unlikely(!try_skip_value(context, error))) {
+    if (context.error) {
+      *context.error = std::move(error);
+    } else {
+      error.raise();
+    }
+  }
+}
 
 }  // namespace detail
 }  // namespace json
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/detail/kernels.hpp>
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+bool try_unescape_scalar(decode_context &context, const char *begin, std::string &out);
+#if defined(json_arch_x86_sse42)
+bool try_unescape_sse42(decode_context &context, const char *begin, std::string &out);
+#endif  // defined(json_arch_x86_sse42)
+#if defined(json_arch_x86_avx2)
+bool try_unescape_avx2(decode_context &context, const char *begin, std::string &out);
+#endif  // defined(json_arch_x86_avx2)
+
+/**
+ * Unescape the string that starts at begin (just after the opening quote) and
+ * whose first backslash has just been read, so that context.position is just
+ * after it. On success, out is the whole unescaped string, context.position is
+ * just after the closing quote and true is returned.
+ *
+ * The end of the string is found first, so that out can be sized once for the
+ * whole string, and the characters between escape sequences are then copied
+ * in chunks of 8, 16 or 32 bytes. If the string is invalid or unterminated,
+ * false is returned and context is left as it was, so that the caller can
+ * decode the string again in a way that reports the error. The implementation
+ * is chosen at runtime, see instruction_set.hpp.
+ */
+json_force_inline bool try_unescape(decode_context &context, const char *begin, std::string &out) {
+  return kernels.unescape.load(std::memory_order_relaxed)(context, begin, out);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
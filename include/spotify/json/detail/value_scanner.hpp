@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * Finds where a JSON value ends in input that arrives in chunks. The scanner
+ * keeps the nesting depth and whether it is inside a string or an escape
+ * sequence between calls, so every byte is looked at only once no matter how
+ * the input is split.
+ *
+ * The scanner does not validate the value; that is left to the codec that
+ * decodes it once it is complete. It only needs to agree with the codecs on
+ * where valid values end.
+ */
+class value_scanner final {
+ public:
+  value_scanner();
+
+  /**
+   * Continue scanning the value at [begin, end), where begin is the first byte
+   * that the previous calls have not seen. Leading whitespace is skipped.
+   *
+   * Returns a pointer past the last byte of the value, or nullptr if more
+   * input is needed. Numbers and literals end at the first byte that is not
+   * part of them, so they are only found to end once that byte has arrived.
+   * If the value starts with a byte that cannot start a value, for example
+   * ',' or ']', that byte is returned so the codec can report the error.
+   */
+  const char *scan(const char *begin, const char *end);
+
+  /**
+   * Prepare for scanning the next value.
+   */
+  void reset();
+
+ private:
+  std::size_t _depth;
+  bool _started;
+  bool _in_scalar;
+  bool _in_string;
+  bool _escaped;
+};
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -24,8 +24,8 @@
 #include <limits>
 #include <memory>
 
-#include <spotify/json/detail/cpuid.hpp>
 #include <spotify/json/detail/macros.hpp>
+#include <spotify/json/escape_policy.hpp>
 
 namespace spotify {
 namespace json {
@@ -38,7 +38,7 @@ namespace detail {
 template <typename size_type = std::size_t>
 struct base_encode_context final {
   base_encode_context(const size_type capacity = 4096)
-      : has_sse42(detail::cpuid().has_sse42()),
+      : escaping(escape_policy::standard),
         _buf(static_cast<char *>(capacity ? std::malloc(capacity) : nullptr)),
         _ptr(_buf),
         _end(_buf + capacity),
@@ -66,6 +66,23 @@ struct base_encode_context final {
     _ptr += num_bytes;
   }
 
+  /**
+   * Take back the last num_bytes bytes that were written. They stay in the
+   * buffer, at the position that the next call to reserve returns, so that they
+   * can be rewritten in place.
+   */
+  json_force_inline void retreat(const size_type num_bytes) {
+    _ptr -= num_bytes;
+  }
+
+  /**
+   * Overwrite a byte that has already been written, at the given offset from
+   * the start of the buffer.
+   */
+  json_force_inline void replace(const size_type offset, const char c) {
+    _buf[offset] = c;
+  }
+
   json_force_inline void append(const char c) {
     reserve(1)[0] = c;
     advance(1);
@@ -113,7 +130,13 @@ struct base_encode_context final {
     return std::unique_ptr<void, decltype(std::free) *>(data, &std::free);
   }
 
-  const bool has_sse42;
+  /**
+   * How strings are escaped, unless their codec has a policy of its own. It is
+   * escape_policy::standard by default; set it before encoding to change it.
+   * Object keys of object_t codecs are escaped when the fields are added, see
+   * object_t::escape_keys; those of static_object_t codecs follow this policy.
+   */
+  escape_policy escaping;
 
  private:
   json_never_inline void grow_buffer(const size_type num_bytes) {
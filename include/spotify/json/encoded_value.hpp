@@ -39,7 +39,7 @@ struct encoded_value_base {
   static void validate_json(const char *data, std::size_t size) {
     decode_context context(data, size);
     detail::skip_value(context);  // validate provided JSON string
-    detail::fail_if(context, context.position != context.end, "Unexpected trailing input");
+    detail::fail_if(context, context.position != context.end, decode_error::unexpected_trailing_input);
   }
 };
 
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+namespace spotify {
+namespace json {
+
+/**
+ * How strings are escaped when they are encoded. The policy is taken from the
+ * encode_context, unless the string codec has a policy of its own. Whatever
+ * the policy, the output is valid JSON as long as the input is valid UTF-8.
+ */
+enum class escape_policy {
+  /**
+   * Escape control characters, quotation marks and backslashes, as required
+   * by RFC 4627. Everything else is written as is.
+   */
+  standard,
+
+  /**
+   * Like standard, but also escape all non-ASCII characters as \uXXXX (with
+   * surrogate pairs above U+FFFF), so that the output is pure ASCII. Bytes
+   * that are not part of valid UTF-8 are written as \uFFFD.
+   */
+  ascii,
+
+  /**
+   * Like standard, but also escape <, > and & as \u003C, \u003E and \u0026,
+   * so that the output can be embedded in HTML, for example in a script tag.
+   */
+  html_safe,
+
+  /**
+   * Do not escape anything; the string is copied as is. Only for strings that
+   * are known to not have any characters that need escaping, such as IDs.
+   */
+  trusted
+};
+
+}  // namespace json
+}  // namespace spotify
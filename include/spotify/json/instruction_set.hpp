@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+namespace spotify {
+namespace json {
+
+/**
+ * The instruction sets that spotify-json has vectorized kernels for, ordered
+ * from the least to the most capable. Kernels that do not have an
+ * implementation for a given instruction set use the best one below it. The
+ * avx2 and avx512bw levels also require the carry-less multiplication
+ * instruction (PCLMULQDQ), which all CPUs with AVX2 have in practice.
+ */
+enum class instruction_set {
+  scalar,
+  sse42,
+  avx2,
+  avx512bw
+};
+
+/**
+ * The most capable instruction set that is supported by both the library (as
+ * configured at build time) and the CPU that the process is running on.
+ */
+instruction_set supported_instruction_set();
+
+/**
+ * The instruction set that the kernels are currently using. Unless overridden,
+ * this is the supported_instruction_set(), or the instruction set named by the
+ * SPOTIFY_JSON_INSTRUCTION_SET environment variable ("scalar", "sse42", "avx2"
+ * or "avx512bw") if that is less capable. The environment variable is read
+ * once, the first time a kernel is used.
+ */
+instruction_set active_instruction_set();
+
+/**
+ * Make all kernels use the given instruction set, or the most capable one
+ * below it if the instruction set is not supported. This is a process-wide
+ * setting that is mostly useful for benchmarking and testing. It is safe to
+ * call at any time, also while other threads are encoding or decoding JSON.
+ *
+ * @return The instruction set that the kernels will use.
+ */
+instruction_set use_instruction_set(instruction_set set);
+
+}  // namespace json
+}  // namespace spotify
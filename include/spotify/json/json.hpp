@@ -16,14 +16,22 @@
 
 #pragma once
 
+#include <spotify/json/chunked_decoder.hpp>
 #include <spotify/json/codec.hpp>
 #include <spotify/json/decode.hpp>
+#include <spotify/json/decode_error.hpp>
 #include <spotify/json/decode_exception.hpp>
 #include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_lines.hpp>
+#include <spotify/json/decode_parallel.hpp>
 #include <spotify/json/default_codec.hpp>
 #include <spotify/json/encode.hpp>
 #include <spotify/json/encode_exception.hpp>
 #include <spotify/json/encode_context.hpp>
 #include <spotify/json/encoded_value.hpp>
+#include <spotify/json/instruction_set.hpp>
+#include <spotify/json/mapped_file.hpp>
+#include <spotify/json/padded_string.hpp>
+#include <spotify/json/string_ref.hpp>
 #include <spotify/json/value.hpp>
 #include <spotify/json/value_exception.hpp>
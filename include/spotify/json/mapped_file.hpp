@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <spotify/json/decode_context.hpp>
+
+namespace spotify {
+namespace json {
+
+/**
+ * A read-only memory mapping of a file, followed by at least decode_padding
+ * readable zero bytes, so that it can be decoded in place as padded input
+ * (see decode_context::padded_input) without copying it into a string first.
+ * The kernel is told that the file will be read sequentially.
+ *
+ * Files are mapped with mmap where it is available, and read into a buffer
+ * otherwise. The mapping reflects the file as it was when it was opened only
+ * as long as nobody modifies it, so only map files that are not written to.
+ *
+ * A mapped_file has data() and size(), so an encoded_value_ref can refer to
+ * it, which validates the JSON in the file without decoding it.
+ */
+class mapped_file final {
+ public:
+  /**
+   * @throws std::system_error if the file cannot be opened or mapped.
+   */
+  explicit mapped_file(const std::string &path);
+  mapped_file(mapped_file &&file) noexcept;
+  mapped_file(const mapped_file &) = delete;
+  ~mapped_file();
+
+  mapped_file &operator=(mapped_file &&file) noexcept;
+  mapped_file &operator=(const mapped_file &) = delete;
+
+  const char *data() const { return _data; }
+  std::size_t size() const { return _size; }
+
+  void swap(mapped_file &file) noexcept;
+
+ private:
+  const char *_data;
+  std::size_t _size;
+  std::size_t _mapping_size;  // 0 if _data was allocated with malloc
+};
+
+}  // namespace json
+}  // namespace spotify
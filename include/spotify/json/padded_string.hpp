@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+
+/**
+ * A copy of a string that is followed by decode_padding zero bytes, so that it
+ * can be decoded as padded input (see decode_context::padded_input). Passing a
+ * padded_string to json::decode picks the padded decode path automatically.
+ * Input that is already in a buffer with enough spare capacity after it can be
+ * decoded in place with json::decode_padded instead.
+ */
+struct padded_string {
+  padded_string();
+  padded_string(padded_string &&string) noexcept;
+  padded_string(const padded_string &string);
+  explicit padded_string(const char *cstr);
+  explicit padded_string(const char *data, std::size_t size);
+  explicit padded_string(const std::string &string);
+
+  padded_string &operator=(padded_string &&string) noexcept;
+  padded_string &operator=(const padded_string &string);
+
+  const char *data() const { return _data.get(); }
+  std::size_t size() const { return _size; }
+
+  void swap(padded_string &string);
+
+ private:
+  using data_buffer = std::unique_ptr<char, decltype(std::free) *>;
+  std::size_t _size;
+  data_buffer _data;
+};
+
+inline padded_string::padded_string()
+    : padded_string(nullptr, 0) {}
+
+inline padded_string::padded_string(padded_string &&string) noexcept
+    : padded_string() {
+  swap(string);
+}
+
+inline padded_string::padded_string(const padded_string &string)
+    : padded_string(string.data(), string.size()) {}
+
+inline padded_string::padded_string(const char *cstr)
+    : padded_string(cstr, cstr ? std::strlen(cstr) : 0) {}
+
+inline padded_string::padded_string(const std::string &string)
+    : padded_string(string.data(), string.size()) {}
+
+inline padded_string::padded_string(const char *data, std::size_t size)
+    : _size(size),
+      _data(static_cast<char *>(std::malloc(size + decode_padding)), &std::free) {
+  if (json_unlikely(!_data)) {
+    throw std::bad_alloc();
+  }
+  if (size) {
+    std::memcpy(_data.get(), data, size);
+  }
+  std::memset(_data.get() + size, 0, decode_padding);
+}
+
+inline padded_string &padded_string::operator=(padded_string &&string) noexcept {
+  swap(string);
+  return *this;
+}
+
+inline padded_string &padded_string::operator=(const padded_string &string) {
+  padded_string new_string(string);
+  swap(new_string);
+  return *this;
+}
+
+inline void padded_string::swap(padded_string &string) {
+  std::swap(_size, string._size);
+  std::swap(_data, string._data);
+}
+
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * Append the unescaped contents of a JSON string to out. The range is what is
+ * between the quotes, and its escape sequences must already have been
+ * validated, which the codecs that produce a raw_string do.
+ */
+void unescape_string(const char *begin, const char *end, std::string &out);
+
+}  // namespace detail
+
+/**
+ * A reference to a string that is owned by someone else, typically the input
+ * that it was decoded from, like encoded_value_ref is for JSON values.
+ */
+struct string_ref {
+  string_ref()
+      : _data(""),
+        _size(0) {}
+
+  string_ref(const char *data, const std::size_t size)
+      : _data(data),
+        _size(size) {}
+
+  string_ref(const char *cstr)
+      : string_ref(cstr, std::strlen(cstr)) {}
+
+  string_ref(const std::string &string)
+      : string_ref(string.data(), string.size()) {}
+
+  const char *data() const { return _data; }
+  std::size_t size() const { return _size; }
+  bool empty() const { return !_size; }
+
+  std::string str() const {
+    return std::string(_data, _size);
+  }
+
+ private:
+  const char *_data;
+  std::size_t _size;
+};
+
+/**
+ * A string as it appears in JSON input, between the quotes and with its
+ * escape sequences still in place. Unescaping is put off until the string is
+ * used, and is only done at all if the string has escape sequences. Like
+ * string_ref, a raw_string refers to memory that is owned by someone else.
+ */
+struct raw_string {
+  raw_string() = default;
+
+  /**
+   * The escaped bytes must be valid JSON string contents. has_escapes must be
+   * true if there are any backslashes in them.
+   */
+  raw_string(const char *escaped_data, const std::size_t escaped_size, const bool has_escapes)
+      : _escaped(escaped_data, escaped_size),
+        _has_escapes(has_escapes) {}
+
+  const char *escaped_data() const { return _escaped.data(); }
+  std::size_t escaped_size() const { return _escaped.size(); }
+  bool has_escapes() const { return _has_escapes; }
+
+  /**
+   * The unescaped string. If there are no escape sequences, this is the raw
+   * string itself and buffer is not touched. Otherwise the string is unescaped
+   * into buffer, which is overwritten, and the result refers to it. The same
+   * buffer can be reused for many strings to avoid allocating memory.
+   */
+  string_ref view(std::string &buffer) const {
+    if (!_has_escapes) {
+      return _escaped;
+    }
+
+    buffer.clear();
+    unescape(buffer);
+    return buffer;
+  }
+
+  /**
+   * Append the unescaped string to out.
+   */
+  void unescape(std::string &out) const {
+    if (!_has_escapes) {
+      out.append(_escaped.data(), _escaped.size());
+    } else {
+      detail::unescape_string(_escaped.data(), _escaped.data() + _escaped.size(), out);
+    }
+  }
+
+  std::string str() const {
+    std::string string;
+    unescape(string);
+    return string;
+  }
+
+ private:
+  string_ref _escaped;
+  bool _has_escapes = false;
+};
+
+inline bool operator==(const string_ref &a, const string_ref &b) {
+  return
+      a.size() == b.size() &&
+      (a.data() == b.data() || std::memcmp(a.data(), b.data(), a.size()) == 0);
+}
+
+inline bool operator!=(const string_ref &a, const string_ref &b) {
+  return !(a == b);
+}
+
+inline std::ostream &operator <<(std::ostream &stream, const string_ref &value) {
+  stream.write(value.data(), value.size());
+  return stream;
+}
+
+}  // namespace json
+}  // namespace spotify
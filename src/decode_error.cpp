@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/decode_error.hpp>
+
+#include <algorithm>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/detail/decode_helpers.hpp>
+
+namespace spotify {
+namespace json {
+
+namespace {
+
+/**
+ * The message of the errors whose message only depends on their code, which
+ * is the message of the decode_exception that is thrown for them, or nullptr
+ * for the others.
+ */
+const char *fixed_message(const decode_error::code_type code) {
+  switch (code) {
+    case decode_error::unexpected_end_of_input: return "Unexpected end of input";
+    case decode_error::unexpected_input: return "Unexpected input";
+    case decode_error::unexpected_trailing_input: return "Unexpected trailing input";
+    case decode_error::unterminated_string: return "Unterminated string";
+    case decode_error::invalid_escape_character: return "Invalid escape character";
+    case decode_error::invalid_unicode_escape: return "\\u must be followed by 4 hex digits";
+    case decode_error::unpaired_surrogate: return "Unpaired surrogate in \\u escape sequence";
+    case decode_error::invalid_utf8: return "Invalid UTF-8";
+    case decode_error::expected_digit: return "Expected digit";
+    case decode_error::expected_digit_after_decimal_point: return "Expected digit after decimal point";
+    case decode_error::expected_digit_after_exponent_sign: return "Expected digit after exponent sign";
+    case decode_error::expected_quote: return "Expected '\"'";
+    case decode_error::expected_comma_or_closing_brace: return "Expected ',' or '}'";
+    case decode_error::expected_comma_or_closing_bracket: return "Expected ',' or ']'";
+    case decode_error::expected_closing_brace: return "Expected '}'";
+    case decode_error::expected_closing_bracket: return "Expected ']'";
+    case decode_error::unexpected_eof: return "Unexpected EOF";
+    default: return nullptr;
+  }
+}
+
+}  // namespace
+
+std::string decode_error::message() const {
+  switch (_code) {
+    case none: return std::string();
+    case unexpected_token: return std::string("Encountered token '") + _token + "'";
+    case rejected_by_codec:
+      if (_message) {
+        return _message;
+      }
+      return (_message_copy.empty() ? "Rejected by codec" : _message_copy);
+    default: return fixed_message(_code);
+  }
+}
+
+size_t decode_error::line(const char *data) const {
+  return 1 + static_cast<size_t>(std::count(data, data + _offset, '\n'));
+}
+
+size_t decode_error::column(const char *data) const {
+  const auto end = data + _offset;
+  auto line_begin = end;
+  while (line_begin != data && line_begin[-1] != '\n') {
+    --line_begin;
+  }
+  return 1 + static_cast<size_t>(end - line_begin);
+}
+
+void decode_error::raise() const {
+  throw decode_exception(message(), _offset);
+}
+
+namespace detail {
+
+void fail(const decode_context &context, const decode_error::code_type code, const ptrdiff_t d) {
+  const decode_error error(code, context.offset(d));
+  if (json_likely(!context.error)) {
+    error.raise();
+  }
+  if (!*context.error) {
+    *context.error = error;
+  }
+}
+
+}  // namespace detail
+
+}  // namespace json
+}  // namespace spotify
@@ -17,16 +17,66 @@
 #include <spotify/json/detail/decode_string.hpp>
 
 #include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/unescape.hpp>
+#include <spotify/json/string_ref.hpp>
 
 namespace spotify {
 namespace json {
 namespace detail {
+namespace {
+
+/**
+ * A string_type for decode_escape_sequence that validates the escape sequence
+ * without storing the unescaped characters anywhere.
+ */
+struct discarding_string {
+  void push_back(char) {}
+  void append(const char *, std::size_t) {}
+  void append(const char *, const char *) {}
+};
+
+}  // namespace
 
 std::uint8_t decode_hex_nibble(decode_context &context, const char c) {
   if (c >= '0' && c <= '9') { return c - '0'; }
   if (c >= 'a' && c <= 'f') { return c - 'a' + 0xA; }
   if (c >= 'A' && c <= 'F') { return c - 'A' + 0xA; }
-  detail::fail(context, "\\u must be followed by 4 hex digits");
+  detail::fail(context, decode_error::invalid_unicode_escape);
+  return 0;
+}
+
+template <>
+std::string decode_escaped_string<std::string>(decode_context &context, const char *begin) {
+  // The kernel does not validate UTF-8, so it is not used in strict mode.
+  std::string unescaped;
+  if (json_likely(!context.strict_utf8 && try_unescape(context, begin, unescaped))) {
+    return unescaped;
+  }
+
+  // The kernel does not report errors, so decode the string again in a way
+  // that does.
+  unescaped.assign(begin, context.position - 1);
+  decode_escape_sequences(context, unescaped);
+  return unescaped;
+}
+
+void skip_escaped_string(decode_context &context) {
+  discarding_string discarded;
+  decode_escape_sequences(context, discarded);
+}
+
+void unescape_string(const char *begin, const char *end, std::string &out) {
+  decode_context context(begin, end);
+  while (context.remaining()) {
+    const auto begin_simple = context.position;
+    detail::skip_any_simple_characters(context);
+    out.append(begin_simple, context.position);
+
+    if (context.remaining()) {
+      context.position++;  // the backslash
+      decode_escape_sequence(context, out);
+    }
+  }
 }
 
 }  // namespace detail
@@ -51,14 +51,20 @@ number decode_number(decode_context &context) {
   if (peek(context) == '0') {
     ++context.position;
   } else {
-    fail_if(context, !is_digit(peek(context)), "Expected digit");
+    if (json_unlikely(!is_digit(peek(context)))) {
+      fail(context, decode_error::expected_digit);
+      return number();
+    }
     do { ++context.position; } while (is_digit(peek(context)));
   }
 
   // Parse fractional part
   if (peek(context) == '.') {
     ++context.position;
-    fail_if(context, !is_digit(peek(context)), "Expected digit after decimal point");
+    if (json_unlikely(!is_digit(peek(context)))) {
+      fail(context, decode_error::expected_digit_after_decimal_point);
+      return number();
+    }
     do { ++context.position; } while (is_digit(peek(context)));
     is_decimal = true;
   }
@@ -72,7 +78,10 @@ number decode_number(decode_context &context) {
       ++context.position;
     }
 
-    fail_if(context, !is_digit(peek(context)), "Expected digit after exponent sign");
+    if (json_unlikely(!is_digit(peek(context)))) {
+      fail(context, decode_error::expected_digit_after_exponent_sign);
+      return number();
+    }
     do { ++context.position; } while (is_digit(peek(context)));
   }
 
@@ -105,6 +114,10 @@ value decode_value(decode_context &context) {
   using object_type = object<value>;
 
   do {
+    if (json_unlikely(context.has_failed())) {
+      return value();
+    }
+
     const char c = peek(context);
     if (c == '[') {
       skip_1(context, '[');
@@ -131,6 +144,7 @@ value decode_value(decode_context &context) {
       val = decode_number(context);
     } else {
       fail(context, std::string("Encountered unexpected character '") + c + "'");
+      return value();
     }
 
     while (!stack.empty()) {
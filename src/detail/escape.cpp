@@ -16,6 +16,7 @@
 
 #include <spotify/json/detail/escape.hpp>
 
+#include <cstdint>
 #include <cstring>
 
 #include "escape_common.hpp"
@@ -24,22 +25,305 @@ namespace spotify {
 namespace json {
 namespace detail {
 
+alignas(16) const std::uint8_t escape_expansion[256][16] = {
+  { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x07, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x07, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x07, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x06, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x06, 0x80, 0x0F, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x05, 0x80, 0x0E, 0x80, 0x0F, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x04, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80 },
+  { 0x00, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x03, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80 },
+  { 0x00, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x00, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x02, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80 },
+  { 0x00, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80, 0x80 },
+  { 0x80, 0x08, 0x01, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80 },
+  { 0x00, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F, 0x80 },
+  { 0x80, 0x08, 0x80, 0x09, 0x80, 0x0A, 0x80, 0x0B, 0x80, 0x0C, 0x80, 0x0D, 0x80, 0x0E, 0x80, 0x0F }
+};
+
+namespace {
+
+void write_escaped_block_scalar(char *&out, const char *&begin, const char *end) {
+  if (json_unaligned_2(begin) && (end - begin) >= 1) { write_escaped_1(out, begin); }
+  if (json_unaligned_4(begin) && (end - begin) >= 2) { write_escaped_2(out, begin); }
+  if (json_unaligned_8(begin) && (end - begin) >= 4) { write_escaped_4(out, begin); }
+  while ((end - begin) >= 8) { write_escaped_8(out, begin); }
+  if    ((end - begin) >= 4) { write_escaped_4(out, begin); }
+  if    ((end - begin) >= 2) { write_escaped_2(out, begin); }
+  if    ((end - begin) >= 1) { write_escaped_1(out, begin); }
+}
+
+template <escape_policy policy>
+void write_escaped_block_scalar(char *&out, const char *&begin, const char *end) {
+  while (begin != end) {
+    write_escaped_character<policy>(out, begin, end);
+  }
+}
+
+}  // namespace
+
 void write_escaped_scalar(
     encode_context &context,
     const char *begin,
     const char *end) {
-  const auto buf = context.reserve(6 * (end - begin));  // 6 is the length of \u00xx
-  auto ptr = buf;
-
-  if (json_unaligned_2(begin) && (end - begin) >= 1) { write_escaped_1(ptr, begin); }
-  if (json_unaligned_4(begin) && (end - begin) >= 2) { write_escaped_2(ptr, begin); }
-  if (json_unaligned_8(begin) && (end - begin) >= 4) { write_escaped_4(ptr, begin); }
-  while ((end - begin) >= 8) { write_escaped_8(ptr, begin); }
-  if    ((end - begin) >= 4) { write_escaped_4(ptr, begin); }
-  if    ((end - begin) >= 2) { write_escaped_2(ptr, begin); }
-  if    ((end - begin) >= 1) { write_escaped_1(ptr, begin); }
-
-  context.advance(ptr - buf);
+  write_escaped_blocks<write_escaped_block_scalar>(context, begin, end);
+}
+
+void write_escaped_ascii_scalar(
+    encode_context &context,
+    const char *begin,
+    const char *end) {
+  write_escaped_blocks<write_escaped_block_scalar<escape_policy::ascii>>(context, begin, end);
+}
+
+void write_escaped_html_scalar(
+    encode_context &context,
+    const char *begin,
+    const char *end) {
+  write_escaped_blocks<write_escaped_block_scalar<escape_policy::html_safe>>(context, begin, end);
 }
 
 }  // namespace detail
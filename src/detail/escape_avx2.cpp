@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/escape.hpp>
+
+#if defined(json_arch_x86_avx2)
+
+#include <immintrin.h>
+
+#include "escape_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+/**
+ * Write eight bytes of input whose escaped characters all have two character
+ * escape sequences. The low half of source is the input, and the high half has
+ * the second character of the escape sequence of each escaped byte, which are
+ * flagged in mask. The shuffle from escape_expansion puts each byte where it
+ * goes, and leaves room for the backslashes, which are then filled in.
+ */
+json_force_inline void write_escaped_8_avx2(char *&out, const __m128i source, const unsigned mask) {
+  const auto expansion = _mm_load_si128(reinterpret_cast<const __m128i *>(escape_expansion[mask]));
+  const auto expanded = _mm_shuffle_epi8(source, expansion);
+  const auto is_backslash = _mm_cmpeq_epi8(expansion, _mm_set1_epi8(char(0x80)));
+  _mm_storeu_si128(
+      reinterpret_cast<__m128i *>(out),
+      _mm_blendv_epi8(expanded, _mm_set1_epi8('\\'), is_backslash));
+  out += 8 + _mm_popcnt_u32(mask);
+}
+
+template <escape_policy policy>
+void write_escaped_block_avx2(char *&out, const char *&begin, const char *end) {
+  const auto quote = _mm256_set1_epi8('"');
+  const auto backslash = _mm256_set1_epi8('\\');
+  const auto zero = _mm256_setzero_si256();
+
+  // The second character of the escape sequences of the control characters
+  // below 0x10, by their low nibble. The others are escaped as \u00xx.
+  const auto control_characters = _mm256_setr_epi8(
+      0, 0, 0, 0, 0, 0, 0, 0, 'b', 't', 'n', 0, 'f', 'r', 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0, 'b', 't', 'n', 0, 'f', 'r', 0, 0);
+
+  while (end - begin >= 32) {
+    const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+    const auto is_control = _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, _mm256_set1_epi8(0x1F)), chunk);
+    const auto is_escaped = _mm256_or_si256(
+        is_control,
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)));
+
+    // The characters that only the policy escapes, none of which have a two
+    // character escape sequence.
+    auto is_policy_escaped = zero;
+    if (policy == escape_policy::ascii) {
+      is_policy_escaped = _mm256_cmpgt_epi8(zero, chunk);
+    } else if (policy == escape_policy::html_safe) {
+      is_policy_escaped = _mm256_or_si256(
+          _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('&')),
+          _mm256_or_si256(
+              _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('<')),
+              _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('>'))));
+    }
+
+    const auto mask = std::uint32_t(_mm256_movemask_epi8(_mm256_or_si256(is_escaped, is_policy_escaped)));
+    if (json_likely(!mask)) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), chunk);
+      out += 32;
+      begin += 32;
+      continue;
+    }
+
+    const auto is_low_control = _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, _mm256_set1_epi8(0x0F)), chunk);
+    const auto control_character = _mm256_and_si256(_mm256_shuffle_epi8(control_characters, chunk), is_low_control);
+    const auto is_unicode_escaped = _mm256_or_si256(
+        _mm256_and_si256(is_control, _mm256_cmpeq_epi8(control_character, zero)),
+        is_policy_escaped);
+    const auto unicode_mask = std::uint32_t(_mm256_movemask_epi8(is_unicode_escaped));
+
+    // Quotes and backslashes are escaped with themselves. Groups of eight
+    // bytes with characters that are escaped as \uXXXX are written one
+    // character at a time, which is rare enough in practice to not be worth a
+    // table. For UTF-8 sequences, this may end a few bytes into the next
+    // group, which is then also written one character at a time.
+    const auto escape_characters = _mm256_blendv_epi8(chunk, control_character, is_control);
+    const auto lo = _mm256_castsi256_si128(chunk);
+    const auto hi = _mm256_extracti128_si256(chunk, 1);
+    const auto escape_lo = _mm256_castsi256_si128(escape_characters);
+    const auto escape_hi = _mm256_extracti128_si256(escape_characters, 1);
+    const __m128i sources[] = {
+      _mm_unpacklo_epi64(lo, escape_lo),
+      _mm_unpackhi_epi64(lo, escape_lo),
+      _mm_unpacklo_epi64(hi, escape_hi),
+      _mm_unpackhi_epi64(hi, escape_hi)
+    };
+
+    auto group = begin;
+    for (int i = 0; i < 4; i++, group += 8) {
+      if (json_likely(begin == group && !((unicode_mask >> (8 * i)) & 0xFF))) {
+        write_escaped_8_avx2(out, sources[i], (mask >> (8 * i)) & 0xFF);
+        begin += 8;
+      } else {
+        while (begin < group + 8) {
+          write_escaped_character<policy>(out, begin, end);
+        }
+      }
+    }
+  }
+
+  if (policy == escape_policy::standard) {
+    if ((end - begin) >= 16) { write_escaped_8(out, begin); write_escaped_8(out, begin); }
+    if ((end - begin) >= 8) { write_escaped_8(out, begin); }
+    if ((end - begin) >= 4) { write_escaped_4(out, begin); }
+    if ((end - begin) >= 2) { write_escaped_2(out, begin); }
+    if ((end - begin) >= 1) { write_escaped_1(out, begin); }
+  } else {
+    while (begin != end) {
+      write_escaped_character<policy>(out, begin, end);
+    }
+  }
+}
+
+}  // namespace
+
+void write_escaped_avx2(
+    encode_context &context,
+    const char *begin,
+    const char *end) {
+  write_escaped_blocks<write_escaped_block_avx2<escape_policy::standard>>(context, begin, end);
+}
+
+void write_escaped_ascii_avx2(
+    encode_context &context,
+    const char *begin,
+    const char *end) {
+  write_escaped_blocks<write_escaped_block_avx2<escape_policy::ascii>>(context, begin, end);
+}
+
+void write_escaped_html_avx2(
+    encode_context &context,
+    const char *begin,
+    const char *end) {
+  write_escaped_blocks<write_escaped_block_avx2<escape_policy::html_safe>>(context, begin, end);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
+
+#endif  // defined(json_arch_x86_avx2)
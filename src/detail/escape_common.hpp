@@ -16,10 +16,15 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 
 #include <spotify/json/detail/macros.hpp>
+#include <spotify/json/encode_context.hpp>
+#include <spotify/json/escape_policy.hpp>
+
+#include "utf8_common.hpp"
 
 #if _MSC_VER
 #pragma intrinsic (memcpy)
@@ -29,6 +34,46 @@ namespace spotify {
 namespace json {
 namespace detail {
 
+/**
+ * Strings are escaped in blocks of this many bytes, and room for the longest
+ * possible escaped block (six bytes, \u00xx, for every byte) is reserved one
+ * block at a time, so that escaping a long string never reserves much more
+ * than it writes. Blocks are cut before any UTF-8 sequence that would straddle
+ * them, so that kernels that decode UTF-8 see whole sequences. (The longest
+ * escape of a UTF-8 sequence, a surrogate pair, is three bytes per byte.)
+ */
+constexpr std::size_t escape_block_size = 1024;
+
+/**
+ * For each combination of bytes that are escaped among eight bytes of input,
+ * the shuffle that moves each input byte to where it goes in the output, when
+ * the input is followed by the second characters of the escape sequences. The
+ * output position of each backslash is 0x80, which the shuffle fills with zero.
+ */
+extern const std::uint8_t escape_expansion[256][16];
+
+/**
+ * Escape [begin, end) one block at a time with write_escaped_block, which
+ * must advance begin to the end of the block that it is given.
+ */
+template <void (*write_escaped_block)(char *&out, const char *&begin, const char *end)>
+json_force_inline void write_escaped_blocks(
+    encode_context &context,
+    const char *begin,
+    const char *end) {
+  while (begin != end) {
+    auto block_end = (std::size_t(end - begin) < escape_block_size ? end : begin + escape_block_size);
+    for (int i = 0; i < 3 && block_end != end && (std::uint8_t(*block_end) & 0xC0) == 0x80; i++) {
+      block_end--;  // do not cut a UTF-8 sequence in two
+    }
+
+    const auto buf = context.reserve(6 * std::size_t(block_end - begin));  // 6 is the length of \u00xx
+    auto out = buf;
+    write_escaped_block(out, begin, block_end);
+    context.advance(out - buf);
+  }
+}
+
 json_force_inline void write_escaped_c(char *&out, const char c) {
   static const char HEX[] = "0123456789ABCDEF";
   static const char POPULAR_CONTROL_CHARACTERS[] = {
@@ -122,6 +167,81 @@ json_force_inline void write_escaped_8(char *&out, const char *&begin) {
   begin += sizeof(blob_8_t);
 }
 
+/**
+ * Write the \uXXXX escape sequence of a UTF-16 code unit.
+ */
+json_force_inline void write_unicode_escaped(char *&out, const unsigned code_unit) {
+  static const char HEX[] = "0123456789ABCDEF";
+  out[0] = '\\';
+  out[1] = 'u';
+  out[2] = HEX[(code_unit >> 12) & 0x0F];
+  out[3] = HEX[(code_unit >> 8) & 0x0F];
+  out[4] = HEX[(code_unit >> 4) & 0x0F];
+  out[5] = HEX[(code_unit & 0x0F)];
+  out += 6;
+}
+
+/**
+ * Like write_escaped_c, but also escape the characters that are special in
+ * HTML, for escape_policy::html_safe.
+ */
+json_force_inline void write_escaped_html_c(char *&out, const char c) {
+  if (json_unlikely(c == '<' || c == '>' || c == '&')) {
+    write_unicode_escaped(out, unsigned(c));
+  } else {
+    write_escaped_c(out, c);
+  }
+}
+
+/**
+ * Write the character at begin, which may be the lead byte of a UTF-8
+ * sequence, for escape_policy::ascii, and advance begin past it. Non-ASCII
+ * characters are written as \uXXXX, or as a surrogate pair above U+FFFF.
+ * Each byte that is not part of a valid sequence is written as \uFFFD.
+ */
+json_force_inline void write_escaped_ascii_c(char *&out, const char *&begin, const char *end) {
+  const auto lead = std::uint8_t(*begin);
+  if (json_likely(lead < 0x80)) {
+    write_escaped_c(out, *(begin++));
+    return;
+  }
+
+  const auto size = utf8_sequence_length(begin, end);
+  const auto expected_size = std::size_t(lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4);
+  if (json_unlikely(size != expected_size)) {
+    write_unicode_escaped(out, 0xFFFD);  // invalid, or cut off by end
+    begin++;
+    return;
+  }
+
+  auto code_point = unsigned(lead & (0xFF >> (size + 1)));
+  for (std::size_t i = 1; i < size; i++) {
+    code_point = (code_point << 6) | (std::uint8_t(begin[i]) & 0x3F);
+  }
+  begin += size;
+
+  if (code_point < 0x10000) {
+    write_unicode_escaped(out, code_point);
+  } else {
+    code_point -= 0x10000;
+    write_unicode_escaped(out, 0xD800 + (code_point >> 10));
+    write_unicode_escaped(out, 0xDC00 + (code_point & 0x3FF));
+  }
+}
+
+/**
+ * Write the character at begin as the policy says, and advance begin past it.
+ * This is the slow path of the kernels of all policies except trusted.
+ */
+template <escape_policy policy>
+json_force_inline void write_escaped_character(char *&out, const char *&begin, const char *end) {
+  switch (policy) {
+    case escape_policy::ascii: write_escaped_ascii_c(out, begin, end); break;
+    case escape_policy::html_safe: write_escaped_html_c(out, *(begin++)); break;
+    default: write_escaped_c(out, *(begin++)); break;
+  }
+}
+
 }  // namespace detail
 }  // namespace json
 }  // namespace spotify
@@ -45,15 +45,13 @@ json_force_inline void write_escaped_16_sse42(char *&out, const __m128i chunk) {
   write_escaped_c(out, _mm_extract_epi8(chunk, 15));
 }
 
-void write_escaped_sse42(
-    encode_context &context,
-    const char *begin,
-    const char *end) {
-  const auto buf = context.reserve(6 * (end - begin));  // 6 is the length of \u00xx
-  auto out = buf;
+namespace {
 
+void write_escaped_block_sse42(char *&out, const char *&begin, const char *end) {
+  // The lengths are explicit, since an implicit length would end the chunk at
+  // its first null character.
   const __m128i ranges = _mm_setr_epi8(
-    0x01, 0x1F,  // control characters
+    0x00, 0x1F,  // control characters
     0x22, 0x22,  // double quotation mark
     0x5C, 0x5C,  // reverse solidus (backslash)
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0
@@ -66,7 +64,7 @@ void write_escaped_sse42(
 
   for (; end - begin >= 16; begin += 16) {
     const __m128i chunk = _mm_load_si128(reinterpret_cast<const __m128i *>(begin));
-    const unsigned has_character_in_ranges = _mm_cmpistrc(ranges, chunk, _SIDD_CMP_RANGES);
+    const unsigned has_character_in_ranges = _mm_cmpestrc(ranges, 6, chunk, 16, _SIDD_CMP_RANGES);
     if (json_likely(!has_character_in_ranges)) {
       _mm_storeu_si128(reinterpret_cast<__m128i *>(out), chunk);
       out += 16;
@@ -79,8 +77,73 @@ void write_escaped_sse42(
   if ((end - begin) >= 4) { write_escaped_4(out, begin); }
   if ((end - begin) >= 2) { write_escaped_2(out, begin); }
   if ((end - begin) >= 1) { write_escaped_1(out, begin); }
+}
+
+/**
+ * The kernel of the policies that escape more than the standard one. Chunks
+ * with characters in the ranges of the policy are written one character at a
+ * time, which may end a few bytes into the next chunk for UTF-8 sequences, so
+ * the chunks are not aligned.
+ */
+template <escape_policy policy>
+void write_escaped_block_sse42(char *&out, const char *&begin, const char *end) {
+  const __m128i ranges = (policy == escape_policy::ascii ?
+      _mm_setr_epi8(
+          0x00, 0x1F,  // control characters
+          0x22, 0x22,  // double quotation mark
+          0x5C, 0x5C,  // reverse solidus (backslash)
+          char(0x80), char(0xFF),  // non-ASCII
+          0, 0, 0, 0, 0, 0, 0, 0) :
+      _mm_setr_epi8(
+          0x00, 0x1F,  // control characters
+          0x22, 0x22,  // double quotation mark
+          0x5C, 0x5C,  // reverse solidus (backslash)
+          0x26, 0x26,  // ampersand
+          0x3C, 0x3C,  // less-than sign
+          0x3E, 0x3E,  // greater-than sign
+          0, 0, 0, 0));
+  const int ranges_size = (policy == escape_policy::ascii ? 8 : 12);
+
+  while (end - begin >= 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+    const unsigned has_character_in_ranges = _mm_cmpestrc(ranges, ranges_size, chunk, 16, _SIDD_CMP_RANGES);
+    if (json_likely(!has_character_in_ranges)) {
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out), chunk);
+      out += 16;
+      begin += 16;
+    } else {
+      for (const auto chunk_end = begin + 16; begin < chunk_end; ) {
+        write_escaped_character<policy>(out, begin, end);
+      }
+    }
+  }
+
+  while (begin != end) {
+    write_escaped_character<policy>(out, begin, end);
+  }
+}
+
+}  // namespace
+
+void write_escaped_sse42(
+    encode_context &context,
+    const char *begin,
+    const char *end) {
+  write_escaped_blocks<write_escaped_block_sse42>(context, begin, end);
+}
 
-  context.advance(out - buf);
+void write_escaped_ascii_sse42(
+    encode_context &context,
+    const char *begin,
+    const char *end) {
+  write_escaped_blocks<write_escaped_block_sse42<escape_policy::ascii>>(context, begin, end);
+}
+
+void write_escaped_html_sse42(
+    encode_context &context,
+    const char *begin,
+    const char *end) {
+  write_escaped_blocks<write_escaped_block_sse42<escape_policy::html_safe>>(context, begin, end);
 }
 
 }  // namespace detail
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/find_element_starts.hpp>
+
+#include <cstdint>
+
+#include <spotify/json/detail/macros.hpp>
+#include <spotify/json/detail/parallel_for.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+/**
+ * Whether the byte at position is escaped, assuming that it is in a string.
+ * Backslashes are only valid in strings, so the run of them before position
+ * decides this.
+ */
+bool is_escaped(const char *begin, const char *position) {
+  auto backslash = position;
+  while (backslash != begin && backslash[-1] == '\\') {
+    backslash--;
+  }
+  return ((position - backslash) & 1) != 0;
+}
+
+/**
+ * The quotes and brackets in a slice. The slice starts either inside or
+ * outside of a string, which is not known yet, so the depth is counted both
+ * for the brackets that have an even number of quotes before them in the
+ * slice (depth[0]), and for those with an odd number (depth[1]).
+ */
+struct slice_summary {
+  slice_summary() : odd_quotes(false), depth{ 0, 0 } {}
+
+  bool odd_quotes;
+  int64_t depth[2];
+};
+
+slice_summary summarize_slice(const char *begin, const char *slice, const char *slice_end) {
+  slice_summary summary;
+  std::size_t quotes = 0;
+  for (auto position = slice; position != slice_end; position++) {
+    switch (*position) {
+      case '"':
+        if (!is_escaped(begin, position)) {
+          quotes++;
+        }
+        break;
+      case '{': case '[': summary.depth[quotes & 1]++; break;
+      case '}': case ']': summary.depth[quotes & 1]--; break;
+      default: break;
+    }
+  }
+  summary.odd_quotes = ((quotes & 1) != 0);
+  return summary;
+}
+
+/**
+ * The start of the first element after position, which is inside a string
+ * or not and at the given depth in the body, or nullptr if there is none.
+ */
+const char *find_element_start(
+    const char *begin,
+    const char *position,
+    const char *end,
+    bool in_string,
+    int64_t depth) {
+  for (; position != end; position++) {
+    const auto c = *position;
+    if (in_string) {
+      in_string = (c != '"' || is_escaped(begin, position));
+      continue;
+    }
+
+    switch (c) {
+      case '"': in_string = true; break;
+      case '{': case '[': depth++; break;
+      case '}': case ']': depth--; break;
+      case ',':
+        if (depth == 0) {
+          position++;
+          while (position != end && (*position == ' ' || *position == '\t' || *position == '\n' || *position == '\r')) {
+            position++;
+          }
+          return position;
+        }
+        break;
+      default: break;
+    }
+  }
+
+  return nullptr;
+}
+
+}  // namespace
+
+std::vector<const char *> find_element_starts(
+    const char *begin,
+    const char *end,
+    const std::size_t slice_size,
+    const std::size_t num_threads) {
+  const auto size = static_cast<std::size_t>(end - begin);
+  const auto num_slices = size / slice_size + 1;
+  const auto slice_begin = [&](const std::size_t i) { return begin + i * slice_size; };
+  const auto slice_end = [&](const std::size_t i) {
+    return (i + 1 == num_slices ? end : slice_begin(i + 1));
+  };
+
+  std::vector<slice_summary> summaries(num_slices);
+  parallel_for(num_slices, num_threads, [&](const std::size_t i) {
+    summaries[i] = summarize_slice(begin, slice_begin(i), slice_end(i));
+  });
+
+  std::vector<bool> in_string(num_slices);
+  std::vector<int64_t> depth(num_slices);
+  for (std::size_t i = 1; i < num_slices; i++) {
+    const auto &summary = summaries[i - 1];
+    in_string[i] = (in_string[i - 1] != summary.odd_quotes);
+    depth[i] = depth[i - 1] + summary.depth[in_string[i - 1] ? 1 : 0];
+  }
+
+  std::vector<const char *> starts(num_slices);
+  starts[0] = begin;
+  parallel_for(num_slices - 1, num_threads, [&](const std::size_t j) {
+    const auto i = j + 1;
+    starts[i] = find_element_start(begin, slice_begin(i), end, in_string[i], depth[i]);
+  });
+
+  // Elements that are longer than a slice make several slices find the same
+  // start, and slices at the end might not find one at all.
+  std::size_t num_starts = 1;
+  for (std::size_t i = 1; i < num_slices; i++) {
+    if (starts[i] && starts[i] > starts[num_starts - 1]) {
+      starts[num_starts++] = starts[i];
+    }
+  }
+  starts.resize(num_starts);
+  return starts;
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER) && defined(json_arch_x86_64)
+#include <intrin.h>
+#endif
+
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * The full 128-bit product of two 64-bit integers, which both the float parser
+ * and the float printer use to scale by 128-bit powers of five.
+ */
+struct uint128 {
+  std::uint64_t low;
+  std::uint64_t high;
+};
+
+json_force_inline uint128 multiply_128(const std::uint64_t a, const std::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  const auto product = static_cast<unsigned __int128>(a) * b;
+  return uint128{ static_cast<std::uint64_t>(product), static_cast<std::uint64_t>(product >> 64) };
+#elif defined(_MSC_VER) && defined(json_arch_x86_64)
+  uint128 product;
+  product.low = _umul128(a, b, &product.high);
+  return product;
+#else
+  const auto a_lo = a & 0xFFFFFFFF;
+  const auto a_hi = a >> 32;
+  const auto b_lo = b & 0xFFFFFFFF;
+  const auto b_hi = b >> 32;
+  const auto lo_lo = a_lo * b_lo;
+  const auto hi_lo = a_hi * b_lo;
+  const auto lo_hi = a_lo * b_hi;
+  const auto hi_hi = a_hi * b_hi;
+  const auto cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+  return uint128{ (cross << 32) | (lo_lo & 0xFFFFFFFF), (hi_lo >> 32) + (cross >> 32) + hi_hi };
+#endif  // defined(__SIZEOF_INT128__)
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/key_index.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+constexpr std::size_t key_index::npos;
+constexpr std::size_t key_index::max_linear_keys;
+
+bool key_index::insert(const std::string &key) {
+  if (find(key) != npos) {
+    return false;
+  }
+
+  const auto index = _keys.size();
+  _keys.push_back(key);
+  _probes.push_back(probe{
+      load_prefix(key.data(), key.size()),
+      static_cast<std::uint32_t>(key.size()),
+      static_cast<std::uint32_t>(index + 1) });
+
+  if (_keys.size() <= max_linear_keys) {
+    return true;
+  }
+
+  // Keep the table at most half full, so that probe sequences stay short.
+  if (_keys.size() * 2 > _slots.size()) {
+    auto num_slots = (_slots.empty() ? std::size_t(max_linear_keys * 4) : _slots.size() * 2);
+    _slots.assign(num_slots, probe{ 0, 0, 0 });
+    for (_slot_shift = 64; num_slots > 1; num_slots /= 2) {
+      _slot_shift--;
+    }
+    for (std::size_t i = 0; i < index; i++) {
+      insert_slot(i);
+    }
+  }
+
+  insert_slot(index);
+  return true;
+}
+
+void key_index::insert_slot(const std::size_t index) {
+  const auto &key = _keys[index];
+  const auto mask = _slots.size() - 1;
+  auto i = slot_of(_probes[index].prefix, key.data(), key.size());
+  while (_slots[i].index) {
+    i = (i + 1) & mask;
+  }
+  _slots[i] = _probes[index];
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
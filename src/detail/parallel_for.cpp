@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/parallel_for.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+std::size_t default_num_threads() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void parallel_for(
+    const std::size_t num_tasks,
+    const std::size_t num_threads,
+    const std::function<void (std::size_t)> &task) {
+  std::atomic<std::size_t> next_task(0);
+  std::atomic<bool> failed(false);
+  std::exception_ptr exception;
+  std::mutex exception_mutex;
+
+  const auto work = [&]{
+    while (!failed.load(std::memory_order_relaxed)) {
+      const auto i = next_task.fetch_add(1, std::memory_order_relaxed);
+      if (i >= num_tasks) {
+        return;
+      }
+
+      try {
+        task(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(exception_mutex);
+        if (!exception) {
+          exception = std::current_exception();
+        }
+        failed.store(true, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  const auto num_workers = std::min(num_threads, num_tasks);
+  for (std::size_t i = 1; i < num_workers; i++) {
+    try {
+      threads.emplace_back(work);
+    } catch (const std::system_error &) {
+      break;  // Make do with the threads that could be started
+    }
+  }
+
+  work();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
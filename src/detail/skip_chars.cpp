@@ -16,9 +16,13 @@
 
 #include <spotify/json/detail/skip_chars.hpp>
 
+#include <cstring>
+
+#include <spotify/json/detail/decode_helpers.hpp>
 #include <spotify/json/detail/macros.hpp>
 
 #include "skip_chars_common.hpp"
+#include "utf8_common.hpp"
 
 namespace spotify {
 namespace json {
@@ -37,6 +41,46 @@ void skip_any_simple_characters_scalar(decode_context &context) {
   done_x: context.position = pos;
 }
 
+void skip_any_simple_characters_utf8_scalar(decode_context &context) {
+  const auto end = context.end;
+  auto pos = context.position;
+
+  while (pos < end) {
+    for (; end - pos >= 8; pos += 8) {
+      std::uint64_t cc;
+      std::memcpy(&cc, pos, 8);
+      if ((cc & 0x8080808080808080ULL) || json_haschar_8(cc, '"') || json_haschar_8(cc, '\\')) {
+        break;
+      }
+    }
+
+    if (pos == end) {
+      break;
+    }
+
+    const auto c = *pos;
+    if (json_likely(!(c & 0x80))) {
+      if (c == '"' || c == '\\') {
+        break;
+      }
+      pos++;
+      continue;
+    }
+
+    const auto size = utf8_sequence_length(pos, end);
+    if (json_unlikely(!size)) {
+      break;
+    }
+    pos += size;
+  }
+
+  context.position = pos;
+}
+
+void fail_invalid_utf8(const decode_context &context) {
+  detail::fail(context, decode_error::invalid_utf8);
+}
+
 void skip_any_whitespace_scalar(decode_context &context) {
   const auto end = context.end;
   auto pos = context.position;
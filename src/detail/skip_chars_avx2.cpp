@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/skip_chars.hpp>
+
+#if defined(json_arch_x86_avx2)
+
+#include <immintrin.h>
+
+#include "skip_chars_common.hpp"
+#include "utf8_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+void skip_any_simple_characters_avx2(decode_context &context) {
+  const auto end = context.end;
+  auto pos = context.position;
+
+  JSON_STRING_SKIP_N_SIMPLE(1,  2, uint8_t,  if, done_x)
+  JSON_STRING_SKIP_N_SIMPLE(2,  4, uint16_t, if, done_2)
+  JSON_STRING_SKIP_N_SIMPLE(4,  8, uint32_t, if, done_4)
+  JSON_STRING_SKIP_N_SIMPLE(8, 32, uint64_t, while, done_8)
+
+  {
+    const auto quote = _mm256_set1_epi8('"');
+    const auto backslash = _mm256_set1_epi8('\\');
+
+    for (; end - pos >= 32; pos += 32) {
+      const auto chunk = _mm256_load_si256(reinterpret_cast<const __m256i *>(pos));
+      const auto is_quote = _mm256_cmpeq_epi8(chunk, quote);
+      const auto is_backslash = _mm256_cmpeq_epi8(chunk, backslash);
+      const auto mask = uint32_t(_mm256_movemask_epi8(_mm256_or_si256(is_quote, is_backslash)));
+      if (mask) {
+        context.position = pos + count_trailing_zeros(mask);
+        return;
+      }
+    }
+  }
+
+          JSON_STRING_SKIP_N_SIMPLE(8, x, uint64_t, while, done_8)
+  done_8: JSON_STRING_SKIP_N_SIMPLE(4, x, uint32_t, while, done_4)
+  done_4: JSON_STRING_SKIP_N_SIMPLE(2, x, uint16_t, while, done_2)
+  done_2: JSON_STRING_SKIP_N_SIMPLE(1, x, uint8_t,  while, done_x)
+  done_x: context.position = pos;
+}
+
+void skip_any_whitespace_avx2(decode_context &context) {
+  const auto end = context.end;
+  auto pos = context.position;
+
+  for (; pos < end && json_unaligned_32(pos); ++pos) {
+    if (!is_space(*pos)) {
+      context.position = pos;
+      return;
+    }
+  }
+
+  // The four whitespace characters have distinct low nibbles (0x0, 0x9, 0xA
+  // and 0xD), so a byte is whitespace iff looking up its low nibble in this
+  // table gives back the byte itself. Bytes with the high bit set are mapped
+  // to zero by the shuffle, which never matches.
+  const auto table = _mm256_setr_epi8(
+      ' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1,
+      ' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1);
+
+  for (; end - pos >= 32; pos += 32) {
+    const auto chunk = _mm256_load_si256(reinterpret_cast<const __m256i *>(pos));
+    const auto whitespace = _mm256_cmpeq_epi8(_mm256_shuffle_epi8(table, chunk), chunk);
+    const auto mask = ~uint32_t(_mm256_movemask_epi8(whitespace));
+    if (mask) {
+      context.position = pos + count_trailing_zeros(mask);
+      return;
+    }
+  }
+
+  while (pos < end && is_space(*pos)) {
+    ++pos;
+  }
+
+  context.position = pos;
+}
+
+namespace {
+
+json_force_inline __m256i load_unaligned(const char *pos) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+}
+
+json_force_inline __m256i load_aligned(const char *pos) {
+  return _mm256_load_si256(reinterpret_cast<const __m256i *>(pos));
+}
+
+json_force_inline const char *align_32(const char *pos) {
+  return reinterpret_cast<const char *>((reinterpret_cast<intptr_t>(pos) + 32) & ~intptr_t(0x1F));
+}
+
+json_force_inline uint32_t find_simple_end(const __m256i chunk) {
+  const auto is_quote = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"'));
+  const auto is_backslash = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\'));
+  return uint32_t(_mm256_movemask_epi8(_mm256_or_si256(is_quote, is_backslash)));
+}
+
+json_force_inline uint32_t find_non_space(const __m256i chunk) {
+  // See skip_any_whitespace_avx2 for a description of the lookup table.
+  const auto table = _mm256_setr_epi8(
+      ' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1,
+      ' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1);
+  return ~uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_shuffle_epi8(table, chunk), chunk)));
+}
+
+template <uint32_t (*find)(__m256i)>
+json_force_inline void skip_any_padded_avx2(decode_context &context) {
+  const auto end = context.end;
+  auto pos = context.position;
+
+  // Read one unaligned chunk, which is all that short strings and whitespace
+  // need, and continue with aligned chunks from the next 32 byte boundary.
+  if (json_likely(pos < end)) {
+    const auto mask = find(load_unaligned(pos));
+    if (mask) {
+      pos += count_trailing_zeros(mask);
+      context.position = (pos < end ? pos : end);
+      return;
+    }
+    pos = align_32(pos);
+  }
+
+  for (; pos < end; pos += 32) {
+    const auto mask = find(load_aligned(pos));
+    if (mask) {
+      pos += count_trailing_zeros(mask);
+      break;
+    }
+  }
+
+  context.position = (pos < end ? pos : end);
+}
+
+}  // namespace
+
+void skip_any_simple_characters_padded_avx2(decode_context &context) {
+  skip_any_padded_avx2<find_simple_end>(context);
+}
+
+void skip_any_whitespace_padded_avx2(decode_context &context) {
+  if (json_likely(context.position < context.end) && !is_space(*context.position)) {
+    return;  // see skip_any_whitespace_padded_avx512bw
+  }
+
+  skip_any_padded_avx2<find_non_space>(context);
+}
+
+namespace {
+
+template <int n>
+json_force_inline __m256i previous_bytes(const __m256i input, const __m256i previous_input) {
+  return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous_input, input, 0x21), 16 - n);
+}
+
+/**
+ * A non-zero byte for each byte of input that can not follow the bytes before
+ * it, see utf8_common.hpp. previous_n is input shifted n bytes, with the n
+ * bytes before input shifted in.
+ */
+json_force_inline __m256i find_utf8_errors(
+    const __m256i input,
+    const __m256i previous_1,
+    const __m256i previous_2,
+    const __m256i previous_3,
+    const __m256i byte_1_high,
+    const __m256i byte_1_low,
+    const __m256i byte_2_high) {
+  const auto low_nibble = _mm256_set1_epi8(0x0F);
+  const auto high_nibble = [&](const __m256i v) { return _mm256_and_si256(_mm256_srli_epi16(v, 4), low_nibble); };
+
+  const auto special_cases = _mm256_and_si256(
+      _mm256_and_si256(
+          _mm256_shuffle_epi8(byte_1_high, high_nibble(previous_1)),
+          _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(previous_1, low_nibble))),
+      _mm256_shuffle_epi8(byte_2_high, high_nibble(input)));
+
+  // Bytes that are two bytes after the lead of a three or four byte sequence,
+  // or three bytes after the lead of a four byte sequence, get their high bit
+  // set. They must be continuation bytes, which special_cases flags as
+  // two_conts, and all other continuation bytes are errors.
+  const auto is_third_byte = _mm256_subs_epu8(previous_2, _mm256_set1_epi8(char(0xE0 - 0x80)));
+  const auto is_fourth_byte = _mm256_subs_epu8(previous_3, _mm256_set1_epi8(char(0xF0 - 0x80)));
+  const auto must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8(char(0x80)));
+  return _mm256_xor_si256(must_be_continuation, special_cases);
+}
+
+json_force_inline __m256i load_table(const std::uint8_t (&table)[16]) {
+  return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(&table[0])));
+}
+
+}  // namespace
+
+void skip_any_simple_characters_utf8_avx2(decode_context &context) {
+  const auto end = context.end;
+  auto pos = context.position;
+
+  const auto byte_1_high = load_table(utf8::byte_1_high);
+  const auto byte_1_low = load_table(utf8::byte_1_low);
+  const auto byte_2_high = load_table(utf8::byte_2_high);
+  const auto quote = _mm256_set1_epi8('"');
+  const auto backslash = _mm256_set1_epi8('\\');
+  const auto zero = _mm256_setzero_si256();
+
+  // The byte before the string (a quote or the end of an escape sequence) is
+  // always ASCII, so the first chunk has nothing to carry over. All ASCII
+  // chunks are the same to find_utf8_errors, so previous_input is not updated
+  // in the fast path.
+  auto previous_input = zero;
+  auto previous_is_ascii = true;
+
+  // Errors in chunks without stops are only looked at once the end of the
+  // string is found, since they are rare, and the string is then validated
+  // again by the scalar implementation to find the first of them.
+  auto errors = zero;
+
+  for (; end - pos >= 32; pos += 32) {
+    // Skip ASCII without anything to stop at, 64 bytes at a time.
+    if (json_likely(previous_is_ascii)) {
+      for (; end - pos >= 64; pos += 64) {
+        const auto chunk_0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+        const auto chunk_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos + 32));
+        const auto special = _mm256_or_si256(
+            _mm256_or_si256(chunk_0, chunk_1),
+            _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk_0, quote), _mm256_cmpeq_epi8(chunk_0, backslash)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk_1, quote), _mm256_cmpeq_epi8(chunk_1, backslash))));
+        if (_mm256_movemask_epi8(special)) {
+          break;
+        }
+      }
+      if (end - pos < 32) {
+        break;
+      }
+    }
+
+    const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+    const auto is_stop = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash));
+    if (json_likely(previous_is_ascii && !_mm256_movemask_epi8(_mm256_or_si256(chunk, is_stop)))) {
+      continue;  // only ASCII, and nothing to stop at
+    }
+
+    const auto stops = std::uint32_t(_mm256_movemask_epi8(is_stop));
+    const auto non_ascii = std::uint32_t(_mm256_movemask_epi8(chunk));
+    if (non_ascii || !previous_is_ascii) {
+      const auto chunk_errors = find_utf8_errors(
+          chunk,
+          previous_bytes<1>(chunk, previous_input),
+          previous_bytes<2>(chunk, previous_input),
+          previous_bytes<3>(chunk, previous_input),
+          byte_1_high,
+          byte_1_low,
+          byte_2_high);
+      if (!stops) {
+        errors = _mm256_or_si256(errors, chunk_errors);
+      } else if (~std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk_errors, zero))) & (stops ^ (stops - 1))) {
+        break;  // an error before (or at) the first stop
+      }
+    }
+
+    if (stops) {
+      if (json_unlikely(!_mm256_testz_si256(errors, errors))) {
+        break;
+      }
+      context.position = pos + count_trailing_zeros(stops);
+      return;
+    }
+
+    previous_input = chunk;
+    previous_is_ascii = !non_ascii;
+  }
+
+  // The rest of the input is shorter than a chunk, so it is validated with the
+  // chunk that ends at the end of the input, and the bytes before that chunk
+  // are loaded rather than carried over. Errors before pos are ignored, since
+  // those bytes have been validated already. Lead bytes before the string can
+  // cause spurious errors, which the scalar implementation then sorts out.
+  const auto remaining = end - pos;
+  if (json_likely(remaining < 32 && _mm256_testz_si256(errors, errors))) {
+    if (remaining == 0) {
+      context.position = end;
+      return;
+    }
+
+    if (json_likely(end - context.begin >= 32 + 3)) {
+      const auto tail = end - 32;
+      const auto shift = 32 - remaining;
+      const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tail));
+      const auto is_stop = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash));
+      const auto stops = (std::uint32_t(_mm256_movemask_epi8(is_stop)) >> shift) | (1u << remaining);
+      const auto non_ascii = std::uint32_t(_mm256_movemask_epi8(chunk)) >> shift;
+      auto error_mask = 0u;
+      if (non_ascii || !previous_is_ascii) {
+        const auto chunk_errors = find_utf8_errors(
+            chunk,
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tail - 1)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tail - 2)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tail - 3)),
+            byte_1_high,
+            byte_1_low,
+            byte_2_high);
+        error_mask = (~std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk_errors, zero)))) >> shift;
+        error_mask &= (stops ^ (stops - 1));
+      }
+      if (json_likely(!error_mask)) {
+        context.position = pos + count_trailing_zeros(stops);
+        return;
+      }
+    }
+  }
+
+  // Short input, and strings with errors, are validated by the scalar
+  // implementation, from the start of the string.
+  skip_any_simple_characters_utf8_scalar(context);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
+
+#endif  // defined(json_arch_x86_avx2)
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/skip_chars.hpp>
+
+#if defined(json_arch_x86_avx512bw)
+
+#include <algorithm>
+
+#include <immintrin.h>
+
+#include "skip_chars_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+/**
+ * Mask selecting the first 'n' bytes of a 64 byte chunk. Masked out bytes are
+ * not read by the masked load instructions, so this is used to read the head
+ * and the tail of the input without reading outside of [position, end).
+ */
+json_force_inline __mmask64 load_mask(const ptrdiff_t n) {
+  return (n >= 64 ? ~__mmask64(0) : (__mmask64(1) << n) - 1);
+}
+
+json_force_inline const char *align_64(const char *pos) {
+  return reinterpret_cast<const char *>((reinterpret_cast<intptr_t>(pos) + 64) & ~intptr_t(0x3F));
+}
+
+json_force_inline __mmask64 find_simple_end(const __mmask64 k, const __m512i chunk) {
+  const auto is_quote = _mm512_mask_cmpeq_epi8_mask(k, chunk, _mm512_set1_epi8('"'));
+  const auto is_backslash = _mm512_mask_cmpeq_epi8_mask(k, chunk, _mm512_set1_epi8('\\'));
+  return (is_quote | is_backslash);
+}
+
+json_force_inline __mmask64 find_non_space(const __mmask64 k, const __m512i chunk) {
+  // See skip_any_whitespace_avx2 for a description of the lookup table.
+  // The table bytes as little-endian 32-bit words, from the last to the first:
+  // -1, -1, '\r', -1 | -1, '\n', '\t', -1 | -1, -1, -1, -1 | -1, -1, -1, ' '
+  const auto table = _mm512_set4_epi32(
+      int(0xFFFF0DFF), int(0xFF0A09FF), int(0xFFFFFFFF), int(0xFFFFFF20));
+  return _mm512_mask_cmpneq_epi8_mask(k, _mm512_shuffle_epi8(table, chunk), chunk);
+}
+
+template <__mmask64 (*find)(__mmask64, __m512i)>
+json_force_inline void skip_any_avx512bw(decode_context &context) {
+  const auto end = context.end;
+  auto pos = context.position;
+  if (json_unlikely(pos == end)) {
+    return;
+  }
+
+  // Read the first (up to) 64 bytes with an unaligned masked load, and then
+  // continue from the next 64 byte boundary. This means that some bytes may
+  // be compared twice, but it avoids having to deal with the head byte by
+  // byte as the SSE 4.2 and AVX2 implementations do.
+  {
+    const auto k = load_mask(end - pos);
+    const auto mask = find(k, _mm512_maskz_loadu_epi8(k, pos));
+    if (mask) {
+      context.position = pos + count_trailing_zeros(uint64_t(mask));
+      return;
+    }
+    pos = std::min(align_64(pos), end);
+  }
+
+  for (; end - pos >= 64; pos += 64) {
+    const auto mask = find(~__mmask64(0), _mm512_load_si512(pos));
+    if (mask) {
+      context.position = pos + count_trailing_zeros(uint64_t(mask));
+      return;
+    }
+  }
+
+  if (pos != end) {
+    const auto k = load_mask(end - pos);
+    const auto mask = find(k, _mm512_maskz_loadu_epi8(k, pos));
+    if (mask) {
+      context.position = pos + count_trailing_zeros(uint64_t(mask));
+      return;
+    }
+  }
+
+  context.position = end;
+}
+
+template <__mmask64 (*find)(__mmask64, __m512i)>
+json_force_inline void skip_any_padded_avx512bw(decode_context &context) {
+  const auto end = context.end;
+  auto pos = context.position;
+
+  // Read one unaligned chunk, which is all that short strings and whitespace
+  // need, and continue with aligned chunks from the next 64 byte boundary.
+  if (json_likely(pos < end)) {
+    const auto mask = find(~__mmask64(0), _mm512_loadu_si512(pos));
+    if (mask) {
+      context.position = std::min(pos + count_trailing_zeros(uint64_t(mask)), end);
+      return;
+    }
+    pos = align_64(pos);
+  }
+
+  for (; pos < end; pos += 64) {
+    const auto mask = find(~__mmask64(0), _mm512_load_si512(pos));
+    if (mask) {
+      pos += count_trailing_zeros(uint64_t(mask));
+      break;
+    }
+  }
+
+  context.position = std::min(pos, end);
+}
+
+}  // namespace
+
+void skip_any_simple_characters_avx512bw(decode_context &context) {
+  skip_any_avx512bw<find_simple_end>(context);
+}
+
+void skip_any_whitespace_avx512bw(decode_context &context) {
+  if (json_likely(context.position < context.end) && !is_space(*context.position)) {
+    return;  // see skip_any_whitespace_padded_avx512bw
+  }
+
+  skip_any_avx512bw<find_non_space>(context);
+}
+
+void skip_any_simple_characters_padded_avx512bw(decode_context &context) {
+  skip_any_padded_avx512bw<find_simple_end>(context);
+}
+
+void skip_any_whitespace_padded_avx512bw(decode_context &context) {
+  // Most runs of whitespace in JSON are empty, which is cheaper to find out by
+  // looking at the first byte than by loading and comparing a whole chunk.
+  if (json_likely(context.position < context.end) && !is_space(*context.position)) {
+    return;
+  }
+
+  skip_any_padded_avx512bw<find_non_space>(context);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
+
+#endif  // defined(json_arch_x86_avx512bw)
@@ -14,6 +14,9 @@
  * the License.
  */
 
+#include <cstdint>
+
+#include <spotify/json/detail/bits.hpp>
 #include <spotify/json/detail/macros.hpp>
 
 #define json_unaligned_x(ignore) true
@@ -21,6 +21,7 @@
 #include <nmmintrin.h>
 
 #include "skip_chars_common.hpp"
+#include "utf8_common.hpp"
 
 namespace spotify {
 namespace json {
@@ -88,6 +89,209 @@ void skip_any_whitespace_sse42(decode_context &context) {
   context.position = pos;
 }
 
+namespace {
+
+json_force_inline const char *align_16(const char *pos) {
+  return reinterpret_cast<const char *>((reinterpret_cast<intptr_t>(pos) + 16) & ~intptr_t(0xF));
+}
+
+template <int flags>
+json_force_inline void skip_any_padded_sse42(decode_context &context, const __m128i chars) {
+  const auto end = context.end;
+  auto pos = context.position;
+
+  // Read one unaligned chunk, which is all that short strings and whitespace
+  // need, and continue with aligned chunks from the next 16 byte boundary.
+  if (json_likely(pos < end)) {
+    const auto index = _mm_cmpistri(chars, _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos)), flags);
+    if (index != 16) {
+      pos += index;
+      context.position = (pos < end ? pos : end);
+      return;
+    }
+    pos = align_16(pos);
+  }
+
+  for (; pos < end; pos += 16) {
+    const auto index = _mm_cmpistri(chars, _mm_load_si128(reinterpret_cast<const __m128i *>(pos)), flags);
+    if (index != 16) {
+      pos += index;
+      break;
+    }
+  }
+
+  context.position = (pos < end ? pos : end);
+}
+
+}  // namespace
+
+void skip_any_simple_characters_padded_sse42(decode_context &context) {
+  alignas(16) static const char CHARS[16] = "\"\\";
+  const auto chars = _mm_load_si128(reinterpret_cast<const __m128i *>(&CHARS[0]));
+  constexpr auto flags = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_POSITIVE_POLARITY | _SIDD_LEAST_SIGNIFICANT;
+  skip_any_padded_sse42<flags>(context, chars);
+}
+
+void skip_any_whitespace_padded_sse42(decode_context &context) {
+  if (json_likely(context.position < context.end) && !is_space(*context.position)) {
+    return;  // see skip_any_whitespace_padded_avx512bw
+  }
+
+  alignas(16) static const char CHARS[16] = " \t\n\r";
+  const auto chars = _mm_load_si128(reinterpret_cast<const __m128i *>(&CHARS[0]));
+  constexpr auto flags = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_NEGATIVE_POLARITY | _SIDD_LEAST_SIGNIFICANT;
+  skip_any_padded_sse42<flags>(context, chars);
+}
+
+namespace {
+
+template <int n>
+json_force_inline __m128i previous_bytes(const __m128i input, const __m128i previous_input) {
+  return _mm_alignr_epi8(input, previous_input, 16 - n);
+}
+
+/**
+ * A non-zero byte for each byte of input that can not follow the bytes before
+ * it, see utf8_common.hpp. previous_n is input shifted n bytes, with the n
+ * bytes before input shifted in.
+ */
+json_force_inline __m128i find_utf8_errors(
+    const __m128i input,
+    const __m128i previous_1,
+    const __m128i previous_2,
+    const __m128i previous_3,
+    const __m128i byte_1_high,
+    const __m128i byte_1_low,
+    const __m128i byte_2_high) {
+  const auto low_nibble = _mm_set1_epi8(0x0F);
+  const auto high_nibble = [&](const __m128i v) { return _mm_and_si128(_mm_srli_epi16(v, 4), low_nibble); };
+
+  const auto special_cases = _mm_and_si128(
+      _mm_and_si128(
+          _mm_shuffle_epi8(byte_1_high, high_nibble(previous_1)),
+          _mm_shuffle_epi8(byte_1_low, _mm_and_si128(previous_1, low_nibble))),
+      _mm_shuffle_epi8(byte_2_high, high_nibble(input)));
+
+  // Bytes that are two bytes after the lead of a three or four byte sequence,
+  // or three bytes after the lead of a four byte sequence, get their high bit
+  // set. They must be continuation bytes, which special_cases flags as
+  // two_conts, and all other continuation bytes are errors.
+  const auto is_third_byte = _mm_subs_epu8(previous_2, _mm_set1_epi8(char(0xE0 - 0x80)));
+  const auto is_fourth_byte = _mm_subs_epu8(previous_3, _mm_set1_epi8(char(0xF0 - 0x80)));
+  const auto must_be_continuation = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(char(0x80)));
+  return _mm_xor_si128(must_be_continuation, special_cases);
+}
+
+json_force_inline __m128i load_table(const std::uint8_t (&table)[16]) {
+  return _mm_load_si128(reinterpret_cast<const __m128i *>(&table[0]));
+}
+
+}  // namespace
+
+void skip_any_simple_characters_utf8_sse42(decode_context &context) {
+  const auto end = context.end;
+  auto pos = context.position;
+
+  const auto byte_1_high = load_table(utf8::byte_1_high);
+  const auto byte_1_low = load_table(utf8::byte_1_low);
+  const auto byte_2_high = load_table(utf8::byte_2_high);
+  const auto quote = _mm_set1_epi8('"');
+  const auto backslash = _mm_set1_epi8('\\');
+  const auto zero = _mm_setzero_si128();
+
+  // The byte before the string (a quote or the end of an escape sequence) is
+  // always ASCII, so the first chunk has nothing to carry over. All ASCII
+  // chunks are the same to find_utf8_errors, so previous_input is not updated
+  // in the fast path.
+  auto previous_input = zero;
+  auto previous_is_ascii = true;
+
+  // Errors in chunks without stops are only looked at once the end of the
+  // string is found, since they are rare, and the string is then validated
+  // again by the scalar implementation to find the first of them.
+  auto errors = zero;
+
+  for (; end - pos >= 16; pos += 16) {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+    const auto is_stop = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+    if (json_likely(previous_is_ascii && !_mm_movemask_epi8(_mm_or_si128(chunk, is_stop)))) {
+      continue;  // only ASCII, and nothing to stop at
+    }
+
+    const auto stops = std::uint32_t(_mm_movemask_epi8(is_stop));
+    const auto non_ascii = std::uint32_t(_mm_movemask_epi8(chunk));
+    if (non_ascii || !previous_is_ascii) {
+      const auto chunk_errors = find_utf8_errors(
+          chunk,
+          previous_bytes<1>(chunk, previous_input),
+          previous_bytes<2>(chunk, previous_input),
+          previous_bytes<3>(chunk, previous_input),
+          byte_1_high,
+          byte_1_low,
+          byte_2_high);
+      if (!stops) {
+        errors = _mm_or_si128(errors, chunk_errors);
+      } else if (~std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk_errors, zero))) & (stops ^ (stops - 1))) {
+        break;  // an error before (or at) the first stop
+      }
+    }
+
+    if (stops) {
+      if (json_unlikely(!_mm_testz_si128(errors, errors))) {
+        break;
+      }
+      context.position = pos + count_trailing_zeros(stops);
+      return;
+    }
+
+    previous_input = chunk;
+    previous_is_ascii = !non_ascii;
+  }
+
+  // The rest of the input is shorter than a chunk, so it is validated with the
+  // chunk that ends at the end of the input, and the bytes before that chunk
+  // are loaded rather than carried over. Errors before pos are ignored, since
+  // those bytes have been validated already. Lead bytes before the string can
+  // cause spurious errors, which the scalar implementation then sorts out.
+  const auto remaining = end - pos;
+  if (json_likely(remaining < 16 && _mm_testz_si128(errors, errors))) {
+    if (remaining == 0) {
+      context.position = end;
+      return;
+    }
+
+    if (json_likely(end - context.begin >= 16 + 3)) {
+      const auto tail = end - 16;
+      const auto shift = 16 - remaining;
+      const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tail));
+      const auto is_stop = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+      const auto stops = (std::uint32_t(_mm_movemask_epi8(is_stop)) >> shift) | (1u << remaining);
+      const auto non_ascii = std::uint32_t(_mm_movemask_epi8(chunk)) >> shift;
+      auto error_mask = 0u;
+      if (non_ascii || !previous_is_ascii) {
+        const auto chunk_errors = find_utf8_errors(
+            chunk,
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(tail - 1)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(tail - 2)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(tail - 3)),
+            byte_1_high,
+            byte_1_low,
+            byte_2_high);
+        error_mask = (~std::uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk_errors, zero))) & 0xFFFF) >> shift;
+        error_mask &= (stops ^ (stops - 1));
+      }
+      if (json_likely(!error_mask)) {
+        context.position = pos + count_trailing_zeros(stops);
+        return;
+      }
+    }
+  }
+
+  // Short input, and strings with errors, are validated by the scalar
+  // implementation, from the start of the string.
+  skip_any_simple_characters_utf8_scalar(context);
+}
+
 }  // namespace detail
 }  // namespace json
 }  // namespace spotify
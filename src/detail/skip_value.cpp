@@ -22,6 +22,8 @@
 #include <spotify/json/detail/macros.hpp>
 #include <spotify/json/detail/stack.hpp>
 
+#include "skip_value_common.hpp"
+
 namespace spotify {
 namespace json {
 namespace detail {
@@ -35,46 +37,150 @@ json_force_inline bool is_hex_digit(const char c) {
   return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
 }
 
-void skip_unicode_escape(decode_context &context) {
-  require_bytes<4>(context, "\\u must be followed by 4 hex digits");
+/**
+ * The value of the four hex digits at position, which must have been
+ * validated with is_hex_digit.
+ */
+json_force_inline unsigned parse_code_unit(const char *position) {
+  unsigned code_unit = 0;
+  for (int i = 0; i < 4; i++) {
+    const auto c = position[i];
+    code_unit = (code_unit << 4) | unsigned(c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10);
+  }
+  return code_unit;
+}
+
+/**
+ * Record an error at context.offset(d). Always returns false, so that failing
+ * is a matter of 'return set_error(...)'.
+ */
+json_never_inline bool set_error(
+    decode_error &error,
+    const decode_context &context,
+    const decode_error::code_type code,
+    const ptrdiff_t d = 0) {
+  error = decode_error(code, context.offset(d));
+  return false;
+}
+
+json_force_inline bool skip_1(decode_context &context, decode_error &error, const char character) {
+  if (json_unlikely(!context.remaining())) {
+    return set_error(error, context, decode_error::unexpected_end_of_input);
+  }
+  if (json_unlikely(next_unchecked(context) != character)) {
+    return set_error(error, context, decode_error::unexpected_input, -1);
+  }
+  return true;
+}
+
+json_force_inline bool skip_4(decode_context &context, decode_error &error, const char characters[4]) {
+  if (json_unlikely(context.remaining() < 4)) {
+    return set_error(error, context, decode_error::unexpected_end_of_input);
+  }
+  if (json_unlikely(memcmp(characters, context.position, 4))) {
+    return set_error(error, context, decode_error::unexpected_input);
+  }
+  context.position += 4;
+  return true;
+}
+
+/**
+ * In strict UTF-8 mode, check that the \u escape sequence that was just
+ * skipped is not a surrogate, or is a high surrogate that is followed by an
+ * escaped low surrogate, which is then skipped too.
+ */
+json_never_inline bool skip_surrogate_pair(decode_context &context, decode_error &error) {
+  const auto code_unit = parse_code_unit(context.position - 4);
+  if (json_likely(code_unit < 0xD800 || code_unit > 0xDFFF)) {
+    return true;
+  }
+
+  if (code_unit <= 0xDBFF &&
+      context.remaining() >= 6 &&
+      context.position[0] == '\\' &&
+      context.position[1] == 'u' &&
+      is_hex_digit(context.position[2]) &&
+      is_hex_digit(context.position[3]) &&
+      is_hex_digit(context.position[4]) &&
+      is_hex_digit(context.position[5])) {
+    const auto low = parse_code_unit(context.position + 2);
+    if (low >= 0xDC00 && low <= 0xDFFF) {
+      context.position += 6;
+      return true;
+    }
+  }
+
+  return set_error(error, context, decode_error::unpaired_surrogate, -6);
+}
+
+bool skip_unicode_escape(decode_context &context, decode_error &error) {
+  if (json_unlikely(context.remaining() < 4)) {
+    return set_error(error, context, decode_error::invalid_unicode_escape);
+  }
   const bool h0 = is_hex_digit(*(context.position++));
   const bool h1 = is_hex_digit(*(context.position++));
   const bool h2 = is_hex_digit(*(context.position++));
   const bool h3 = is_hex_digit(*(context.position++));
-  fail_if(context, !(h0 && h1 && h2 && h3), "\\u must be followed by 4 hex digits");
+  if (json_unlikely(!(h0 && h1 && h2 && h3))) {
+    return set_error(error, context, decode_error::invalid_unicode_escape);
+  }
+  if (json_unlikely(context.strict_utf8)) {
+    return skip_surrogate_pair(context, error);
+  }
+  return true;
 }
 
-void skip_escape(decode_context &context) {
-  switch (next(context, "Unterminated string")) {
-    case '"':  break;
-    case '/':  break;
-    case 'b':  break;
-    case 'f':  break;
-    case 'n':  break;
-    case 'r':  break;
-    case 't':  break;
-    case '\\': break;
-    case 'u': skip_unicode_escape(context); break;
-    default: detail::fail(context, "Invalid escape character", -1);
+bool skip_escape(decode_context &context, decode_error &error) {
+  if (json_unlikely(!context.remaining())) {
+    return set_error(error, context, decode_error::unterminated_string);
+  }
+
+  switch (next_unchecked(context)) {
+    case '"':  return true;
+    case '/':  return true;
+    case 'b':  return true;
+    case 'f':  return true;
+    case 'n':  return true;
+    case 'r':  return true;
+    case 't':  return true;
+    case '\\': return true;
+    case 'u': return skip_unicode_escape(context, error);
+    default: return set_error(error, context, decode_error::invalid_escape_character, -1);
   }
 }
 
-void skip_string(decode_context &context) {
-  skip_1(context, '"');
+}  // namespace
+
+bool skip_string(decode_context &context, decode_error &error) {
+  if (json_unlikely(!skip_1(context, error, '"'))) {
+    return false;
+  }
 
   while (json_likely(context.remaining())) {
-    detail::skip_any_simple_characters(context);
-    switch (next(context, "Unterminated string")) {
-      case '"': return;
-      case '\\': skip_escape(context); break;
+    if (json_unlikely(!detail::try_skip_any_simple_characters(context))) {
+      return set_error(error, context, decode_error::invalid_utf8);
+    }
+    if (json_unlikely(!context.remaining())) {
+      break;
+    }
+
+    switch (next_unchecked(context)) {
+      case '"': return true;
+      case '\\':
+        if (json_unlikely(!skip_escape(context, error))) {
+          return false;
+        }
+        break;
       default: json_unreachable();
     }
   }
 
-  detail::fail(context, "Unterminated string");
+  return set_error(error, context, decode_error::unterminated_string);
 }
 
-void skip_number(decode_context &context) {
+namespace {
+
+bool skip_number(decode_context &context, decode_error &error) {
   // Parse negative sign
   if (peek(context) == '-') {
     ++context.position;
@@ -84,14 +190,18 @@ void skip_number(decode_context &context) {
   if (peek(context) == '0') {
     ++context.position;
   } else {
-    fail_if(context, !is_digit(peek(context)), "Expected digit");
+    if (json_unlikely(!is_digit(peek(context)))) {
+      return set_error(error, context, decode_error::expected_digit);
+    }
     do { ++context.position; } while (is_digit(peek(context)));
   }
 
   // Parse fractional part
   if (peek(context) == '.') {
     ++context.position;
-    fail_if(context, !is_digit(peek(context)), "Expected digit after decimal point");
+    if (json_unlikely(!is_digit(peek(context)))) {
+      return set_error(error, context, decode_error::expected_digit_after_decimal_point);
+    }
     do { ++context.position; } while (is_digit(peek(context)));
   }
 
@@ -104,35 +214,39 @@ void skip_number(decode_context &context) {
       ++context.position;
     }
 
-    fail_if(context, !is_digit(peek(context)), "Expected digit after exponent sign");
+    if (json_unlikely(!is_digit(peek(context)))) {
+      return set_error(error, context, decode_error::expected_digit_after_exponent_sign);
+    }
     do { ++context.position; } while (is_digit(peek(context)));
   }
+
+  return true;
 }
 
+}  // namespace
+
 /**
  * Advance past one simple JSON value, that is any value that is not an object
- * {} or an array []. If parsing fails, context will be set to that it has
- * failed. If parsing suceeds, context.position will point to the character
- * after the last character of the JSON object that was parsed.
- *
- * context.has_failed() must be false when this function is called.
+ * {} or an array []. If parsing fails, false is returned and error is set. If
+ * parsing suceeds, context.position will point to the character after the last
+ * character of the JSON object that was parsed.
  */
-void skip_simple_value(decode_context &context) {
+bool skip_simple_value(decode_context &context, decode_error &error) {
   switch (peek(context)) {
     case '-':  // fallthrough
     case '0': case '1': case '2': case '3': case '4':  // fallthrough
-    case '5': case '6': case '7': case '8': case '9': skip_number(context); break;
-    case '"': skip_string(context); break;
-    case 'f': skip_false(context); break;
-    case 't': skip_true(context); break;
-    case 'n': skip_null(context); break;
-    default: fail(context, std::string("Encountered token '") + peek(context) + "'");
+    case '5': case '6': case '7': case '8': case '9': return skip_number(context, error);
+    case '"': return skip_string(context, error);
+    case 'f': context.position++; return skip_4(context, error, "alse");
+    case 't': return skip_4(context, error, "true");
+    case 'n': return skip_4(context, error, "null");
+    default:
+      error = decode_error(decode_error::unexpected_token, context.offset(), peek(context));
+      return false;
   }
 }
 
-}  // namespace
-
-void skip_value(decode_context &context) {
+bool try_skip_value_scalar(decode_context &context, decode_error &error) {
   enum state {
     done = 0,
     want = 1 << 0,
@@ -172,9 +286,13 @@ void skip_value(decode_context &context) {
     }
 
     if (c == '"' && (pstate & read_key)) {
-      skip_string(context);
+      if (json_unlikely(!skip_string(context, error))) {
+        return false;
+      }
       skip_any_whitespace(context);
-      skip_1(context, ':');
+      if (json_unlikely(!skip_1(context, error, ':'))) {
+        return false;
+      }
       pstate = need_val;
       continue;
     }
@@ -187,10 +305,14 @@ void skip_value(decode_context &context) {
       continue;
     }
 
-    fail_if(context, pstate & read_key, "Expected '\"'");
-    fail_if(context, pstate & read_sep, inside == '{' ?
-        "Expected ',' or '}'" :
-        "Expected ',' or ']");
+    if (json_unlikely(pstate & read_key)) {
+      return set_error(error, context, decode_error::expected_quote);
+    }
+    if (json_unlikely(pstate & read_sep)) {
+      return set_error(error, context, inside == '{' ?
+          decode_error::expected_comma_or_closing_brace :
+          decode_error::expected_comma_or_closing_bracket);
+    }
 
     if (c == '{' || c == '[') {
       skip_unchecked_1(context);
@@ -201,14 +323,82 @@ void skip_value(decode_context &context) {
       continue;
     }
 
-    skip_simple_value(context);
+    if (json_unlikely(!skip_simple_value(context, error))) {
+      return false;
+    }
     pstate = (inside ? want_sep : done);
   }
 
-  fail_if(context, inside == '{', "Expected '}'");
-  fail_if(context, inside == '[', "Expected ']'");
-  fail_if(context, pstate != done, "Unexpected EOF");
+  if (json_unlikely(inside == '{')) {
+    return set_error(error, context, decode_error::expected_closing_brace);
+  }
+  if (json_unlikely(inside == '[')) {
+    return set_error(error, context, decode_error::expected_closing_bracket);
+  }
+  if (json_unlikely(pstate != done)) {
+    return set_error(error, context, decode_error::unexpected_eof);
+  }
+  return true;
+}
+
+void skip_value_scalar(decode_context &context) {
+  decode_error error;
+  if (json_unlikely(!try_skip_value_scalar(context, error))) {
+    error.raise();
+  }
+}
+
+namespace {
+
+/**
+ * Skip objects and arrays with the given structural index implementation, and
+ * everything else with the scalar implementation. The structural index gives
+ * up on all invalid (and some unusual) input, which is then skipped again by
+ * the scalar implementation so that the error is reported exactly as before.
+ */
+json_force_inline bool skip_value_structural(
+    decode_context &context,
+    decode_error &error,
+    bool (&skip_container_kernel)(decode_context &context)) {
+  const auto c = peek(context);
+  if (c == '{' || c == '[') {
+    const auto original_position = context.position;
+    if (json_likely(skip_container_kernel(context))) {
+      return true;
+    }
+    context.position = original_position;
+  }
+
+  return try_skip_value_scalar(context, error);
+}
+
+}  // namespace
+
+#if defined(json_arch_x86_avx2)
+bool try_skip_value_avx2(decode_context &context, decode_error &error) {
+  return skip_value_structural(context, error, skip_container_avx2);
+}
+
+void skip_value_avx2(decode_context &context) {
+  decode_error error;
+  if (json_unlikely(!try_skip_value_avx2(context, error))) {
+    error.raise();
+  }
+}
+#endif  // defined(json_arch_x86_avx2)
+
+#if defined(json_arch_x86_avx512bw)
+bool try_skip_value_avx512bw(decode_context &context, decode_error &error) {
+  return skip_value_structural(context, error, skip_container_avx512bw);
+}
+
+void skip_value_avx512bw(decode_context &context) {
+  decode_error error;
+  if (json_unlikely(!try_skip_value_avx512bw(context, error))) {
+    error.raise();
+  }
 }
+#endif  // defined(json_arch_x86_avx512bw)
 
 }  // namespace detail
 }  // namespace json
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/macros.hpp>
+
+#if defined(json_arch_x86_avx2)
+
+#include <immintrin.h>
+
+#include "skip_value_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+struct avx2 {
+  static json_force_inline uint64_t movemask(const __m256i lo, const __m256i hi) {
+    return uint64_t(uint32_t(_mm256_movemask_epi8(lo))) | (uint64_t(uint32_t(_mm256_movemask_epi8(hi))) << 32);
+  }
+
+  static json_force_inline __m256i operators(const __m256i chunk) {
+    // '[' and ']' differ from '{' and '}' only in bit 5, so setting it leaves
+    // two comparisons for the four brackets.
+    const auto folded = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+    return _mm256_or_si256(
+        _mm256_or_si256(
+            _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')),
+            _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'))),
+        _mm256_or_si256(
+            _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(',')),
+            _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(':'))));
+  }
+
+  static json_force_inline __m256i whitespace(const __m256i chunk) {
+    // See skip_any_whitespace_avx2 for a description of the lookup table.
+    const auto table = _mm256_setr_epi8(
+        ' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1,
+        ' ', -1, -1, -1, -1, -1, -1, -1, -1, '\t', '\n', -1, -1, '\r', -1, -1);
+    return _mm256_cmpeq_epi8(_mm256_shuffle_epi8(table, chunk), chunk);
+  }
+
+  static json_force_inline structural_block classify(const char *pos) {
+    const auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+    const auto hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos + 32));
+    const auto quote = _mm256_set1_epi8('"');
+    const auto backslash = _mm256_set1_epi8('\\');
+
+    structural_block block;
+    block.quotes = movemask(_mm256_cmpeq_epi8(lo, quote), _mm256_cmpeq_epi8(hi, quote));
+    block.backslashes = movemask(_mm256_cmpeq_epi8(lo, backslash), _mm256_cmpeq_epi8(hi, backslash));
+    block.operators = movemask(operators(lo), operators(hi));
+    block.whitespace = movemask(whitespace(lo), whitespace(hi));
+    return block;
+  }
+
+  static json_force_inline uint64_t prefix_xor(const uint64_t bits) {
+#if defined(json_arch_x86_64)
+    // Carry-less multiplication by all ones XORs each bit into all higher bits.
+    const auto product = _mm_clmulepi64_si128(
+        _mm_set_epi64x(0, static_cast<int64_t>(bits)), _mm_set1_epi8(-1), 0);
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(product));
+#else
+    return prefix_xor_portable(bits);
+#endif  // defined(json_arch_x86_64)
+  }
+};
+
+}  // namespace
+
+bool skip_container_avx2(decode_context &context) {
+  return skip_container<avx2>(context);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
+
+#endif  // defined(json_arch_x86_avx2)
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/macros.hpp>
+
+#if defined(json_arch_x86_avx512bw)
+
+#include <immintrin.h>
+
+#include "skip_value_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+struct avx512bw {
+  static json_force_inline structural_block classify(const char *pos) {
+    const auto chunk = _mm512_loadu_si512(pos);
+
+    // See the AVX2 implementation for the bracket folding and skip_any_whitespace_avx2
+    // for a description of the whitespace lookup table.
+    const auto folded = _mm512_or_si512(chunk, _mm512_set1_epi8(0x20));
+    // The table bytes as little-endian 32-bit words, from the last to the first:
+    // -1, -1, '\r', -1 | -1, '\n', '\t', -1 | -1, -1, -1, -1 | -1, -1, -1, ' '
+    const auto table = _mm512_set4_epi32(
+        int(0xFFFF0DFF), int(0xFF0A09FF), int(0xFFFFFFFF), int(0xFFFFFF20));
+
+    structural_block block;
+    block.quotes = _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('"'));
+    block.backslashes = _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8('\\'));
+    block.operators =
+        _mm512_cmpeq_epi8_mask(folded, _mm512_set1_epi8('{')) |
+        _mm512_cmpeq_epi8_mask(folded, _mm512_set1_epi8('}')) |
+        _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8(',')) |
+        _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8(':'));
+    block.whitespace = _mm512_cmpeq_epi8_mask(_mm512_shuffle_epi8(table, chunk), chunk);
+    return block;
+  }
+
+  static json_force_inline uint64_t prefix_xor(const uint64_t bits) {
+#if defined(json_arch_x86_64)
+    // Carry-less multiplication by all ones XORs each bit into all higher bits.
+    const auto product = _mm_clmulepi64_si128(
+        _mm_set_epi64x(0, static_cast<int64_t>(bits)), _mm_set1_epi8(-1), 0);
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(product));
+#else
+    return prefix_xor_portable(bits);
+#endif  // defined(json_arch_x86_64)
+  }
+};
+
+}  // namespace
+
+bool skip_container_avx512bw(decode_context &context) {
+  return skip_container<avx512bw>(context);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
+
+#endif  // defined(json_arch_x86_avx512bw)
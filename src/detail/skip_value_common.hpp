@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/decode_error.hpp>
+#include <spotify/json/detail/macros.hpp>
+
+#include "skip_chars_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * Validate and skip a string, or a value that is neither an object nor an
+ * array. These are defined in skip_value.cpp, which is compiled for the
+ * baseline instruction set, and return false and set error on invalid input.
+ */
+bool skip_string(decode_context &context, decode_error &error);
+bool skip_simple_value(decode_context &context, decode_error &error);
+
+/**
+ * Skip an object or an array using the structural index, see skip_container
+ * below. Returns false, with an unspecified context.position, if the value
+ * could not be skipped this way. The caller must then fall back to the
+ * scalar implementation, which also produces the error message.
+ */
+#if defined(json_arch_x86_avx2)
+bool skip_container_avx2(decode_context &context);
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_avx512bw)
+bool skip_container_avx512bw(decode_context &context);
+#endif  // defined(json_arch_x86_avx512bw)
+
+// The code below is compiled once per instruction set, in translation units
+// with different compiler flags, so it must have internal linkage. Otherwise
+// the linker would be free to pick, say, the AVX-512 copy for all callers.
+namespace {
+
+/**
+ * Character classes of a 64 byte block, with one bit per byte. Bit 0 is the
+ * first byte of the block.
+ */
+struct structural_block {
+  uint64_t quotes;
+  uint64_t backslashes;
+  uint64_t operators;  // {}[],:
+  uint64_t whitespace;
+};
+
+json_force_inline uint64_t prefix_xor_portable(uint64_t bits) {
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+json_force_inline bool is_token_delimiter(const char c) {
+  switch (c) {
+    case ' ': case '\t': case '\n': case '\r':
+    case '{': case '}': case '[': case ']': case ',': case ':': case '"':
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Finds the tokens of a JSON document 64 bytes at a time. The simd parameter
+ * provides classify(const char *), which computes the structural_block of 64
+ * bytes, and prefix_xor(uint64_t), which computes for each bit the XOR of it
+ * and all lower bits (the bits that are inside strings, given the quotes).
+ *
+ * Tokens are the operators and opening quotes outside of strings, and the first
+ * byte of every other run of non-whitespace characters outside of strings (the
+ * numbers and literals, or garbage). Nothing else has to be looked at one byte
+ * at a time to validate the document, except for strings that have escapes.
+ */
+template <typename simd>
+class structural_scanner {
+ public:
+  structural_scanner(const char *begin, const char *end, const bool padded)
+      : _block(begin),
+        _end(end),
+        _padded(padded),
+        _escaped_carry(0),
+        _in_string_carry(0),
+        _scalar_carry(0) {
+    classify();
+  }
+
+  /**
+   * The next token, or nullptr if the input ends before there is one.
+   */
+  json_force_inline const char *next_token() {
+    while (json_unlikely(!_tokens)) {
+      if (!next_block()) {
+        return nullptr;
+      }
+    }
+    return consume(count_trailing_zeros(_tokens));
+  }
+
+  /**
+   * The closing quote of the string that was opened by the last token, or
+   * nullptr if the string is unterminated. has_backslash is set if there are
+   * escape sequences in the string, which then need to be validated.
+   */
+  json_force_inline const char *closing_quote(bool &has_backslash) {
+    has_backslash = false;
+    while (json_unlikely(!_closing_quotes)) {
+      has_backslash |= (_backslashes != 0);
+      if (!next_block()) {
+        return nullptr;
+      }
+    }
+
+    const auto index = count_trailing_zeros(_closing_quotes);
+    has_backslash |= ((_backslashes & ((uint64_t(1) << index) - 1)) != 0);
+    return consume(index);
+  }
+
+ private:
+  json_force_inline const char *consume(const unsigned index) {
+    const auto above = ~uint64_t(1) << index;
+    _tokens &= above;
+    _closing_quotes &= above;
+    _backslashes &= above;
+    return _block + index;
+  }
+
+  bool next_block() {
+    if (_end - _block <= 64) {
+      return false;
+    }
+
+    _block += 64;
+    classify();
+    return true;
+  }
+
+  void classify() {
+    const auto size = _end - _block;
+    structural_block block;
+    if (json_likely(size >= 64 || _padded)) {
+      block = simd::classify(_block);
+    } else {
+      // Pad the last block with whitespace, which never produces a token.
+      char buffer[64];
+      std::memset(buffer, ' ', sizeof(buffer));
+      std::memcpy(buffer, _block, static_cast<std::size_t>(size));
+      block = simd::classify(buffer);
+    }
+
+    // Bytes past the end can only affect the bits of later bytes, which are
+    // masked out here, because the carries all go from lower to higher bits.
+    const auto valid = (size >= 64 ? ~uint64_t(0) : (uint64_t(1) << size) - 1);
+
+    const auto quotes = block.quotes & ~find_escaped(block.backslashes);
+    const auto in_string = simd::prefix_xor(quotes) ^ _in_string_carry;
+    _in_string_carry = uint64_t(0) - (in_string >> 63);
+
+    const auto outside = ~in_string;
+    const auto scalars = ~(block.operators | block.whitespace | quotes) & outside;
+    const auto scalar_starts = scalars & ~((scalars << 1) | _scalar_carry);
+    _scalar_carry = scalars >> 63;
+
+    _tokens = ((block.operators & outside) | (quotes & in_string) | scalar_starts) & valid;
+    _closing_quotes = quotes & outside & valid;
+    _backslashes = block.backslashes & in_string & valid;
+  }
+
+  /**
+   * The bytes that follow an odd number of backslashes. Backslashes are rare
+   * enough that walking them one by one is cheaper than the branch-free way.
+   */
+  json_force_inline uint64_t find_escaped(uint64_t backslashes) {
+    auto escaped = _escaped_carry;
+    _escaped_carry = 0;
+    backslashes &= ~escaped;
+
+    while (json_unlikely(backslashes)) {
+      const auto index = count_trailing_zeros(backslashes);
+      if (index == 63) {
+        _escaped_carry = 1;
+        break;
+      }
+
+      escaped |= uint64_t(2) << index;
+      backslashes &= ~(uint64_t(3) << index);
+    }
+
+    return escaped;
+  }
+
+  const char *_block;
+  const char * const _end;
+  const bool _padded;
+  uint64_t _tokens;
+  uint64_t _closing_quotes;
+  uint64_t _backslashes;
+  uint64_t _escaped_carry;
+  uint64_t _in_string_carry;
+  uint64_t _scalar_carry;
+};
+
+template <typename simd>
+json_force_inline bool skip_string_token(
+    structural_scanner<simd> &scanner,
+    decode_context &context,
+    decode_error &error,
+    const char *opening_quote) {
+  bool has_backslash;
+  const auto closing_quote = scanner.closing_quote(has_backslash);
+  if (json_unlikely(!closing_quote)) {
+    return false;
+  }
+
+  if (json_unlikely(has_backslash)) {
+    context.position = opening_quote;
+    return skip_string(context, error) && (context.position == closing_quote + 1);
+  }
+
+  return true;
+}
+
+/**
+ * Skip the object or array at context.position by walking its tokens with the
+ * same state machine as skip_value_scalar. The strings and scalars are checked
+ * with the same validators, so exactly the same documents are accepted. Any
+ * document that is rejected, or nested more than 64 levels deep, is left to
+ * the scalar implementation.
+ */
+template <typename simd>
+bool skip_container(decode_context &context) {
+  enum state {
+    done = 0,
+    want = 1 << 0,
+    need = 1 << 1,
+    read_sep = 1 << 2,
+    read_key = 1 << 3,
+    read_val = 1 << 4,
+
+    want_sep = want | read_sep,
+    want_key = want | read_key,
+    need_key = need | read_key,
+    want_val = want | read_val,
+    need_val = need | read_val
+  };
+
+  structural_scanner<simd> scanner(context.position, context.end, context.padded);
+  char stack[64];
+  std::size_t depth = 0;
+  decode_error error;  // not reported, see above
+
+  auto inside = 0;
+  auto closer = 0;
+  auto pstate = need_val;
+
+  while (pstate != done) {
+    const auto token = scanner.next_token();
+    if (json_unlikely(!token)) {
+      return false;
+    }
+
+    const auto c = *token;
+
+    if (c == ',' && (pstate & read_sep)) {
+      pstate = (inside == '{' ? need_key : need_val);
+      continue;
+    }
+
+    if (c == '"' && (pstate & read_key)) {
+      if (json_unlikely(!skip_string_token(scanner, context, error, token))) {
+        return false;
+      }
+
+      const auto colon = scanner.next_token();
+      if (json_unlikely(!colon || *colon != ':')) {
+        return false;
+      }
+
+      pstate = need_val;
+      continue;
+    }
+
+    if (c == closer && !(pstate & need)) {
+      inside = (depth ? stack[--depth] : 0);
+      closer = inside + 2;  // '{' + 2 == '}', '[' + 2 == ']'
+      pstate = (inside ? want_sep : done);
+      context.position = token + 1;
+      continue;
+    }
+
+    if (json_unlikely(pstate & (read_key | read_sep))) {
+      return false;
+    }
+
+    if (c == '{' || c == '[') {
+      if (inside) {
+        if (json_unlikely(depth == sizeof(stack))) {
+          return false;
+        }
+        stack[depth++] = static_cast<char>(inside);
+      }
+
+      inside = c;
+      closer = inside + 2;  // '{' + 2 == '}', '[' + 2 == ']'
+      pstate = (inside == '{' ? want_key : want_val);
+      continue;
+    }
+
+    if (c == '"') {
+      if (json_unlikely(!skip_string_token(scanner, context, error, token))) {
+        return false;
+      }
+    } else {
+      context.position = token;
+      if (json_unlikely(!skip_simple_value(context, error))) {
+        return false;
+      }
+      if (json_unlikely(context.remaining() && !is_token_delimiter(*context.position))) {
+        return false;
+      }
+    }
+
+    pstate = (inside ? want_sep : done);
+  }
+
+  return true;
+}
+
+}  // namespace
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/unescape.hpp>
+
+#include <cstring>
+
+#include "skip_chars_common.hpp"
+#include "unescape_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+const char unescape_characters[256] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '/',
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+  0, 0, '\b', 0, 0, 0, '\f', 0, 0, 0, 0, 0, 0, 0, '\n', 0,
+  0, 0, '\r', 0, '\t', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+bool unescape_surrogate_pair(const char *&in, char *&out, const char *end, unsigned high) {
+  if (high > 0xDBFF || end - in < 12 || in[6] != '\\' || in[7] != 'u') {
+    return false;
+  }
+
+  const auto a = unescape_hex_nibble(in[8]);
+  const auto b = unescape_hex_nibble(in[9]);
+  const auto c = unescape_hex_nibble(in[10]);
+  const auto d = unescape_hex_nibble(in[11]);
+  const auto low = unsigned((a << 12) | (b << 8) | (c << 4) | d);
+  if ((a | b | c | d) < 0 || low < 0xDC00 || low > 0xDFFF) {
+    return false;
+  }
+
+  const auto p = 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
+  *(out++) = char(0xF0 | ((p >> 18) & 0x07));
+  *(out++) = char(0x80 | ((p >> 12) & 0x3F));
+  *(out++) = char(0x80 | ((p >>  6) & 0x3F));
+  *(out++) = char(0x80 | ((p >>  0) & 0x3F));
+  in += 12;
+  return true;
+}
+
+namespace {
+
+/**
+ * Copy eight bytes at a time, finding backslashes with the same bit tricks as
+ * skip_any_simple_characters_scalar. The lowest byte that is flagged is always
+ * a backslash, since false positives can only occur above a true match.
+ */
+void copy_simple_scalar(const char *&in, char *&out, const char *end) {
+  for (; end - in >= 8; in += 8, out += 8) {
+    std::uint64_t chunk;
+    std::memcpy(&chunk, in, 8);
+    std::memcpy(out, &chunk, 8);
+    const auto mask = json_haschar_8(chunk, '\\');
+    if (mask) {
+      const auto n = count_trailing_zeros(mask) / 8;
+      in += n;
+      out += n;
+      return;
+    }
+  }
+
+  while (in != end && *in != '\\') {
+    *(out++) = *(in++);
+  }
+}
+
+}  // namespace
+
+bool try_unescape_scalar(decode_context &context, const char *begin, std::string &out) {
+  return try_unescape<find_string_end_scalar, copy_simple_scalar>(context, begin, out);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * The number of bytes that out must have room for past the unescaped string,
+ * so that the copy functions can always store whole chunks.
+ */
+constexpr std::size_t unescape_slack = 32;
+
+/**
+ * The character that each two character escape sequence stands for, indexed by
+ * the character after the backslash, or zero for \u and invalid escapes.
+ */
+extern const char unescape_characters[256];
+
+json_force_inline int unescape_hex_nibble(const char c) {
+  if (c >= '0' && c <= '9') { return c - '0'; }
+  const auto lower = char(c | 0x20);
+  if (lower >= 'a' && lower <= 'f') { return lower - 'a' + 10; }
+  return -1;
+}
+
+/**
+ * Write the code point of the escaped surrogate pair at in, whose high
+ * surrogate has already been decoded. Unpaired surrogates are left for the
+ * generic implementation, which decides whether they are errors. It is
+ * defined in unescape.cpp, so that it is only compiled for the baseline
+ * instruction set.
+ */
+bool unescape_surrogate_pair(const char *&in, char *&out, const char *end, unsigned high);
+
+/**
+ * Write the character that the escape sequence at in (which is a backslash)
+ * stands for, and advance both pointers past it. Returns false if the escape
+ * sequence is invalid.
+ */
+json_force_inline bool unescape_sequence(const char *&in, char *&out, const char *end) {
+  const auto character = unescape_characters[static_cast<unsigned char>(in[1])];
+  if (json_likely(character)) {
+    *(out++) = character;
+    in += 2;
+    return true;
+  }
+
+  if (json_unlikely(in[1] != 'u' || end - in < 6)) {
+    return false;
+  }
+
+  const auto a = unescape_hex_nibble(in[2]);
+  const auto b = unescape_hex_nibble(in[3]);
+  const auto c = unescape_hex_nibble(in[4]);
+  const auto d = unescape_hex_nibble(in[5]);
+  if (json_unlikely((a | b | c | d) < 0)) { return false; }
+  const auto p = unsigned((a << 12) | (b << 8) | (c << 4) | d);
+  if (json_unlikely(p >= 0xD800 && p <= 0xDFFF)) {
+    return unescape_surrogate_pair(in, out, end, p);
+  }
+  if (p <= 0x7F) {
+    *(out++) = char(p);
+  } else if (p <= 0x07FF) {
+    *(out++) = char(0xC0 | ((p >> 6) & 0x1F));
+    *(out++) = char(0x80 | ((p >> 0) & 0x3F));
+  } else {
+    *(out++) = char(0xE0 | ((p >> 12) & 0x0F));
+    *(out++) = char(0x80 | ((p >>  6) & 0x3F));
+    *(out++) = char(0x80 | ((p >>  0) & 0x3F));
+  }
+  in += 6;
+  return true;
+}
+
+/**
+ * Find the closing quote of a string, starting at in, which is just after a
+ * backslash, or return nullptr if there is none. The character after each
+ * backslash is skipped, and the digits of \u escape sequences are simple
+ * characters, so the first " that is found is the end of the string if the
+ * string is valid at all.
+ */
+json_force_inline const char *find_string_end_scalar(const char *in, const char *end) {
+  for (in++; in < end; in++) {
+    if (*in == '"') { return in; }
+    if (*in == '\\') { in++; }
+  }
+  return nullptr;
+}
+
+/**
+ * The shared part of the unescape kernels, see try_unescape. find_string_end
+ * works like find_string_end_scalar. copy_simple must copy bytes from in to
+ * out until in is at a backslash or at end, and may store up to
+ * unescape_slack bytes past what it copies.
+ */
+template <
+    const char *(*find_string_end)(const char *in, const char *end),
+    void (*copy_simple)(const char *&in, char *&out, const char *end)>
+json_force_inline bool try_unescape(decode_context &context, const char *begin, std::string &out) {
+  const auto end = find_string_end(context.position, context.end);
+  if (json_unlikely(!end)) {
+    return false;
+  }
+
+  // No escape sequence makes the string longer, so the unescaped string fits
+  // in as many bytes as the escaped one.
+  out.resize(static_cast<std::size_t>(end - begin) + unescape_slack);
+
+  auto in = context.position - 1;
+  auto ptr = &out[0];
+  std::memcpy(ptr, begin, in - begin);
+  ptr += (in - begin);
+
+  do {
+    if (json_unlikely(!unescape_sequence(in, ptr, end))) { return false; }
+    copy_simple(in, ptr, end);
+  } while (in != end);
+
+  out.resize(ptr - &out[0]);
+  context.position = end + 1;
+  return true;
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
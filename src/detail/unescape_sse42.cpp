@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/unescape.hpp>
+
+#if defined(json_arch_x86_sse42)
+
+#include <nmmintrin.h>
+
+#include "skip_chars_common.hpp"
+#include "unescape_common.hpp"
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+/**
+ * The backslashes and quotes of each chunk are taken from its bit masks one by
+ * one, so that escape sequences do not add loads to the dependency chain.
+ */
+const char *find_string_end_sse42(const char *in, const char *end) {
+  const auto quote = _mm_set1_epi8('"');
+  const auto backslash = _mm_set1_epi8('\\');
+  for (in++; end - in >= 16;) {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+    const auto quotes = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)));
+    auto mask = quotes | uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)));
+    auto skip = 0;
+    while (mask) {
+      const auto i = count_trailing_zeros(mask);
+      if (quotes & (1u << i)) {
+        return in + i;
+      }
+      // Clear the backslash and the character that it escapes, which may be
+      // the first character of the next chunk.
+      mask &= ~(3u << i);
+      skip = (i == 15);
+    }
+    in += 16 + skip;
+  }
+
+  return find_string_end_scalar(in - 1, end);
+}
+
+void copy_simple_sse42(const char *&in, char *&out, const char *end) {
+  const auto backslash = _mm_set1_epi8('\\');
+  for (; end - in >= 16; in += 16, out += 16) {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), chunk);
+    const auto mask = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)));
+    if (mask) {
+      const auto n = count_trailing_zeros(mask);
+      in += n;
+      out += n;
+      return;
+    }
+  }
+
+  while (in != end && *in != '\\') {
+    *(out++) = *(in++);
+  }
+}
+
+}  // namespace
+
+bool try_unescape_sse42(decode_context &context, const char *begin, std::string &out) {
+  return try_unescape<find_string_end_sse42, copy_simple_sse42>(context, begin, out);
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
+
+#endif  // defined(json_arch_x86_sse42)
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <spotify/json/detail/macros.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+
+/**
+ * Lookup tables for validating UTF-8 sixteen or thirty-two bytes at a time, as
+ * described by Keiser and Lemire in "Validating UTF-8 In Less Than One
+ * Instruction Per Byte". Each pair of adjacent bytes is classified by the high
+ * nibble of the first byte, its low nibble and the high nibble of the second
+ * byte. The pair is invalid if the three lookups have a bit in common. Missing
+ * third and fourth bytes of a sequence are found separately.
+ */
+namespace utf8 {
+
+constexpr std::uint8_t too_short = 1 << 0;   // 11______ 0_______ or 11______ 11______
+constexpr std::uint8_t too_long = 1 << 1;    // 0_______ 10______
+constexpr std::uint8_t overlong_3 = 1 << 2;  // 11100000 100_____
+constexpr std::uint8_t too_large = 1 << 3;   // 11110100 1001____ or 11110100 101_____ etc.
+constexpr std::uint8_t surrogate = 1 << 4;   // 11101101 101_____
+constexpr std::uint8_t overlong_2 = 1 << 5;  // 1100000_ 10______
+constexpr std::uint8_t too_large_1000 = 1 << 6;  // 11110101 1000____ etc.
+constexpr std::uint8_t overlong_4 = 1 << 6;  // 11110000 1000____
+constexpr std::uint8_t two_conts = 1 << 7;   // 10______ 10______
+constexpr std::uint8_t carry = too_short | too_long | two_conts;
+
+alignas(16) constexpr std::uint8_t byte_1_high[16] = {
+  too_long, too_long, too_long, too_long,
+  too_long, too_long, too_long, too_long,
+  two_conts, two_conts, two_conts, two_conts,
+  too_short | overlong_2,
+  too_short,
+  too_short | overlong_3 | surrogate,
+  too_short | too_large | too_large_1000 | overlong_4
+};
+
+alignas(16) constexpr std::uint8_t byte_1_low[16] = {
+  carry | overlong_3 | overlong_2 | overlong_4,
+  carry | overlong_2,
+  carry,
+  carry,
+  carry | too_large,
+  carry | too_large | too_large_1000,
+  carry | too_large | too_large_1000,
+  carry | too_large | too_large_1000,
+  carry | too_large | too_large_1000,
+  carry | too_large | too_large_1000,
+  carry | too_large | too_large_1000,
+  carry | too_large | too_large_1000,
+  carry | too_large | too_large_1000,
+  carry | too_large | too_large_1000 | surrogate,
+  carry | too_large | too_large_1000,
+  carry | too_large | too_large_1000
+};
+
+alignas(16) constexpr std::uint8_t byte_2_high[16] = {
+  too_short, too_short, too_short, too_short,
+  too_short, too_short, too_short, too_short,
+  too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+  too_long | overlong_2 | two_conts | overlong_3 | too_large,
+  too_long | overlong_2 | two_conts | surrogate | too_large,
+  too_long | overlong_2 | two_conts | surrogate | too_large,
+  too_short, too_short, too_short, too_short
+};
+
+}  // namespace utf8
+
+/**
+ * The length of the UTF-8 sequence whose lead byte (which is not ASCII) is at
+ * pos, or zero if the sequence is invalid. Sequences that are cut off by end
+ * are reported as valid, since the string that they are in is unterminated
+ * anyway.
+ */
+json_force_inline std::size_t utf8_sequence_length(const char *pos, const char *end) {
+  const auto lead = std::uint8_t(pos[0]);
+
+  std::size_t size;
+  std::uint8_t min = 0x80, max = 0xBF;  // the range of the second byte
+  if (lead < 0xC2) {
+    return 0;  // a continuation byte, or an overlong two byte sequence
+  } else if (lead < 0xE0) {
+    size = 2;
+  } else if (lead < 0xF0) {
+    size = 3;
+    if (lead == 0xE0) { min = 0xA0; }
+    if (lead == 0xED) { max = 0x9F; }
+  } else if (lead < 0xF5) {
+    size = 4;
+    if (lead == 0xF0) { min = 0x90; }
+    if (lead == 0xF4) { max = 0x8F; }
+  } else {
+    return 0;
+  }
+
+  for (std::size_t i = 1; i < size; i++, min = 0x80, max = 0xBF) {
+    if (json_unlikely(pos + i >= end)) {
+      return static_cast<std::size_t>(end - pos);
+    }
+    const auto c = std::uint8_t(pos[i]);
+    if (json_unlikely(c < min || c > max)) {
+      return 0;
+    }
+  }
+
+  return size;
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
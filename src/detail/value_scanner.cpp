@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/detail/value_scanner.hpp>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+json_force_inline bool is_space(const char c) {
+  return (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+}
+
+json_force_inline bool is_scalar_end(const char c) {
+  switch (c) {
+    case ' ': case '\t': case '\n': case '\r':
+    case '{': case '}': case '[': case ']': case ',': case ':': case '"':
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+value_scanner::value_scanner() {
+  reset();
+}
+
+void value_scanner::reset() {
+  _depth = 0;
+  _started = false;
+  _in_scalar = false;
+  _in_string = false;
+  _escaped = false;
+}
+
+const char *value_scanner::scan(const char *begin, const char *end) {
+  auto position = begin;
+
+  while (json_likely(position != end)) {
+    if (_in_string) {
+      if (json_unlikely(_escaped)) {
+        _escaped = false;
+        position++;
+        continue;
+      }
+
+      // Most strings in JSON are short keys, which are found faster with a
+      // plain loop than by calling into the SIMD kernel.
+      const auto short_end = (end - position > 16 ? position + 16 : end);
+      while (position != short_end && *position != '"' && *position != '\\') {
+        position++;
+      }
+
+      if (json_unlikely(position == short_end)) {
+        decode_context context(position, end);
+        skip_any_simple_characters(context);
+        position = context.position;
+        if (json_unlikely(position == end)) {
+          break;
+        }
+      }
+
+      if (*(position++) == '\\') {
+        _escaped = true;
+      } else {
+        _in_string = false;
+        if (_depth == 0) {
+          return position;
+        }
+      }
+      continue;
+    }
+
+    const auto c = *position;
+
+    if (json_unlikely(!_started)) {
+      if (is_space(c)) {
+        position++;
+        continue;
+      }
+
+      _started = true;
+      switch (c) {
+        case '"': _in_string = true; break;
+        case '{': case '[': _depth = 1; break;
+        case '}': case ']': case ',': case ':': return position;
+        default: _in_scalar = true; break;
+      }
+      position++;
+      continue;
+    }
+
+    if (_in_scalar) {
+      if (is_scalar_end(c)) {
+        return position;
+      }
+      position++;
+      continue;
+    }
+
+    position++;
+    switch (c) {
+      case '"': _in_string = true; break;
+      case '{': case '[': _depth++; break;
+      case '}': case ']':
+        if (--_depth == 0) {
+          return position;
+        }
+        break;
+      default: break;
+    }
+  }
+
+  return nullptr;
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace spotify
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/instruction_set.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#include <spotify/json/detail/cpuid.hpp>
+#include <spotify/json/detail/escape.hpp>
+#include <spotify/json/detail/kernels.hpp>
+#include <spotify/json/detail/macros.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/detail/skip_value.hpp>
+#include <spotify/json/detail/unescape.hpp>
+
+namespace spotify {
+namespace json {
+namespace detail {
+namespace {
+
+void resolve_skip_any_simple_characters(decode_context &context);
+void resolve_skip_any_whitespace(decode_context &context);
+void resolve_skip_any_simple_characters_padded(decode_context &context);
+void resolve_skip_any_whitespace_padded(decode_context &context);
+void resolve_skip_any_simple_characters_utf8(decode_context &context);
+bool resolve_skip_value(decode_context &context, decode_error &error);
+void resolve_write_escaped(encode_context &context, const char *begin, const char *end);
+void resolve_write_escaped_ascii(encode_context &context, const char *begin, const char *end);
+void resolve_write_escaped_html(encode_context &context, const char *begin, const char *end);
+bool resolve_unescape(decode_context &context, const char *begin, std::string &out);
+
+}  // namespace
+
+kernel_table kernels = {
+  { &resolve_skip_any_simple_characters },
+  { &resolve_skip_any_whitespace },
+  { &resolve_skip_any_simple_characters_padded },
+  { &resolve_skip_any_whitespace_padded },
+  { &resolve_skip_any_simple_characters_utf8 },
+  { &resolve_skip_value },
+  { &resolve_write_escaped },
+  { &resolve_write_escaped_ascii },
+  { &resolve_write_escaped_html },
+  { &resolve_unescape }
+};
+
+namespace {
+
+std::mutex kernels_mutex;
+bool kernels_installed = false;
+std::atomic<instruction_set> kernels_instruction_set(instruction_set::scalar);
+
+instruction_set instruction_set_from_environment(const instruction_set fallback) {
+  const auto name = std::getenv("SPOTIFY_JSON_INSTRUCTION_SET");
+  if (!name) { return fallback; }
+  if (std::strcmp(name, "scalar") == 0) { return instruction_set::scalar; }
+  if (std::strcmp(name, "sse42") == 0) { return instruction_set::sse42; }
+  if (std::strcmp(name, "avx2") == 0) { return instruction_set::avx2; }
+  if (std::strcmp(name, "avx512bw") == 0) { return instruction_set::avx512bw; }
+  return fallback;
+}
+
+kernel_table::skip_function select_skip_any_simple_characters(const instruction_set set) {
+#if defined(json_arch_x86_avx512bw)
+  if (set >= instruction_set::avx512bw) { return &skip_any_simple_characters_avx512bw; }
+#endif  // defined(json_arch_x86_avx512bw)
+#if defined(json_arch_x86_avx2)
+  if (set >= instruction_set::avx2) { return &skip_any_simple_characters_avx2; }
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_sse42)
+  if (set >= instruction_set::sse42) { return &skip_any_simple_characters_sse42; }
+#endif  // defined(json_arch_x86_sse42)
+  return &skip_any_simple_characters_scalar;
+}
+
+kernel_table::skip_function select_skip_any_whitespace(const instruction_set set) {
+#if defined(json_arch_x86_avx512bw)
+  if (set >= instruction_set::avx512bw) { return &skip_any_whitespace_avx512bw; }
+#endif  // defined(json_arch_x86_avx512bw)
+#if defined(json_arch_x86_avx2)
+  if (set >= instruction_set::avx2) { return &skip_any_whitespace_avx2; }
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_sse42)
+  if (set >= instruction_set::sse42) { return &skip_any_whitespace_sse42; }
+#endif  // defined(json_arch_x86_sse42)
+  return &skip_any_whitespace_scalar;
+}
+
+kernel_table::skip_function select_skip_any_simple_characters_padded(const instruction_set set) {
+#if defined(json_arch_x86_avx512bw)
+  if (set >= instruction_set::avx512bw) { return &skip_any_simple_characters_padded_avx512bw; }
+#endif  // defined(json_arch_x86_avx512bw)
+#if defined(json_arch_x86_avx2)
+  if (set >= instruction_set::avx2) { return &skip_any_simple_characters_padded_avx2; }
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_sse42)
+  if (set >= instruction_set::sse42) { return &skip_any_simple_characters_padded_sse42; }
+#endif  // defined(json_arch_x86_sse42)
+  return &skip_any_simple_characters_scalar;
+}
+
+kernel_table::skip_function select_skip_any_whitespace_padded(const instruction_set set) {
+#if defined(json_arch_x86_avx512bw)
+  if (set >= instruction_set::avx512bw) { return &skip_any_whitespace_padded_avx512bw; }
+#endif  // defined(json_arch_x86_avx512bw)
+#if defined(json_arch_x86_avx2)
+  if (set >= instruction_set::avx2) { return &skip_any_whitespace_padded_avx2; }
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_sse42)
+  if (set >= instruction_set::sse42) { return &skip_any_whitespace_padded_sse42; }
+#endif  // defined(json_arch_x86_sse42)
+  return &skip_any_whitespace_scalar;
+}
+
+kernel_table::skip_function select_skip_any_simple_characters_utf8(const instruction_set set) {
+#if defined(json_arch_x86_avx2)
+  if (set >= instruction_set::avx2) { return &skip_any_simple_characters_utf8_avx2; }
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_sse42)
+  if (set >= instruction_set::sse42) { return &skip_any_simple_characters_utf8_sse42; }
+#endif  // defined(json_arch_x86_sse42)
+  return &skip_any_simple_characters_utf8_scalar;
+}
+
+kernel_table::try_skip_function select_skip_value(const instruction_set set) {
+#if defined(json_arch_x86_avx512bw)
+  if (set >= instruction_set::avx512bw) { return &try_skip_value_avx512bw; }
+#endif  // defined(json_arch_x86_avx512bw)
+#if defined(json_arch_x86_avx2)
+  if (set >= instruction_set::avx2) { return &try_skip_value_avx2; }
+#endif  // defined(json_arch_x86_avx2)
+  return &try_skip_value_scalar;
+}
+
+kernel_table::escape_function select_write_escaped(const instruction_set set) {
+#if defined(json_arch_x86_avx2)
+  if (set >= instruction_set::avx2) { return &write_escaped_avx2; }
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_sse42)
+  if (set >= instruction_set::sse42) { return &write_escaped_sse42; }
+#endif  // defined(json_arch_x86_sse42)
+  return &write_escaped_scalar;
+}
+
+kernel_table::escape_function select_write_escaped_ascii(const instruction_set set) {
+#if defined(json_arch_x86_avx2)
+  if (set >= instruction_set::avx2) { return &write_escaped_ascii_avx2; }
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_sse42)
+  if (set >= instruction_set::sse42) { return &write_escaped_ascii_sse42; }
+#endif  // defined(json_arch_x86_sse42)
+  return &write_escaped_ascii_scalar;
+}
+
+kernel_table::escape_function select_write_escaped_html(const instruction_set set) {
+#if defined(json_arch_x86_avx2)
+  if (set >= instruction_set::avx2) { return &write_escaped_html_avx2; }
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_sse42)
+  if (set >= instruction_set::sse42) { return &write_escaped_html_sse42; }
+#endif  // defined(json_arch_x86_sse42)
+  return &write_escaped_html_scalar;
+}
+
+kernel_table::unescape_function select_unescape(const instruction_set set) {
+#if defined(json_arch_x86_avx2)
+  if (set >= instruction_set::avx2) { return &try_unescape_avx2; }
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_sse42)
+  if (set >= instruction_set::sse42) { return &try_unescape_sse42; }
+#endif  // defined(json_arch_x86_sse42)
+  return &try_unescape_scalar;
+}
+
+/**
+ * Fill in the kernel table. Must be called with kernels_mutex held.
+ */
+instruction_set install_kernels(const instruction_set requested_set) {
+  const auto set = std::min(requested_set, supported_instruction_set());
+  kernels.skip_any_simple_characters.store(select_skip_any_simple_characters(set), std::memory_order_relaxed);
+  kernels.skip_any_whitespace.store(select_skip_any_whitespace(set), std::memory_order_relaxed);
+  kernels.skip_any_simple_characters_padded.store(select_skip_any_simple_characters_padded(set), std::memory_order_relaxed);
+  kernels.skip_any_whitespace_padded.store(select_skip_any_whitespace_padded(set), std::memory_order_relaxed);
+  kernels.skip_any_simple_characters_utf8.store(select_skip_any_simple_characters_utf8(set), std::memory_order_relaxed);
+  kernels.skip_value.store(select_skip_value(set), std::memory_order_relaxed);
+  kernels.write_escaped.store(select_write_escaped(set), std::memory_order_relaxed);
+  kernels.write_escaped_ascii.store(select_write_escaped_ascii(set), std::memory_order_relaxed);
+  kernels.write_escaped_html.store(select_write_escaped_html(set), std::memory_order_relaxed);
+  kernels.unescape.store(select_unescape(set), std::memory_order_relaxed);
+  kernels_instruction_set.store(set, std::memory_order_relaxed);
+  kernels_installed = true;
+  return set;
+}
+
+json_never_inline void install_default_kernels() {
+  std::lock_guard<std::mutex> lock(kernels_mutex);
+  if (!kernels_installed) {
+    install_kernels(instruction_set_from_environment(supported_instruction_set()));
+  }
+}
+
+void resolve_skip_any_simple_characters(decode_context &context) {
+  install_default_kernels();
+  kernels.skip_any_simple_characters.load(std::memory_order_relaxed)(context);
+}
+
+void resolve_skip_any_whitespace(decode_context &context) {
+  install_default_kernels();
+  kernels.skip_any_whitespace.load(std::memory_order_relaxed)(context);
+}
+
+void resolve_skip_any_simple_characters_padded(decode_context &context) {
+  install_default_kernels();
+  kernels.skip_any_simple_characters_padded.load(std::memory_order_relaxed)(context);
+}
+
+void resolve_skip_any_whitespace_padded(decode_context &context) {
+  install_default_kernels();
+  kernels.skip_any_whitespace_padded.load(std::memory_order_relaxed)(context);
+}
+
+void resolve_skip_any_simple_characters_utf8(decode_context &context) {
+  install_default_kernels();
+  kernels.skip_any_simple_characters_utf8.load(std::memory_order_relaxed)(context);
+}
+
+bool resolve_skip_value(decode_context &context, decode_error &error) {
+  install_default_kernels();
+  return kernels.skip_value.load(std::memory_order_relaxed)(context, error);
+}
+
+void resolve_write_escaped(encode_context &context, const char *begin, const char *end) {
+  install_default_kernels();
+  kernels.write_escaped.load(std::memory_order_relaxed)(context, begin, end);
+}
+
+void resolve_write_escaped_ascii(encode_context &context, const char *begin, const char *end) {
+  install_default_kernels();
+  kernels.write_escaped_ascii.load(std::memory_order_relaxed)(context, begin, end);
+}
+
+void resolve_write_escaped_html(encode_context &context, const char *begin, const char *end) {
+  install_default_kernels();
+  kernels.write_escaped_html.load(std::memory_order_relaxed)(context, begin, end);
+}
+
+bool resolve_unescape(decode_context &context, const char *begin, std::string &out) {
+  install_default_kernels();
+  return kernels.unescape.load(std::memory_order_relaxed)(context, begin, out);
+}
+
+instruction_set detect_instruction_set() {
+  const cpuid cpu;
+#if defined(json_arch_x86_avx512bw)
+  if (cpu.has_avx512bw() && cpu.has_pclmulqdq()) { return instruction_set::avx512bw; }
+#endif  // defined(json_arch_x86_avx512bw)
+#if defined(json_arch_x86_avx2)
+  if (cpu.has_avx2() && cpu.has_pclmulqdq()) { return instruction_set::avx2; }
+#endif  // defined(json_arch_x86_avx2)
+#if defined(json_arch_x86_sse42)
+  if (cpu.has_sse42()) { return instruction_set::sse42; }
+#endif  // defined(json_arch_x86_sse42)
+  return instruction_set::scalar;
+}
+
+}  // namespace
+}  // namespace detail
+
+instruction_set supported_instruction_set() {
+  static const auto supported = detail::detect_instruction_set();
+  return supported;
+}
+
+instruction_set active_instruction_set() {
+  detail::install_default_kernels();
+  return detail::kernels_instruction_set.load(std::memory_order_relaxed);
+}
+
+instruction_set use_instruction_set(const instruction_set set) {
+  std::lock_guard<std::mutex> lock(detail::kernels_mutex);
+  return detail::install_kernels(set);
+}
+
+}  // namespace json
+}  // namespace spotify
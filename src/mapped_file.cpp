@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <spotify/json/mapped_file.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <system_error>
+#include <utility>
+
+#include <spotify/json/detail/macros.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define json_mapped_file_mmap 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace spotify {
+namespace json {
+namespace {
+
+json_noreturn void throw_system_error(const std::string &what, const int error) {
+  throw std::system_error(error, std::generic_category(), what);
+}
+
+#if defined(json_mapped_file_mmap)
+
+class file_descriptor final {
+ public:
+  explicit file_descriptor(const std::string &path)
+      : _fd(::open(path.c_str(), O_RDONLY)) {
+    if (_fd == -1) {
+      throw_system_error("Could not open " + path, errno);
+    }
+  }
+
+  ~file_descriptor() {
+    ::close(_fd);
+  }
+
+  int get() const { return _fd; }
+
+ private:
+  int _fd;
+};
+
+/**
+ * Map the file, and the zero padding after it. The padding is only part of
+ * the file mapping if the file does not end too close to a page boundary, so
+ * instead the whole range is first reserved with an anonymous mapping of zero
+ * pages, and then the file is mapped over the beginning of it.
+ */
+std::pair<const char *, std::size_t> map_file(const std::string &path, std::size_t &mapping_size) {
+  const file_descriptor fd(path);
+
+  struct stat st;
+  if (::fstat(fd.get(), &st) == -1) {
+    throw_system_error("Could not stat " + path, errno);
+  }
+
+  const auto size = static_cast<std::size_t>(st.st_size);
+  const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  mapping_size = (size + decode_padding + page_size - 1) / page_size * page_size;
+
+  const auto base = ::mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED) {
+    throw_system_error("Could not map " + path, errno);
+  }
+
+  if (size) {
+    if (::mmap(base, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd.get(), 0) == MAP_FAILED) {
+      const auto error = errno;
+      ::munmap(base, mapping_size);
+      throw_system_error("Could not map " + path, error);
+    }
+
+    ::madvise(base, size, MADV_SEQUENTIAL);  // only a hint, so errors do not matter
+  }
+
+  return std::make_pair(static_cast<const char *>(base), size);
+}
+
+#else
+
+std::pair<const char *, std::size_t> map_file(const std::string &path, std::size_t &mapping_size) {
+  const auto file = std::fopen(path.c_str(), "rb");
+  if (!file) {
+    throw_system_error("Could not open " + path, errno);
+  }
+
+  std::fseek(file, 0, SEEK_END);
+  const auto end = std::ftell(file);
+  std::fseek(file, 0, SEEK_SET);
+  const auto size = static_cast<std::size_t>(end < 0 ? 0 : end);
+
+  const auto data = static_cast<char *>(std::malloc(size + decode_padding));
+  if (json_unlikely(!data)) {
+    std::fclose(file);
+    throw std::bad_alloc();
+  }
+
+  const auto read = std::fread(data, 1, size, file);
+  std::fclose(file);
+  if (end < 0 || read != size) {
+    std::free(data);
+    throw_system_error("Could not read " + path, EIO);
+  }
+
+  std::memset(data + size, 0, decode_padding);
+  mapping_size = 0;
+  return std::make_pair(data, size);
+}
+
+#endif  // defined(json_mapped_file_mmap)
+
+}  // namespace
+
+mapped_file::mapped_file(const std::string &path) {
+  const auto mapping = map_file(path, _mapping_size);
+  _data = mapping.first;
+  _size = mapping.second;
+}
+
+mapped_file::mapped_file(mapped_file &&file) noexcept
+    : _data(nullptr),
+      _size(0),
+      _mapping_size(0) {
+  swap(file);
+}
+
+mapped_file::~mapped_file() {
+#if defined(json_mapped_file_mmap)
+  if (_mapping_size) {
+    ::munmap(const_cast<char *>(_data), _mapping_size);
+    return;
+  }
+#endif  // defined(json_mapped_file_mmap)
+  std::free(const_cast<char *>(_data));
+}
+
+mapped_file &mapped_file::operator=(mapped_file &&file) noexcept {
+  swap(file);
+  return *this;
+}
+
+void mapped_file::swap(mapped_file &file) noexcept {
+  std::swap(_data, file._data);
+  std::swap(_size, file._size);
+  std::swap(_mapping_size, file._mapping_size);
+}
+
+}  // namespace json
+}  // namespace spotify
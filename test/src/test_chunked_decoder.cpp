@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/chunked_decoder.hpp>
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/boolean.hpp>
+#include <spotify/json/codec/map.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/encode.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+struct point_t {
+  int x = 0;
+  int y = 0;
+  std::vector<std::string> tags;
+};
+
+bool operator==(const point_t &a, const point_t &b) {
+  return (a.x == b.x && a.y == b.y && a.tags == b.tags);
+}
+
+}  // namespace
+
+template <>
+struct default_codec_t<point_t> {
+  static codec::object_t<point_t> codec() {
+    auto codec = codec::object<point_t>();
+    codec.required("x", &point_t::x);
+    codec.required("y", &point_t::y);
+    codec.optional("tags", &point_t::tags);
+    return codec;
+  }
+};
+
+namespace {
+
+template <typename value_type>
+value_type decode_in_chunks(const std::string &json, const std::size_t chunk_size) {
+  auto decoder = make_chunked_decoder(default_codec<value_type>());
+  for (std::size_t i = 0; i < json.size(); i += chunk_size) {
+    decoder.append(json.data() + i, std::min(chunk_size, json.size() - i));
+  }
+  return decoder.finish();
+}
+
+template <typename value_type>
+void verify_decode_in_chunks(const std::string &json) {
+  const auto expected = decode<value_type>(json);
+  for (std::size_t chunk_size = 1; chunk_size <= json.size(); chunk_size++) {
+    BOOST_CHECK(decode_in_chunks<value_type>(json, chunk_size) == expected);
+  }
+}
+
+template <typename value_type>
+void verify_fail_in_chunks(const std::string &json) {
+  std::string expected_what;
+  std::size_t expected_offset = 0;
+  try {
+    decode<value_type>(json);
+    BOOST_FAIL("decode should have failed");
+  } catch (const decode_exception &exception) {
+    expected_what = exception.what();
+    expected_offset = exception.offset();
+  }
+
+  for (std::size_t chunk_size = 1; chunk_size <= std::max<std::size_t>(json.size(), 1); chunk_size++) {
+    try {
+      decode_in_chunks<value_type>(json, chunk_size);
+      BOOST_FAIL("decode_in_chunks should have failed");
+    } catch (const decode_exception &exception) {
+      BOOST_CHECK_EQUAL(exception.what(), expected_what);
+      BOOST_CHECK_EQUAL(exception.offset(), expected_offset);
+    }
+  }
+}
+
+}  // namespace
+
+/*
+ * Decoding
+ */
+
+BOOST_AUTO_TEST_CASE(json_chunked_decoder_should_decode_arrays) {
+  verify_decode_in_chunks<std::vector<int>>("[]");
+  verify_decode_in_chunks<std::vector<int>>(" [ ] ");
+  verify_decode_in_chunks<std::vector<int>>("[1]");
+  verify_decode_in_chunks<std::vector<int>>("[1,22,333]");
+  verify_decode_in_chunks<std::vector<int>>(" [ 1 , 22 ,\n333 ]\n");
+  verify_decode_in_chunks<std::vector<std::string>>(R"(["a","[b]",",","\"","\\",""])");
+  verify_decode_in_chunks<std::vector<std::vector<int>>>("[[],[1],[2,3],[ ]]");
+  verify_decode_in_chunks<std::vector<std::map<std::string, int>>>(R"([{"a":1},{},{"]":2,"}":3}])");
+  verify_decode_in_chunks<std::array<int, 3>>("[1,2,3]");
+}
+
+BOOST_AUTO_TEST_CASE(json_chunked_decoder_should_decode_maps) {
+  verify_decode_in_chunks<std::map<std::string, int>>("{}");
+  verify_decode_in_chunks<std::map<std::string, int>>(" { } ");
+  verify_decode_in_chunks<std::map<std::string, std::vector<int>>>(R"({"a":[1,2],"b":[]})");
+  verify_decode_in_chunks<std::map<std::string, std::string>>(R"( { "a\"}" : "\\" , "b" :"" } )");
+  verify_decode_in_chunks<std::map<std::string, int>>(R"({"a":1,"a":2})");
+}
+
+BOOST_AUTO_TEST_CASE(json_chunked_decoder_should_decode_objects) {
+  verify_decode_in_chunks<point_t>(R"({"x":1,"y":2})");
+  verify_decode_in_chunks<point_t>(R"( { "y" : 2 , "tags" : ["a","}"] , "x" : 1 } )");
+  verify_decode_in_chunks<point_t>(R"({"x":1,"z":{"a":[1,2]},"y":2})");
+  verify_decode_in_chunks<point_t>(R"({"\u0078":1,"y":2})");
+  verify_decode_in_chunks<std::vector<point_t>>(R"([{"x":1,"y":2},{"x":3,"y":4}])");
+}
+
+BOOST_AUTO_TEST_CASE(json_chunked_decoder_should_decode_many_members) {
+  std::map<std::string, std::string> expected;
+  for (int i = 0; i < 1000; i++) {
+    expected[std::to_string(i) + "\"\\"] = std::string(i % 100, 'a' + (i % 26));
+  }
+
+  const auto json = encode(expected);
+  for (const std::size_t chunk_size : { 1, 7, 64, 1000, 16384 }) {
+    const auto decoded = decode_in_chunks<std::map<std::string, std::string>>(json, chunk_size);
+    BOOST_CHECK(decoded == expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_chunked_decoder_should_decode_other_values) {
+  verify_decode_in_chunks<std::string>(R"("a\"b")");
+  verify_decode_in_chunks<int>("12345");
+  verify_decode_in_chunks<int>(" 12345 ");
+}
+
+BOOST_AUTO_TEST_CASE(json_chunked_decoder_should_decode_many_elements) {
+  std::vector<std::string> expected;
+  for (int i = 0; i < 1000; i++) {
+    expected.push_back(std::string(i % 100, 'a' + (i % 26)) + "\"\\" + std::to_string(i));
+  }
+
+  const auto json = encode(expected);
+  for (const std::size_t chunk_size : { 1, 7, 64, 1000, 16384 }) {
+    BOOST_CHECK(decode_in_chunks<std::vector<std::string>>(json, chunk_size) == expected);
+  }
+}
+
+/*
+ * Completion
+ */
+
+BOOST_AUTO_TEST_CASE(json_chunked_decoder_should_be_complete_after_the_last_byte) {
+  for (const std::string json : { "[1,[2]]", R"({"a":"}"})", R"("\"")" }) {
+    auto decoder = make_chunked_decoder(default_codec<std::string>());
+    for (std::size_t i = 0; i < json.size(); i++) {
+      BOOST_CHECK(!decoder.complete());
+      decoder.append(json.data() + i, 1);
+    }
+    BOOST_CHECK(decoder.complete());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_chunked_decoder_should_complete_objects) {
+  auto decoder = make_chunked_decoder(default_codec<point_t>());
+  decoder.append(R"( {"x":1,"y")", 11);
+  BOOST_CHECK(!decoder.complete());
+  decoder.append(":2}", 3);
+  BOOST_CHECK(decoder.complete());
+  BOOST_CHECK_EQUAL(decoder.finish().y, 2);
+}
+
+BOOST_AUTO_TEST_CASE(json_chunked_decoder_should_complete_arrays) {
+  auto decoder = make_chunked_decoder(default_codec<std::vector<int>>());
+  decoder.append(" [1, 2", 6);
+  BOOST_CHECK(!decoder.complete());
+  decoder.append("]", 1);
+  BOOST_CHECK(decoder.complete());
+  decoder.append("\n", 1);
+  BOOST_CHECK(decoder.complete());
+  BOOST_CHECK(decoder.finish() == std::vector<int>({ 1, 2 }));
+}
+
+BOOST_AUTO_TEST_CASE(json_chunked_decoder_should_not_complete_numbers_until_followed) {
+  auto decoder = make_chunked_decoder(default_codec<int>());
+  decoder.append("12", 2);
+  BOOST_CHECK(!decoder.complete());
+  decoder.append(" ", 1);
+  BOOST_CHECK(decoder.complete());
+  BOOST_CHECK_EQUAL(decoder.finish(), 12);
+}
+
+BOOST_AUTO_TEST_CASE(json_chunked_decoder_should_reserve) {
+  const std::string json = R"({"a":1})";
+  auto decoder = make_chunked_decoder(default_codec<std::map<std::string, int>>());
+  decoder.reserve(json.size());
+  decoder.append(json.data(), json.size());
+  BOOST_CHECK(decoder.finish() == (std::map<std::string, int>{ { "a", 1 } }));
+}
+
+/*
+ * Errors
+ */
+
+BOOST_AUTO_TEST_CASE(json_chunked_decoder_should_fail_like_decode) {
+  verify_fail_in_chunks<std::vector<int>>("");
+  verify_fail_in_chunks<std::vector<int>>("{}");
+  verify_fail_in_chunks<std::vector<int>>("[1,2,]");
+  verify_fail_in_chunks<std::vector<int>>("[,]");
+  verify_fail_in_chunks<std::vector<int>>("[1 2]");
+  verify_fail_in_chunks<std::vector<int>>("[1:2]");
+  verify_fail_in_chunks<std::vector<int>>("[1,2x]");
+  verify_fail_in_chunks<std::vector<int>>("[1,2]x");
+  verify_fail_in_chunks<std::vector<int>>("[1,2] ]");
+  verify_fail_in_chunks<std::vector<int>>("[1,\"a\"]");
+  verify_fail_in_chunks<std::vector<bool>>("[true,tru]");
+  verify_fail_in_chunks<std::vector<std::string>>(R"(["a","\x"])");
+  verify_fail_in_chunks<std::vector<std::vector<int>>>("[[1,2}]");
+  verify_fail_in_chunks<std::array<int, 2>>("[1,2,3]");
+  verify_fail_in_chunks<std::array<int, 2>>("[1]");
+  verify_fail_in_chunks<std::map<std::string, int>>(R"({"a":1,})");
+  verify_fail_in_chunks<std::map<std::string, int>>(R"({"a":1 "b":2})");
+  verify_fail_in_chunks<std::map<std::string, int>>(R"({"a" 1})");
+  verify_fail_in_chunks<std::map<std::string, int>>(R"({"a":"b"})");
+  verify_fail_in_chunks<std::map<std::string, int>>(R"({1:2})");
+  verify_fail_in_chunks<std::map<std::string, int>>(R"({[1]:2})");
+  verify_fail_in_chunks<std::map<std::string, int>>(R"({"a\x":1})");
+  verify_fail_in_chunks<std::map<std::string, int>>(R"({"a":1}})");
+  verify_fail_in_chunks<std::map<std::string, int>>("[]");
+  verify_fail_in_chunks<point_t>(R"({"x":1})");
+  verify_fail_in_chunks<point_t>(R"({"x":1,"y":"2"})");
+  verify_fail_in_chunks<point_t>(R"({"x":1,"y":2,"tags":[1]})");
+  verify_fail_in_chunks<int>("1 2");
+}
+
+BOOST_AUTO_TEST_CASE(json_chunked_decoder_should_fail_on_truncated_input) {
+  for (const std::string json : { "[", "[1", "[1,", "[\"a", "[1,2 ", "[3 , " }) {
+    auto decoder = make_chunked_decoder(default_codec<std::vector<int>>());
+    decoder.append(json.data(), json.size());
+    BOOST_CHECK(!decoder.complete());
+    BOOST_CHECK_THROW(decoder.finish(), decode_exception);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_chunked_decoder_should_fail_on_truncated_objects) {
+  for (const std::string json : { "{", R"({"a)", R"({"a")", R"({"a":)", R"({"a":1)", R"({"a":1,)" }) {
+    auto decoder = make_chunked_decoder(default_codec<std::map<std::string, int>>());
+    decoder.append(json.data(), json.size());
+    BOOST_CHECK(!decoder.complete());
+    BOOST_CHECK_THROW(decoder.finish(), decode_exception);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
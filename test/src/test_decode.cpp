@@ -18,10 +18,29 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <spotify/json/codec/any_value.hpp>
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/boolean.hpp>
+#include <spotify/json/codec/empty_as.hpp>
+#include <spotify/json/codec/enumeration.hpp>
+#include <spotify/json/codec/eq.hpp>
+#include <spotify/json/codec/ignore.hpp>
+#include <spotify/json/codec/lazy_string.hpp>
+#include <spotify/json/codec/map.hpp>
 #include <spotify/json/codec/number.hpp>
 #include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/one_of.hpp>
+#include <spotify/json/codec/smart_ptr.hpp>
+#include <spotify/json/codec/static_object.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/codec/string_view.hpp>
+#include <spotify/json/codec/transform.hpp>
+#include <spotify/json/codec/tuple.hpp>
+#include <spotify/json/codec/value.hpp>
 #include <spotify/json/decode.hpp>
+#include <spotify/json/decode_error.hpp>
 #include <spotify/json/encoded_value.hpp>
+#include <spotify/json/padded_string.hpp>
 
 BOOST_AUTO_TEST_SUITE(spotify)
 BOOST_AUTO_TEST_SUITE(json)
@@ -49,6 +68,39 @@ struct default_codec_t<custom_obj> {
   }
 };
 
+namespace {
+
+struct counted_obj {
+  std::string val;
+};
+
+size_t num_counted_codecs = 0;
+
+}  // namespace
+
+template <>
+struct default_codec_t<counted_obj> {
+  static codec::object_t<counted_obj> codec() {
+    num_counted_codecs++;
+    auto codec = codec::object<counted_obj>();
+    codec.required("x", &counted_obj::val);
+    return codec;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(json_decode_should_create_default_codec_once) {
+  BOOST_CHECK_EQUAL(decode<counted_obj>(R"({"x":"a"})").val, "a");
+  BOOST_CHECK_EQUAL(decode<counted_obj>(std::string(R"({"x":"b"})")).val, "b");
+
+  counted_obj obj;
+  BOOST_CHECK(try_decode(obj, R"({"x":"c"})"));
+  BOOST_CHECK_EQUAL(obj.val, "c");
+
+  BOOST_CHECK_EQUAL(num_counted_codecs, 1);
+  BOOST_CHECK_EQUAL(&cached_default_codec<counted_obj>(), &cached_default_codec<counted_obj>());
+  BOOST_CHECK_EQUAL(num_counted_codecs, 1);
+}
+
 BOOST_AUTO_TEST_CASE(json_decode_should_decode_from_bytes_with_custom_codec) {
   static const char * const kData = R"({"a":"e"})";
   const auto obj = decode(custom_codec(), kData, strlen(kData));
@@ -123,6 +175,30 @@ BOOST_AUTO_TEST_CASE(json_decode_should_throw_on_unexpected_trailing_input) {
   BOOST_CHECK_THROW(decode<custom_obj>(R"({"x":"h"} invalid)"), decode_exception);
 }
 
+BOOST_AUTO_TEST_CASE(json_decode_should_decode_from_padded_string_with_custom_codec) {
+  const auto obj = decode(custom_codec(), padded_string(R"({"a":"e"})"));
+  BOOST_CHECK_EQUAL(obj.val, "e");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_should_decode_from_padded_string) {
+  const auto obj = decode<custom_obj>(padded_string(R"( { "x" : "f" } )"));
+  BOOST_CHECK_EQUAL(obj.val, "f");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_padded_should_not_decode_padding) {
+  const std::string data = R"({"a":"e"})";
+  const std::string garbage = R"(,"b":"f"}   )";
+  const auto padded = data + garbage + std::string(decode_padding, '"');
+  BOOST_CHECK_EQUAL(decode_padded(custom_codec(), padded.data(), data.size()).val, "e");
+  BOOST_CHECK_THROW(decode_padded(custom_codec(), padded.data(), data.size() - 1), decode_exception);
+  BOOST_CHECK_THROW(decode_padded(custom_codec(), padded.data(), data.size() - 2), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_should_throw_on_unterminated_padded_string) {
+  BOOST_CHECK_THROW(decode<custom_obj>(padded_string(R"({"x":"h)")), decode_exception);
+  BOOST_CHECK_THROW(decode<custom_obj>(padded_string(R"({"x":"h"  )")), decode_exception);
+}
+
 BOOST_AUTO_TEST_CASE(json_try_decode_should_decode_from_bytes_with_custom_codec) {
   static const char * const kData = R"({"a":"e"})";
   custom_obj obj;
@@ -173,6 +249,176 @@ BOOST_AUTO_TEST_CASE(json_try_decode_should_decode_from_std_string) {
   BOOST_CHECK_EQUAL(obj.val, "h");
 }
 
+BOOST_AUTO_TEST_CASE(json_try_decode_with_error_should_decode) {
+  static const char * const kData = R"( {"a":"e"} )";
+  custom_obj obj;
+  decode_error error(decode_error::unexpected_input, 3);
+  BOOST_CHECK(try_decode(obj, custom_codec(), kData, strlen(kData), error));
+  BOOST_CHECK_EQUAL(obj.val, "e");
+  BOOST_CHECK(!error);
+}
+
+BOOST_AUTO_TEST_CASE(json_try_decode_with_error_should_decode_with_default_codec) {
+  int val = 12;
+  decode_error error;
+  BOOST_CHECK(try_decode(val, std::string("78"), error));
+  BOOST_CHECK_EQUAL(val, 78);
+}
+
+BOOST_AUTO_TEST_CASE(json_try_decode_with_error_should_report_invalid_json) {
+  std::vector<int> val = { 12 };
+  decode_error error;
+  BOOST_CHECK(!try_decode(val, std::string("[1,"), error));
+  BOOST_CHECK(val == std::vector<int>({ 12 }));
+  BOOST_CHECK_EQUAL(error.code(), decode_error::unexpected_end_of_input);
+  BOOST_CHECK_EQUAL(error.message(), "Unexpected end of input");
+  BOOST_CHECK_EQUAL(error.offset(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(json_try_decode_with_error_should_report_trailing_input) {
+  int val = 12;
+  decode_error error;
+  BOOST_CHECK(!try_decode(val, std::string("1 2"), error));
+  BOOST_CHECK_EQUAL(error.code(), decode_error::unexpected_trailing_input);
+  BOOST_CHECK_EQUAL(error.offset(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(json_try_decode_with_error_should_report_same_error_as_decode) {
+  const std::string json = R"({"a": "b\x"})";
+  custom_obj obj;
+  decode_error error;
+  BOOST_CHECK(!try_decode(obj, custom_codec(), json, error));
+
+  try {
+    decode(custom_codec(), json);
+    BOOST_FAIL("decode should have failed");
+  } catch (const decode_exception &exception) {
+    BOOST_CHECK_EQUAL(error.message(), exception.what());
+    BOOST_CHECK_EQUAL(error.offset(), exception.offset());
+  }
+}
+
+namespace {
+
+template <typename codec_type>
+void verify_try_decode_fails_like_decode(const codec_type &codec, const std::string &json) {
+  std::string expected_what;
+  std::size_t expected_offset = 0;
+  try {
+    decode(codec, json);
+    BOOST_FAIL("decode should have failed: " + json);
+  } catch (const decode_exception &exception) {
+    expected_what = exception.what();
+    expected_offset = exception.offset();
+  }
+
+  typename codec_type::object_type object;
+  decode_error error;
+  BOOST_CHECK_MESSAGE(!try_decode(object, codec, json, error), json);
+  BOOST_CHECK_EQUAL(error.message(), expected_what);
+  BOOST_CHECK_EQUAL(error.offset(), expected_offset);
+
+  decode_error padded_error;
+  BOOST_CHECK_MESSAGE(!try_decode(object, codec, padded_string(json), padded_error), json);
+  BOOST_CHECK_EQUAL(padded_error.message(), expected_what);
+  BOOST_CHECK_EQUAL(padded_error.offset(), expected_offset);
+}
+
+template <typename value_type>
+void verify_try_decode_fails_like_decode(const std::string &json) {
+  verify_try_decode_fails_like_decode(default_codec<value_type>(), json);
+}
+
+struct static_obj {
+  int a = 0;
+  std::string b;
+};
+
+enum class color { red, green };
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_try_decode_with_error_should_fail_like_decode) {
+  for (const auto json : { "", " ", "x", "[1,", "[1 2]", "[1,]", "[1,2]x", "{}", "[\"a\"]", "[1e999999999]" }) {
+    verify_try_decode_fails_like_decode<std::vector<int>>(json);
+  }
+  for (const auto json : { "[1.5,\"a\"]", "[1.", "[-]" }) {
+    verify_try_decode_fails_like_decode<std::vector<double>>(json);
+  }
+  for (const auto json : { "{", R"({"a")", R"({"a" 1})", R"({"a":1,})", R"({1:2})", R"({"a\x":1})", R"({"a":1}})" }) {
+    verify_try_decode_fails_like_decode<std::map<std::string, int>>(json);
+  }
+  for (const auto json : { R"("a)", R"("a\x")", R"("a\u12")", R"("a\u12g4")", R"("a\)", "1" }) {
+    verify_try_decode_fails_like_decode<std::string>(json);
+    verify_try_decode_fails_like_decode(codec::lazy_string(), json);
+  }
+  for (const auto json : { R"("a)", R"("a\n")", "1" }) {
+    verify_try_decode_fails_like_decode(codec::string_view(), json);
+  }
+  for (const auto json : { "tru", "fals", "nul", "1", "[true,fals]" }) {
+    verify_try_decode_fails_like_decode<bool>(json);
+    verify_try_decode_fails_like_decode<std::vector<bool>>(std::string("[") + json + "]");
+  }
+  for (const auto json : { "[1,2,3]", "[1]", "[1,\"a\"]" }) {
+    verify_try_decode_fails_like_decode<std::array<int, 2>>(json);
+    verify_try_decode_fails_like_decode<std::tuple<int, int>>(json);
+  }
+  for (const auto json : { "{}", R"({"a":"b","x":1})", R"({"x":1})", R"({"x":"a",)", R"({"x":"a","y":[1,}})" }) {
+    verify_try_decode_fails_like_decode<custom_obj>(json);
+  }
+  for (const auto json : { R"({"x":"a",)", R"({"x":"a","y":[1,}})" }) {
+    verify_try_decode_fails_like_decode(codec::ignore<int>(), json);
+  }
+
+  auto static_codec = codec::static_object<static_obj>(
+      codec::required_field("a", &static_obj::a, codec::number<int>()),
+      codec::optional_field("b", &static_obj::b, codec::string()));
+  for (const auto json : { "{}", R"({"b":"x"})", R"({"a":"x"})", R"({"a":1,"b":2})", R"({"a":1,"c":[})" }) {
+    verify_try_decode_fails_like_decode(static_codec, json);
+  }
+
+  const auto one_of = codec::one_of(codec::eq(1), codec::eq(2), codec::eq(3));
+  const auto empty_as = codec::empty_as_null(codec::array<std::vector<int>>(codec::number<int>()));
+  const auto colors = codec::enumeration<color, std::string>({ { color::red, "red" }, { color::green, "green" } });
+  for (const auto json : { "4", "\"a\"", "[1,x]", "null1", "nul", "\"blue\"" }) {
+    verify_try_decode_fails_like_decode(one_of, json);
+    verify_try_decode_fails_like_decode(colors, json);
+  }
+  for (const auto json : { "4", "\"a\"", "[1,x]", "null1", "nul", "[1,]" }) {
+    verify_try_decode_fails_like_decode(empty_as, json);
+  }
+  for (const auto json : { "\"a\"", "[1,x]", "null", "-", "1x" }) {
+    verify_try_decode_fails_like_decode(codec::shared_ptr(codec::number<int>()), json);
+  }
+  for (const auto json : { "[1,x]", R"({"a":[1,{"b":-}]})", R"({"a" 1})", "[\"a\" 1]", "tru", "-", "1.", "1e" }) {
+    verify_try_decode_fails_like_decode(codec::any_value(), json);
+    verify_try_decode_fails_like_decode(codec::value(), json);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_try_decode_with_error_should_report_transform_errors) {
+  const auto codec = codec::transform(
+      codec::number<int>(),
+      [](int value) { return value; },
+      [](int value) -> int { throw decode_exception("Odd number"); });
+  int val = 12;
+  decode_error error;
+  BOOST_CHECK(!try_decode(val, codec, std::string(" 1"), error));
+  BOOST_CHECK_EQUAL(val, 12);
+  BOOST_CHECK_EQUAL(error.code(), decode_error::rejected_by_codec);
+  BOOST_CHECK_EQUAL(error.message(), "Odd number");
+  BOOST_CHECK_EQUAL(error.offset(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(json_try_decode_with_error_should_report_codec_errors) {
+  const std::string json = R"({"b":"c"})";
+  custom_obj obj;
+  decode_error error;
+  BOOST_CHECK(!try_decode(obj, custom_codec(), json, error));
+  BOOST_CHECK_EQUAL(error.code(), decode_error::rejected_by_codec);
+  BOOST_CHECK_EQUAL(error.message(), "Missing required field(s)");
+}
+
 BOOST_AUTO_TEST_CASE(json_try_decode_should_decode_from_encoded_value_with_custom_codec) {
   custom_obj obj;
   BOOST_CHECK(try_decode(obj, custom_codec(), encoded_value(R"({"a":"g"})")));
@@ -197,6 +443,19 @@ BOOST_AUTO_TEST_CASE(json_try_decode_should_decode_from_encoded_value_ref) {
   BOOST_CHECK_EQUAL(obj.val, "h");
 }
 
+BOOST_AUTO_TEST_CASE(json_try_decode_should_decode_from_padded_string_with_custom_codec) {
+  custom_obj obj;
+  BOOST_CHECK(try_decode(obj, custom_codec(), padded_string(R"({"a":"g"})")));
+  BOOST_CHECK_EQUAL(obj.val, "g");
+}
+
+BOOST_AUTO_TEST_CASE(json_try_decode_should_decode_from_padded_string) {
+  custom_obj obj;
+  BOOST_CHECK(try_decode(obj, padded_string(R"({"x":"h"})")));
+  BOOST_CHECK_EQUAL(obj.val, "h");
+  BOOST_CHECK(!try_decode(obj, padded_string(R"({"x":"h")")));
+}
+
 BOOST_AUTO_TEST_CASE(json_try_decode_should_report_failure) {
   custom_obj obj;
   BOOST_CHECK(!try_decode(obj, "{}"));  // Missing field
@@ -45,6 +45,26 @@ BOOST_AUTO_TEST_CASE(json_decode_context_should_construct_with_data_size) {
   BOOST_CHECK(ctx.end == end);
 }
 
+BOOST_AUTO_TEST_CASE(json_decode_context_should_not_be_padded_by_default) {
+  static const char string[] = "abc";
+  BOOST_CHECK(!decode_context(string, string + sizeof(string)).padded);
+  BOOST_CHECK(!decode_context(string, sizeof(string)).padded);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_context_should_construct_with_padded_input) {
+  static const char string[] = "abc";
+  const char * const end = string + 1;
+  const decode_context ctx(string, end, decode_context::padded_input());
+  const decode_context ctx_size(string, 1, decode_context::padded_input());
+
+  BOOST_CHECK(ctx.begin == string);
+  BOOST_CHECK(ctx.position == string);
+  BOOST_CHECK(ctx.end == end);
+  BOOST_CHECK(ctx.padded);
+  BOOST_CHECK(ctx_size.end == end);
+  BOOST_CHECK(ctx_size.padded);
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // detail
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
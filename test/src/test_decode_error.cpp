@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/decode_error.hpp>
+#include <spotify/json/decode_exception.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+BOOST_AUTO_TEST_CASE(json_decode_error_should_default_to_no_error) {
+  const decode_error error;
+  BOOST_CHECK(!error);
+  BOOST_CHECK_EQUAL(error.code(), decode_error::none);
+  BOOST_CHECK_EQUAL(error.offset(), 0);
+  BOOST_CHECK_EQUAL(error.message(), "");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_error_should_construct_with_code_and_offset) {
+  const decode_error error(decode_error::unterminated_string, 7);
+  BOOST_CHECK(bool(error));
+  BOOST_CHECK_EQUAL(error.code(), decode_error::unterminated_string);
+  BOOST_CHECK_EQUAL(error.offset(), 7);
+  BOOST_CHECK_EQUAL(error.message(), "Unterminated string");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_error_should_format_unexpected_token) {
+  const decode_error error(decode_error::unexpected_token, 0, 'x');
+  BOOST_CHECK_EQUAL(error.token(), 'x');
+  BOOST_CHECK_EQUAL(error.message(), "Encountered token 'x'");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_error_should_construct_from_exception) {
+  const decode_error error(decode_exception("Missing required field(s)", 12));
+  BOOST_CHECK_EQUAL(error.code(), decode_error::rejected_by_codec);
+  BOOST_CHECK_EQUAL(error.offset(), 12);
+  BOOST_CHECK_EQUAL(error.message(), "Missing required field(s)");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_error_should_keep_literal_message) {
+  static const char message[] = "Integer overflow";
+  const decode_error error(message, 4);
+  BOOST_CHECK_EQUAL(error.code(), decode_error::rejected_by_codec);
+  BOOST_CHECK_EQUAL(error.offset(), 4);
+  BOOST_CHECK_EQUAL(error.message(), message);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_error_should_copy_string_message) {
+  auto message = std::string("Invalid integer");
+  const decode_error error(message, 2);
+  message.clear();
+  BOOST_CHECK_EQUAL(error.message(), "Invalid integer");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_error_should_compute_line_and_column) {
+  static const char data[] = "{\n  \"a\": 1,\n  \"b\": ?\n}";
+  const decode_error first(decode_error::unexpected_input, 0);
+  BOOST_CHECK_EQUAL(first.line(data), 1);
+  BOOST_CHECK_EQUAL(first.column(data), 1);
+
+  const decode_error error(decode_error::unexpected_token, 19, '?');
+  BOOST_CHECK_EQUAL(error.line(data), 3);
+  BOOST_CHECK_EQUAL(error.column(data), 8);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_error_should_raise_decode_exception) {
+  const decode_error error(decode_error::expected_digit, 3);
+  try {
+    error.raise();
+    BOOST_FAIL("raise should throw");
+  } catch (const decode_exception &exception) {
+    BOOST_CHECK_EQUAL(std::string(exception.what()), "Expected digit");
+    BOOST_CHECK_EQUAL(exception.offset(), 3);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
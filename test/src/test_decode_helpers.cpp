@@ -14,13 +14,16 @@
  * the License.
  */
 
+#include <string>
 #include <type_traits>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
 #include <spotify/json/codec/boolean.hpp>
 #include <spotify/json/codec/omit.hpp>
 #include <spotify/json/detail/decode_helpers.hpp>
+#include <spotify/json/detail/decode_string.hpp>
 
 BOOST_AUTO_TEST_SUITE(spotify)
 BOOST_AUTO_TEST_SUITE(json)
@@ -457,6 +460,40 @@ BOOST_AUTO_TEST_CASE(json_decode_helpers_decode_object_without_ending_brace) {
   }), decode_exception);
 }
 
+BOOST_AUTO_TEST_CASE(json_decode_helpers_decode_object_raw_keys_in_place) {
+  auto ctx = make_context(R"({ "a" : true , "bc":false,"":true})");
+  const auto original_ctx = ctx;
+  std::vector<std::string> keys;
+  decode_object_raw_keys(ctx, [&](const char *key, size_t size) {
+    BOOST_CHECK(key > original_ctx.begin && key + size < original_ctx.end);
+    keys.emplace_back(key, size);
+    decode_boolean(ctx);
+  });
+  BOOST_CHECK(keys == std::vector<std::string>({ "a", "bc", "" }));
+  BOOST_CHECK(ctx.position == original_ctx.end);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_helpers_decode_object_raw_keys_with_escapes) {
+  auto ctx = make_context(R"({"a\"b":true,"\u0063d":false})");
+  const auto original_ctx = ctx;
+  std::vector<std::string> keys;
+  decode_object_raw_keys(ctx, [&](const char *key, size_t size) {
+    keys.emplace_back(key, size);
+    decode_boolean(ctx);
+  });
+  BOOST_CHECK(keys == std::vector<std::string>({ "a\"b", "cd" }));
+  BOOST_CHECK(ctx.position == original_ctx.end);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_helpers_decode_object_raw_keys_with_broken_key) {
+  for (const auto json : { R"({"a:true})", R"({a:true})", R"({"a\x":true})", R"({"a" true})" }) {
+    auto ctx = make_context(json);
+    BOOST_CHECK_THROW(decode_object_raw_keys(ctx, [&](const char *key, size_t size) {
+      BOOST_CHECK(!"Should not be called");
+    }), decode_exception);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // detail
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
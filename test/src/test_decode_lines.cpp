@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/codec/transform.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/decode_lines.hpp>
+#include <spotify/json/default_codec.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+/**
+ * Decode each line on its own with json::decode, which is what decode_lines
+ * must be equivalent to.
+ */
+template <typename value_type>
+decoded_lines<value_type> decode_lines_one_by_one(const std::string &json) {
+  decoded_lines<value_type> result;
+  std::size_t line = 1;
+  for (std::size_t begin = 0; begin < json.size(); line++) {
+    auto end = json.find('\n', begin);
+    end = (end == std::string::npos ? json.size() : end);
+    const auto text = json.substr(begin, end - begin);
+    if (text.find_first_not_of(" \t\r") != std::string::npos) {
+      try {
+        result.values.push_back(decode<value_type>(text));
+      } catch (const decode_exception &exception) {
+        result.errors.emplace_back(line, exception.offset(), exception.what());
+      }
+    }
+    begin = end + 1;
+  }
+  return result;
+}
+
+template <typename value_type>
+void verify_decode_lines(const std::string &json, const std::size_t num_threads) {
+  const auto expected = decode_lines_one_by_one<value_type>(json);
+  const auto result = decode_lines<value_type>(json, num_threads);
+  BOOST_CHECK(result.values == expected.values);
+  BOOST_REQUIRE_EQUAL(result.errors.size(), expected.errors.size());
+  for (std::size_t i = 0; i < result.errors.size(); i++) {
+    BOOST_CHECK_EQUAL(result.errors[i].line, expected.errors[i].line);
+    BOOST_CHECK_EQUAL(result.errors[i].offset, expected.errors[i].offset);
+    BOOST_CHECK_EQUAL(result.errors[i].what, expected.errors[i].what);
+  }
+}
+
+std::string make_lines(const std::size_t num_lines) {
+  std::string json;
+  for (std::size_t i = 0; i < num_lines; i++) {
+    switch (i % 7) {
+      case 0: json += "[]\n"; break;
+      case 1: json += "[" + std::to_string(i) + "," + std::to_string(i) + "]\n"; break;
+      case 2: json += "\n"; break;
+      case 3: json += " [ " + std::to_string(i) + " ]\r\n"; break;
+      case 4: json += "[" + std::to_string(i) + ",]\n"; break;
+      case 5: json += "[" + std::string(i % 500, '1') + "]\n"; break;
+      case 6: json += "[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15]\n"; break;
+    }
+  }
+  return json;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_decode_lines_should_decode_lines_in_order) {
+  const auto result = decode_lines<std::vector<int>>(std::string("[1]\n[2,3]\n[]\n"));
+  BOOST_REQUIRE_EQUAL(result.values.size(), 3);
+  BOOST_CHECK(result.values[0] == std::vector<int>({ 1 }));
+  BOOST_CHECK(result.values[1] == std::vector<int>({ 2, 3 }));
+  BOOST_CHECK(result.values[2].empty());
+  BOOST_CHECK(result.errors.empty());
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_lines_should_decode_with_codec) {
+  const auto result = decode_lines(codec::string(), std::string("\"a\"\n\"b\""));
+  BOOST_CHECK(result.values == std::vector<std::string>({ "a", "b" }));
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_lines_should_decode_last_line_without_newline) {
+  const auto result = decode_lines<int>(std::string("1\n2"));
+  BOOST_CHECK(result.values == std::vector<int>({ 1, 2 }));
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_lines_should_skip_blank_lines) {
+  const auto result = decode_lines<int>(std::string("\n1\n\n \t\r\n2\n\n"));
+  BOOST_CHECK(result.values == std::vector<int>({ 1, 2 }));
+  BOOST_CHECK(result.errors.empty());
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_lines_should_accept_crlf) {
+  const auto result = decode_lines<int>(std::string("1\r\n2\r\n"));
+  BOOST_CHECK(result.values == std::vector<int>({ 1, 2 }));
+  BOOST_CHECK(result.errors.empty());
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_lines_should_decode_empty_input) {
+  const auto result = decode_lines<int>(std::string(""));
+  BOOST_CHECK(result.values.empty());
+  BOOST_CHECK(result.errors.empty());
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_lines_should_report_errors_with_line_numbers) {
+  const auto result = decode_lines<std::vector<int>>(std::string("[1]\n[1,]\n\n[2]\n  [x]"));
+  BOOST_CHECK(result.values == std::vector<std::vector<int>>({ { 1 }, { 2 } }));
+  BOOST_REQUIRE_EQUAL(result.errors.size(), 2);
+  BOOST_CHECK_EQUAL(result.errors[0].line, 2);
+  BOOST_CHECK_EQUAL(result.errors[0].offset, 4);
+  BOOST_CHECK_EQUAL(result.errors[1].line, 5);
+  BOOST_CHECK_EQUAL(result.errors[1].offset, 4);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_lines_should_report_exceptions_from_codecs) {
+  const auto codec = codec::transform(
+      codec::number<int>(),
+      [](int value) { return value; },
+      [](int value) {
+        if (value < 0) {
+          throw std::runtime_error("negative");
+        }
+        return value;
+      });
+
+  const auto result = decode_lines(codec, std::string("1\n-1\n2"), 2);
+  BOOST_CHECK(result.values == std::vector<int>({ 1, 2 }));
+  BOOST_REQUIRE_EQUAL(result.errors.size(), 1);
+  BOOST_CHECK_EQUAL(result.errors[0].line, 2);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_lines_should_not_split_lines_across_batches) {
+  const auto json = make_lines(100000);
+  BOOST_REQUIRE_GT(json.size(), 4 * detail::decode_lines_batch_size);
+  for (const std::size_t num_threads : { 1, 2, 3, 8 }) {
+    verify_decode_lines<std::vector<int>>(json, num_threads);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_lines_should_handle_lines_longer_than_a_batch) {
+  const auto long_line = "[" + std::string(3 * detail::decode_lines_batch_size, '1') + "]\n";
+  verify_decode_lines<std::vector<int>>("[1]\n" + long_line + "[2]\n" + long_line + "[3]", 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
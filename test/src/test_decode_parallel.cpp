@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/boolean.hpp>
+#include <spotify/json/codec/map.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/decode_parallel.hpp>
+#include <spotify/json/default_codec.hpp>
+#include <spotify/json/encode.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+struct record {
+  std::string name;
+  std::vector<int> values;
+};
+
+codec::object_t<record> record_codec() {
+  auto codec = codec::object<record>();
+  codec.required("name", &record::name);
+  codec.optional("values", &record::values);
+  return codec;
+}
+
+bool operator==(const record &a, const record &b) {
+  return a.name == b.name && a.values == b.values;
+}
+
+/**
+ * An array with enough records to be split into many slices.
+ */
+std::string make_records_json(const std::size_t num_records) {
+  std::string json = " [ ";
+  for (std::size_t i = 0; i < num_records; i++) {
+    json += (i ? ",\n" : "");
+    json += R"({"name":"record \")" + std::to_string(i) + R"(\"","values":[)";
+    json += std::to_string(i) + "," + std::to_string(i % 7) + R"(],"ignored":{"a":"]"}})";
+  }
+  return json + " ]\n";
+}
+
+std::string make_map_json(const std::size_t num_entries) {
+  std::string json = "{";
+  for (std::size_t i = 0; i < num_entries; i++) {
+    json += (i ? "," : "");
+    json += "\"key" + std::to_string(i % (num_entries - 100)) + "\" : " + std::to_string(i);
+  }
+  return json + "}";
+}
+
+template <typename codec_type>
+void verify_decode_parallel(const codec_type &codec, const std::string &json) {
+  const auto expected = decode(codec, json);
+  for (const std::size_t num_threads : { 1, 2, 3, 8 }) {
+    BOOST_CHECK(decode_parallel(codec, json, num_threads) == expected);
+  }
+}
+
+template <typename codec_type>
+void verify_fail_parallel(const codec_type &codec, const std::string &json) {
+  std::string expected_what;
+  std::size_t expected_offset = 0;
+  try {
+    decode(codec, json);
+    BOOST_FAIL("decode should have failed");
+  } catch (const decode_exception &exception) {
+    expected_what = exception.what();
+    expected_offset = exception.offset();
+  }
+
+  for (const std::size_t num_threads : { 1, 4 }) {
+    try {
+      decode_parallel(codec, json, num_threads);
+      BOOST_FAIL("decode_parallel should have failed");
+    } catch (const decode_exception &exception) {
+      BOOST_CHECK_EQUAL(exception.what(), expected_what);
+      BOOST_CHECK_EQUAL(exception.offset(), expected_offset);
+    }
+  }
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_decode_parallel_should_decode_small_containers) {
+  verify_decode_parallel(default_codec<std::vector<int>>(), "[]");
+  verify_decode_parallel(default_codec<std::vector<int>>(), " [ 1 , 2 ] ");
+  verify_decode_parallel(default_codec<std::map<std::string, int>>(), "{}");
+  verify_decode_parallel(default_codec<std::map<std::string, int>>(), R"({"a":1,"b":2})");
+  verify_decode_parallel(default_codec<std::array<int, 3>>(), "[1,2,3]");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_parallel_should_decode_large_arrays) {
+  const auto codec = codec::array<std::vector<record>>(record_codec());
+  const auto json = make_records_json(100000);
+  BOOST_REQUIRE_GT(json.size(), 8 * detail::decode_parallel_min_slice_size);
+  verify_decode_parallel(codec, json);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_parallel_should_split_at_element_boundaries) {
+  // Strings full of quotes, backslashes, brackets and commas, and nested
+  // arrays, so that slices start in all kinds of places.
+  std::vector<std::vector<std::string>> values;
+  for (std::size_t i = 0; values.size() < 40000; i++) {
+    const auto text = std::string(i % 13, '\\') + "\",[{}]" + std::string(i % 5, '"');
+    values.push_back(std::vector<std::string>(i % 4, text));
+  }
+
+  const auto codec = default_codec<std::vector<std::vector<std::string>>>();
+  const auto json = encode(codec, values);
+  BOOST_REQUIRE_GT(json.size(), 4 * detail::decode_parallel_min_slice_size);
+  BOOST_CHECK(decode_parallel(codec, json, 4) == values);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_parallel_should_decode_large_maps) {
+  const auto json = make_map_json(100000);
+  BOOST_REQUIRE_GT(json.size(), 4 * detail::decode_parallel_min_slice_size);
+  verify_decode_parallel(default_codec<std::map<std::string, int>>(), json);
+  verify_decode_parallel(default_codec<std::unordered_map<std::string, int>>(), json);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_parallel_should_keep_the_first_of_duplicate_keys) {
+  const auto json = make_map_json(100000);
+  const auto map = decode_parallel<std::map<std::string, int>>(json);
+  BOOST_CHECK_EQUAL(map.at("key0"), 0);
+  BOOST_CHECK_EQUAL(map.size(), 100000 - 100);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_parallel_should_decode_other_values) {
+  verify_decode_parallel(default_codec<std::string>(), R"("[1,2]")");
+  verify_decode_parallel(record_codec(), R"({"name":"a"})");
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_parallel_should_fail_like_decode) {
+  const auto codec = codec::array<std::vector<record>>(record_codec());
+  auto json = make_records_json(100000);
+  verify_fail_parallel(codec, json + "x");
+  verify_fail_parallel(codec, json.substr(0, json.size() - 3));
+  verify_fail_parallel(codec, json.substr(0, json.size() / 2));
+
+  // An error that skip_value finds, late in the array.
+  auto invalid_json = json;
+  invalid_json.replace(invalid_json.size() - 100, 1, "?");
+  verify_fail_parallel(codec, invalid_json);
+
+  // Valid JSON that the codec rejects, in the middle of the array.
+  auto missing_field_json = json;
+  missing_field_json.replace(json.find("\"name\"", json.size() / 2), 6, "\"nome\"");
+  verify_fail_parallel(codec, missing_field_json);
+
+  verify_fail_parallel(default_codec<std::vector<int>>(), "[1,2,]");
+  verify_fail_parallel(default_codec<std::vector<int>>(), "[1,true]");
+  verify_fail_parallel(default_codec<std::vector<int>>(), "{}");
+  verify_fail_parallel(default_codec<std::array<int, 2>>(), "[1,2,3]");
+  verify_fail_parallel(default_codec<std::array<int, 2>>(), "[1]");
+  verify_fail_parallel(default_codec<std::map<std::string, int>>(), R"({"a":1,2:3})");
+  verify_fail_parallel(default_codec<std::map<std::string, int>>(), R"({"a":1,"b"})");
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
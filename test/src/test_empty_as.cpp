@@ -55,6 +55,32 @@ void test_decode_fail(const Codec &codec, const std::string &json) {
   BOOST_CHECK_THROW(codec.decode(c), decode_exception);
 }
 
+/**
+ * A string codec that counts how many times it has been asked to decode.
+ */
+template <bool has_first_tokens>
+struct counting_string_t {
+  using object_type = std::string;
+
+  object_type decode(decode_context &context) const {
+    ++*calls;
+    return string().decode(context);
+  }
+
+  void encode(encode_context &context, const object_type &value) const {
+    string().encode(context, value);
+  }
+
+  std::shared_ptr<int> calls = std::make_shared<int>(0);
+};
+
+template <>
+struct counting_string_t<true> : counting_string_t<false> {
+  unsigned first_tokens() const {
+    return detail::token_string;
+  }
+};
+
 }  // namespace
 
 /*
@@ -103,6 +129,41 @@ BOOST_AUTO_TEST_CASE(json_codec_empty_as_should_fail_on_invalid_input) {
   test_decode_fail(codec, "[{},true]");
 }
 
+BOOST_AUTO_TEST_CASE(json_codec_empty_as_should_decode_null_without_trying_inner) {
+  const auto inner = counting_string_t<true>();
+  const auto codec = empty_as_null(inner);
+  BOOST_CHECK_EQUAL(test_decode(codec, "null"), "");
+  BOOST_CHECK_EQUAL(test_decode(codec, "\"a\""), "a");
+  BOOST_CHECK_EQUAL(*inner.calls, 1);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_empty_as_should_try_inner_without_first_tokens) {
+  const auto inner = counting_string_t<false>();
+  const auto codec = empty_as_null(inner);
+  BOOST_CHECK_EQUAL(test_decode(codec, "null"), "");
+  BOOST_CHECK_EQUAL(*inner.calls, 1);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_empty_as_should_fail_with_error_of_inner) {
+  const auto codec = empty_as_null(string());
+  for (const std::string json : { "nul", "1", "{}" }) {
+    decode_context c(json.c_str(), json.c_str() + json.size());
+    decode_context expected_c(json.c_str(), json.c_str() + json.size());
+    try {
+      string().decode(expected_c);
+      BOOST_FAIL("string codec should fail");
+    } catch (const decode_exception &expected) {
+      try {
+        codec.decode(c);
+        BOOST_FAIL("empty_as codec should fail");
+      } catch (const decode_exception &exception) {
+        BOOST_CHECK_EQUAL(std::string(exception.what()), expected.what());
+        BOOST_CHECK_EQUAL(exception.offset(), expected.offset());
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(json_codec_empty_as_with_eq) {
   const auto codec = empty_as(eq(123), number<int>());
   BOOST_CHECK_EQUAL(encode(codec, 0), "123");
@@ -85,6 +85,24 @@ BOOST_AUTO_TEST_CASE(json_encode_context_should_append_single_byte) {
   BOOST_CHECK_EQUAL(ctx.data()[1], '2');
 }
 
+BOOST_AUTO_TEST_CASE(json_encode_context_should_replace_written_byte) {
+  encode_context ctx;
+  ctx.append("abc", 3);
+  ctx.replace(1, 'x');
+  BOOST_REQUIRE_EQUAL(ctx.size(), 3);
+  BOOST_CHECK_EQUAL(std::string(ctx.data(), ctx.size()), "axc");
+}
+
+BOOST_AUTO_TEST_CASE(json_encode_context_should_retreat_and_keep_bytes) {
+  encode_context ctx;
+  ctx.append("abc", 3);
+  ctx.retreat(2);
+  BOOST_REQUIRE_EQUAL(ctx.size(), 1);
+  const auto buffer = ctx.reserve(2);
+  BOOST_CHECK_EQUAL(buffer[0], 'b');
+  BOOST_CHECK_EQUAL(buffer[1], 'c');
+}
+
 BOOST_AUTO_TEST_CASE(json_encode_context_should_replace_last_byte) {
   encode_context ctx;
   ctx.append('1');
@@ -22,6 +22,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <spotify/json/detail/escape.hpp>
+#include <spotify/json/instruction_set.hpp>
 
 BOOST_AUTO_TEST_SUITE(spotify)
 BOOST_AUTO_TEST_SUITE(json)
@@ -30,10 +31,96 @@ BOOST_AUTO_TEST_SUITE(detail)
 using namespace std;
 using namespace boost;
 
-void check_escaped(const std::string &expected, const std::string &input) {
+namespace {
+
+const instruction_set all_instruction_sets[] = {
+  instruction_set::scalar,
+  instruction_set::sse42,
+  instruction_set::avx2,
+  instruction_set::avx512bw
+};
+
+/**
+ * Use the given instruction set (or the best supported one below it) for as
+ * long as the object lives.
+ */
+struct scoped_instruction_set {
+  explicit scoped_instruction_set(const instruction_set set)
+      : _previous(active_instruction_set()) {
+    use_instruction_set(set);
+  }
+
+  ~scoped_instruction_set() {
+    use_instruction_set(_previous);
+  }
+
+ private:
+  const instruction_set _previous;
+};
+
+std::string escaped(const std::string &input) {
   encode_context context;
   write_escaped(context, input.data(), input.data() + input.size());
-  BOOST_CHECK_EQUAL(expected, std::string(context.data(), context.size()));
+  return std::string(context.data(), context.size());
+}
+
+std::string escaped_scalar(const std::string &input) {
+  encode_context context;
+  write_escaped_scalar(context, input.data(), input.data() + input.size());
+  return std::string(context.data(), context.size());
+}
+
+/**
+ * A string of the given length where every period:th character (starting at
+ * offset) is taken from the characters that need escaping, in turn.
+ */
+std::string generate(const std::size_t length, const std::size_t period, const std::size_t offset) {
+  static const char special[] = { '"', '\\', '\n', '\t', '\0', '\x1F', '\b', '\r', '\f', '\x0B' };
+  std::string result;
+  for (std::size_t i = 0; i < length; i++) {
+    result += (i % period == offset % period) ?
+        special[(i / period) % sizeof(special)] :
+        char('a' + i % 26);
+  }
+  return result;
+}
+
+}  // namespace
+
+void check_escaped(const std::string &expected, const std::string &input) {
+  for (const auto set : all_instruction_sets) {
+    scoped_instruction_set scoped(set);
+    BOOST_CHECK_EQUAL(expected, escaped(input));
+  }
+}
+
+void check_escaped(const escape_policy policy, const std::string &expected, const std::string &input) {
+  for (const auto set : all_instruction_sets) {
+    scoped_instruction_set scoped(set);
+    encode_context context;
+    write_escaped(context, input.data(), input.data() + input.size(), policy);
+    BOOST_CHECK_EQUAL(expected, std::string(context.data(), context.size()));
+  }
+}
+
+/**
+ * A string of the given length with characters that the policies escape
+ * differently, including UTF-8 sequences (and invalid ones) that straddle
+ * chunks and blocks, every period:th character.
+ */
+std::string generate_mixed(const std::size_t length, const std::size_t period) {
+  static const char *special[] = {
+    "<", "&", "\"", "\n", "\x01", "\xC3\xA5", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xFF", "\x80"
+  };
+  std::string result;
+  for (std::size_t i = 0; result.size() < length; i++) {
+    if (i % period == 0) {
+      result += special[(i / period) % 10];
+    } else {
+      result += char('a' + i % 26);
+    }
+  }
+  return result;
 }
 
 BOOST_AUTO_TEST_CASE(json_write_escaped_should_escape_special_characters) {
@@ -64,6 +151,83 @@ BOOST_AUTO_TEST_CASE(json_write_escaped_should_escape_other_control_characters)
   }
 }
 
+BOOST_AUTO_TEST_CASE(json_write_escaped_should_escape_like_the_scalar_kernel) {
+  for (const auto period : { 1, 2, 3, 7, 8, 9, 31, 32, 33, 100 }) {
+    for (const auto length : { 1, 15, 16, 17, 31, 32, 33, 64, 95, 1023, 1024, 1025, 3000 }) {
+      for (const auto offset : { 0, 5 }) {
+        const auto input = generate(length, period, offset);
+        check_escaped(escaped_scalar(input), input);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_write_escaped_should_escape_characters_after_null) {
+  std::string input, expected;
+  for (int i = 0; i < 8; i++) {
+    input += std::string(1, '\0') + std::string(i, 'a') + "\n";
+    expected += "\\u0000" + std::string(i, 'a') + "\\n";
+  }
+  check_escaped(expected, input);
+}
+
+BOOST_AUTO_TEST_CASE(json_write_escaped_should_reserve_room_one_block_at_a_time) {
+  const auto input = std::string(1 << 20, 'a');
+  for (const auto set : all_instruction_sets) {
+    scoped_instruction_set scoped(set);
+    encode_context context(0);
+    write_escaped(context, input.data(), input.data() + input.size());
+    BOOST_CHECK_EQUAL(context.size(), input.size());
+    BOOST_CHECK_LE(context.capacity(), 2 * input.size() + 16 * 1024);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_write_escaped_should_escape_non_ascii_characters_with_ascii_policy) {
+  check_escaped(escape_policy::ascii, "a\\u00E5b", "a\xC3\xA5" "b");
+  check_escaped(escape_policy::ascii, "\\u20AC", "\xE2\x82\xAC");
+  check_escaped(escape_policy::ascii, "\\uD83D\\uDE00", "\xF0\x9F\x98\x80");
+  check_escaped(escape_policy::ascii, "\\uFFFF\\u0080\\u07FF", "\xEF\xBF\xBF\xC2\x80\xDF\xBF");
+  check_escaped(escape_policy::ascii, "\\\"\\n\\u0001<&>", "\"\n\x01<&>");
+}
+
+BOOST_AUTO_TEST_CASE(json_write_escaped_should_replace_invalid_utf8_with_ascii_policy) {
+  check_escaped(escape_policy::ascii, "\\uFFFD", "\xFF");
+  check_escaped(escape_policy::ascii, "\\uFFFDa", "\x80" "a");
+  check_escaped(escape_policy::ascii, "\\uFFFD\\uFFFD", "\xE2\x82");  // cut off
+  check_escaped(escape_policy::ascii, "\\uFFFD\\uFFFD", "\xC0\xAF");  // overlong
+  check_escaped(escape_policy::ascii, "\\uFFFD\\uFFFD\\uFFFD", "\xED\xA0\x80");  // surrogate
+}
+
+BOOST_AUTO_TEST_CASE(json_write_escaped_should_escape_html_characters_with_html_safe_policy) {
+  check_escaped(
+      escape_policy::html_safe,
+      "\\u003C/script\\u003E \\u0026 \\\" \xC3\xA5",
+      "</script> & \" \xC3\xA5");
+}
+
+BOOST_AUTO_TEST_CASE(json_write_escaped_should_copy_with_trusted_policy) {
+  check_escaped(escape_policy::trusted, "a\"\n\\<", "a\"\n\\<");
+  check_escaped(escape_policy::trusted, "", "");
+}
+
+BOOST_AUTO_TEST_CASE(json_write_escaped_should_escape_like_the_scalar_kernel_with_policies) {
+  const std::pair<escape_policy, kernel_table::escape_function> policies[] = {
+    { escape_policy::ascii, &write_escaped_ascii_scalar },
+    { escape_policy::html_safe, &write_escaped_html_scalar }
+  };
+
+  for (const auto &policy : policies) {
+    for (const auto period : { 1, 2, 7, 8, 9, 33, 100 }) {
+      for (const auto length : { 1, 15, 31, 32, 33, 64, 1023, 1024, 1025, 3000 }) {
+        const auto input = generate_mixed(length, period);
+        encode_context expected;
+        policy.second(expected, input.data(), input.data() + input.size());
+        check_escaped(policy.first, std::string(expected.data(), expected.size()), input);
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(json_write_escaped_should_escape_zero_sized_nullptr) {
   encode_context context;
   write_escaped(context, nullptr, 0);
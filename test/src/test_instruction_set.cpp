@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/decode_context.hpp>
+#include <spotify/json/detail/escape.hpp>
+#include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/encode_context.hpp>
+#include <spotify/json/instruction_set.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+BOOST_AUTO_TEST_CASE(json_instruction_set_should_be_at_most_the_supported_one) {
+  BOOST_CHECK(active_instruction_set() <= supported_instruction_set());
+}
+
+BOOST_AUTO_TEST_CASE(json_instruction_set_should_use_scalar_instruction_set) {
+  const auto previous = active_instruction_set();
+  BOOST_CHECK(use_instruction_set(instruction_set::scalar) == instruction_set::scalar);
+  BOOST_CHECK(active_instruction_set() == instruction_set::scalar);
+  use_instruction_set(previous);
+  BOOST_CHECK(active_instruction_set() == previous);
+}
+
+BOOST_AUTO_TEST_CASE(json_instruction_set_should_fall_back_to_supported_instruction_set) {
+  const auto previous = active_instruction_set();
+  BOOST_CHECK(use_instruction_set(instruction_set::avx512bw) == supported_instruction_set());
+  BOOST_CHECK(active_instruction_set() == supported_instruction_set());
+  use_instruction_set(previous);
+}
+
+BOOST_AUTO_TEST_CASE(json_instruction_set_should_not_change_results) {
+  const auto previous = active_instruction_set();
+  const std::string input(" \t\r\n   \n\n\t\t  abc\x01\"\\ def\"    ");
+
+  for (auto set : { instruction_set::scalar, instruction_set::sse42, instruction_set::avx2, instruction_set::avx512bw }) {
+    use_instruction_set(set);
+
+    auto context = decode_context(input.data(), input.size());
+    detail::skip_any_whitespace(context);
+    BOOST_CHECK_EQUAL(context.offset(), 13);
+    detail::skip_any_simple_characters(context);
+    BOOST_CHECK_EQUAL(context.offset(), 17);
+
+    encode_context encode;
+    detail::write_escaped(encode, input.data(), input.data() + input.size());
+    BOOST_CHECK_EQUAL(
+        std::string(encode.data(), encode.size()),
+        " \\t\\r\\n   \\n\\n\\t\\t  abc\\u0001\\\"\\\\ def\\\"    ");
+  }
+
+  use_instruction_set(previous);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/detail/key_index.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(detail)
+
+namespace {
+
+key_index make_index(const std::size_t num_keys) {
+  key_index index;
+  for (std::size_t i = 0; i < num_keys; i++) {
+    BOOST_REQUIRE(index.insert("key_" + std::to_string(i)));
+  }
+  return index;
+}
+
+void check_index(const key_index &index, const std::size_t num_keys) {
+  BOOST_CHECK_EQUAL(index.size(), num_keys);
+  for (std::size_t i = 0; i < num_keys; i++) {
+    BOOST_CHECK_EQUAL(index.find("key_" + std::to_string(i)), i);
+    BOOST_CHECK_EQUAL(index.find("kex_" + std::to_string(i)), key_index::npos);
+    BOOST_CHECK_EQUAL(index.find("key_" + std::to_string(i) + "_suffix"), key_index::npos);
+  }
+
+  BOOST_CHECK_EQUAL(index.find(""), key_index::npos);
+  BOOST_CHECK_EQUAL(index.find("key_"), key_index::npos);
+  BOOST_CHECK_EQUAL(index.find("key_" + std::to_string(num_keys)), key_index::npos);
+  BOOST_CHECK_EQUAL(index.find("other"), key_index::npos);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_key_index_should_find_nothing_when_empty) {
+  const key_index index;
+  BOOST_CHECK_EQUAL(index.size(), 0);
+  BOOST_CHECK_EQUAL(index.find(""), key_index::npos);
+  BOOST_CHECK_EQUAL(index.find("key"), key_index::npos);
+}
+
+BOOST_AUTO_TEST_CASE(json_key_index_should_find_few_keys) {
+  check_index(make_index(1), 1);
+  check_index(make_index(key_index::max_linear_keys), key_index::max_linear_keys);
+}
+
+BOOST_AUTO_TEST_CASE(json_key_index_should_find_many_keys) {
+  for (std::size_t n = key_index::max_linear_keys + 1; n < 100; n++) {
+    check_index(make_index(n), n);
+  }
+  check_index(make_index(5000), 5000);
+}
+
+BOOST_AUTO_TEST_CASE(json_key_index_should_reject_duplicate_keys) {
+  auto index = make_index(100);
+  BOOST_CHECK(!index.insert("key_0"));
+  BOOST_CHECK(!index.insert("key_99"));
+  BOOST_CHECK_EQUAL(index.size(), 100);
+  BOOST_CHECK(index.insert("key_100"));
+  BOOST_CHECK_EQUAL(index.find("key_100"), 100);
+}
+
+BOOST_AUTO_TEST_CASE(json_key_index_should_compare_bytes_after_prefix) {
+  for (const auto num_fillers : { std::size_t(0), std::size_t(100) }) {
+    auto index = make_index(num_fillers);
+    BOOST_REQUIRE(index.insert("abcdefgh_long_key_1"));
+    BOOST_REQUIRE(index.insert("abcdefgh_long_key_2"));
+    BOOST_REQUIRE(index.insert("abcdefgh"));
+    BOOST_REQUIRE(index.insert(""));
+    BOOST_CHECK_EQUAL(index.find("abcdefgh_long_key_1"), num_fillers + 0);
+    BOOST_CHECK_EQUAL(index.find("abcdefgh_long_key_2"), num_fillers + 1);
+    BOOST_CHECK_EQUAL(index.find("abcdefgh"), num_fillers + 2);
+    BOOST_CHECK_EQUAL(index.find(""), num_fillers + 3);
+    BOOST_CHECK_EQUAL(index.find("abcdefgh_long_key_3"), key_index::npos);
+    BOOST_CHECK_EQUAL(index.find("abcdefgh_long_key_"), key_index::npos);
+    BOOST_CHECK_EQUAL(index.find("abcdefg"), key_index::npos);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_key_index_should_compare_every_byte_of_short_keys) {
+  key_index index;
+  for (std::size_t size = 1; size <= 8; size++) {
+    for (std::size_t i = 0; i < size; i++) {
+      auto key = std::string(size, 'a');
+      key[i] = 'b';
+      BOOST_REQUIRE(index.insert(key));
+    }
+  }
+
+  std::size_t expected_index = 0;
+  for (std::size_t size = 1; size <= 8; size++) {
+    BOOST_CHECK_EQUAL(index.find(std::string(size, 'a')), key_index::npos);
+    for (std::size_t i = 0; i < size; i++) {
+      auto key = std::string(size, 'a');
+      key[i] = 'b';
+      BOOST_CHECK_EQUAL(index.find(key), expected_index++);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_key_index_should_handle_embedded_null_characters) {
+  auto index = make_index(20);
+  BOOST_REQUIRE(index.insert(std::string("a\0b", 3)));
+  BOOST_CHECK_EQUAL(index.find(std::string("a\0b", 3)), 20);
+  BOOST_CHECK_EQUAL(index.find(std::string("a\0c", 3)), key_index::npos);
+  BOOST_CHECK_EQUAL(index.find(std::string("a\0", 2)), key_index::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // detail
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/lazy_string.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/encode.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(codec)
+
+namespace {
+
+raw_string lazy_string_parse(const std::string &string) {
+  const auto codec = lazy_string();
+  auto ctx = decode_context(string.data(), string.data() + string.size());
+  const auto result = codec.decode(ctx);
+  BOOST_CHECK_EQUAL(ctx.position, ctx.end);
+  return result;
+}
+
+std::string encode_with_policy(const raw_string &string, const escape_policy escaping) {
+  encode_context context;
+  context.escaping = escaping;
+  lazy_string().encode(context, string);
+  return std::string(context.data(), context.size());
+}
+
+void lazy_string_parse_fail(const std::string &string) {
+  auto ctx = decode_context(string.data(), string.data() + string.size());
+  BOOST_CHECK_THROW(lazy_string().decode(ctx), decode_exception);
+}
+
+}  // namespace
+
+/*
+ * Constructing
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_lazy_string_should_construct_with_helper) {
+  lazy_string();
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_lazy_string_should_construct_with_default_codec) {
+  default_codec<raw_string>();
+}
+
+/*
+ * Decoding
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_lazy_string_should_decode_simple_string_in_place) {
+  const auto json = std::string("\"abc\"");
+  const auto string = lazy_string_parse(json);
+  BOOST_CHECK(!string.has_escapes());
+  BOOST_CHECK_EQUAL(string.escaped_data(), json.data() + 1);
+  BOOST_CHECK_EQUAL(string.escaped_size(), 3);
+  BOOST_CHECK_EQUAL(string.str(), "abc");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_lazy_string_should_decode_empty_string) {
+  const auto string = lazy_string_parse("\"\"");
+  BOOST_CHECK(!string.has_escapes());
+  BOOST_CHECK_EQUAL(string.str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_lazy_string_should_decode_escaped_string_in_place) {
+  const auto json = std::string("\"a\\nb\\u20AC\\\"\"");
+  const auto string = lazy_string_parse(json);
+  BOOST_CHECK(string.has_escapes());
+  BOOST_CHECK_EQUAL(string.escaped_data(), json.data() + 1);
+  BOOST_CHECK_EQUAL(string.escaped_size(), json.size() - 2);
+  BOOST_CHECK_EQUAL(string.str(), "a\nb\xE2\x82\xAC\"");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_lazy_string_should_decode_escaped_characters) {
+  BOOST_CHECK_EQUAL(lazy_string_parse("\"\\\"\"").str(), "\"");
+  BOOST_CHECK_EQUAL(lazy_string_parse("\"\\/\"").str(), "/");
+  BOOST_CHECK_EQUAL(lazy_string_parse("\"\\b\"").str(), "\b");
+  BOOST_CHECK_EQUAL(lazy_string_parse("\"\\f\"").str(), "\f");
+  BOOST_CHECK_EQUAL(lazy_string_parse("\"\\n\"").str(), "\n");
+  BOOST_CHECK_EQUAL(lazy_string_parse("\"\\r\"").str(), "\r");
+  BOOST_CHECK_EQUAL(lazy_string_parse("\"\\t\"").str(), "\t");
+  BOOST_CHECK_EQUAL(lazy_string_parse("\"\\\\\"").str(), "\\");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_lazy_string_should_decode_strings_in_array) {
+  const auto strings = decode<std::vector<raw_string>>("[\"a\",\"b\\\\c\",\"d\"]");
+  BOOST_REQUIRE_EQUAL(strings.size(), 3);
+  BOOST_CHECK_EQUAL(strings[0].str(), "a");
+  BOOST_CHECK_EQUAL(strings[1].str(), "b\\c");
+  BOOST_CHECK_EQUAL(strings[2].str(), "d");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_lazy_string_should_not_decode_invalid) {
+  lazy_string_parse_fail("");
+  lazy_string_parse_fail("\"");
+  lazy_string_parse_fail("\"abc");
+  lazy_string_parse_fail("\"a\\");
+  lazy_string_parse_fail("\"a\\n");
+  lazy_string_parse_fail("\"\\x\"");
+  lazy_string_parse_fail("\"\\u12\"");
+  lazy_string_parse_fail("\"\\u12G4\"");
+  lazy_string_parse_fail("abc");
+}
+
+/*
+ * Unescaping
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_lazy_string_should_view_simple_string_without_buffer) {
+  const auto json = std::string("\"abc\"");
+  const auto string = lazy_string_parse(json);
+  auto buffer = std::string("untouched");
+  const auto view = string.view(buffer);
+  BOOST_CHECK_EQUAL(view.data(), json.data() + 1);
+  BOOST_CHECK_EQUAL(view, "abc");
+  BOOST_CHECK_EQUAL(buffer, "untouched");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_lazy_string_should_view_escaped_string_in_buffer) {
+  auto buffer = std::string("overwritten");
+  const auto first = lazy_string_parse("\"a\\tb\"").view(buffer);
+  BOOST_CHECK_EQUAL(first, "a\tb");
+  BOOST_CHECK_EQUAL(first.data(), buffer.data());
+
+  const auto second = lazy_string_parse("\"\\u00e5\"").view(buffer);
+  BOOST_CHECK_EQUAL(second, "\xC3\xA5");
+  BOOST_CHECK_EQUAL(buffer, "\xC3\xA5");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_lazy_string_should_append_unescaped_string) {
+  auto out = std::string("x");
+  lazy_string_parse("\"y\\nz\"").unescape(out);
+  lazy_string_parse("\"w\"").unescape(out);
+  BOOST_CHECK_EQUAL(out, "xy\nzw");
+}
+
+/*
+ * Encoding
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_lazy_string_should_encode_escaped_string_as_is) {
+  const auto json = std::string("\"a\\nb\\u20AC\"");
+  BOOST_CHECK_EQUAL(encode(lazy_string_parse(json)), json);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_lazy_string_should_encode_with_escape_policy) {
+  const auto json = std::string("\"<a\\u00e5\xC3\xA5\\n&\"");
+  const auto string = lazy_string_parse(json);
+  BOOST_CHECK_EQUAL(encode_with_policy(string, escape_policy::standard), "\"<a\\u00e5\xC3\xA5\\n&\"");
+  BOOST_CHECK_EQUAL(encode_with_policy(string, escape_policy::trusted), "\"<a\\u00e5\xC3\xA5\\n&\"");
+  BOOST_CHECK_EQUAL(encode_with_policy(string, escape_policy::ascii), "\"<a\\u00E5\\u00E5\\n&\"");
+  BOOST_CHECK_EQUAL(
+      encode_with_policy(string, escape_policy::html_safe),
+      "\"\\u003Ca\xC3\xA5\xC3\xA5\\n\\u0026\"");
+
+  const auto unescaped_json = std::string("\"<\xC3\xA5\"");
+  const auto unescaped = lazy_string_parse(unescaped_json);
+  BOOST_CHECK_EQUAL(encode_with_policy(unescaped, escape_policy::ascii), "\"<\\u00E5\"");
+  BOOST_CHECK_EQUAL(encode_with_policy(unescaped, escape_policy::html_safe), "\"\\u003C\xC3\xA5\"");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_lazy_string_should_encode_empty_string) {
+  BOOST_CHECK_EQUAL(encode(raw_string()), "\"\"");
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // codec
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/array.hpp>
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/encoded_value.hpp>
+#include <spotify/json/mapped_file.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+/**
+ * A file with the given contents that is removed when it goes out of scope.
+ */
+class temporary_file {
+ public:
+  explicit temporary_file(const std::string &contents)
+      : _path("spotify_json_test_mapped_file.json") {
+    std::ofstream stream(_path, std::ios::binary | std::ios::trunc);
+    stream << contents;
+  }
+
+  ~temporary_file() {
+    std::remove(_path.c_str());
+  }
+
+  const std::string &path() const { return _path; }
+
+ private:
+  std::string _path;
+};
+
+std::string make_json_array(const std::size_t size) {
+  std::string json = "[0";
+  while (json.size() + 3 <= size) {
+    json += ",1";
+  }
+  json.append(size - json.size() - 1, ' ');
+  return json + "]";
+}
+
+void verify_mapped_file(const std::string &contents) {
+  const temporary_file file(contents);
+  const mapped_file mapped(file.path());
+  BOOST_REQUIRE_EQUAL(mapped.size(), contents.size());
+  BOOST_CHECK(std::string(mapped.data(), mapped.size()) == contents);
+  for (std::size_t i = 0; i < decode_padding; i++) {
+    BOOST_CHECK_EQUAL(mapped.data()[mapped.size() + i], '\0');
+  }
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_mapped_file_should_map_file) {
+  verify_mapped_file("[1,2,3]");
+}
+
+BOOST_AUTO_TEST_CASE(json_mapped_file_should_map_empty_file) {
+  verify_mapped_file("");
+}
+
+BOOST_AUTO_TEST_CASE(json_mapped_file_should_pad_files_that_end_near_page_boundaries) {
+  for (const std::size_t size : { 4095, 4096, 4097, 4096 - 64, 4096 - 63, 8192, 65536 }) {
+    verify_mapped_file(make_json_array(size));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_mapped_file_should_throw_for_missing_file) {
+  BOOST_CHECK_THROW(mapped_file("spotify_json_test_missing_file.json"), std::system_error);
+}
+
+BOOST_AUTO_TEST_CASE(json_mapped_file_should_move) {
+  const temporary_file file("[1]");
+  mapped_file original(file.path());
+  const auto data = original.data();
+  mapped_file moved(std::move(original));
+  BOOST_CHECK_EQUAL(moved.data(), data);
+  BOOST_CHECK_EQUAL(moved.size(), 3);
+
+  const temporary_file other_file("[1,2]");
+  mapped_file assigned(other_file.path());
+  assigned = std::move(moved);
+  BOOST_CHECK_EQUAL(assigned.data(), data);
+  BOOST_CHECK_EQUAL(assigned.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(json_mapped_file_should_be_validated_by_encoded_value_ref) {
+  const temporary_file file("{\"a\":[1,2]}");
+  const mapped_file mapped(file.path());
+  const encoded_value_ref value(mapped);
+  BOOST_CHECK_EQUAL(value.data(), mapped.data());
+
+  const temporary_file invalid_file("{\"a\":[1,2}");
+  const mapped_file invalid_mapped(invalid_file.path());
+  BOOST_CHECK_THROW(encoded_value_ref{invalid_mapped}, decode_exception);
+}
+
+/*
+ * json::decode_file
+ */
+
+BOOST_AUTO_TEST_CASE(json_decode_file_should_decode_file) {
+  for (const std::size_t size : { 3, 4096, 4096 - 64, 100000 }) {
+    const auto json = make_json_array(size);
+    const temporary_file file(json);
+    BOOST_CHECK(decode_file<std::vector<int>>(file.path()) == decode<std::vector<int>>(json));
+    BOOST_CHECK(decode_file(default_codec<std::vector<int>>(), file.path()) == decode<std::vector<int>>(json));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_file_should_decode_mapped_file) {
+  const temporary_file file(" [1, 2] ");
+  const mapped_file mapped(file.path());
+  BOOST_CHECK(decode<std::vector<int>>(mapped) == std::vector<int>({ 1, 2 }));
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_file_should_fail_on_invalid_file) {
+  const temporary_file file("[1,2");
+  BOOST_CHECK_THROW(decode_file<std::vector<int>>(file.path()), decode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_decode_file_should_fail_on_missing_file) {
+  BOOST_CHECK_THROW(decode_file<std::vector<int>>("spotify_json_test_missing_file.json"), std::system_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -15,6 +15,7 @@
  */
 
 #include <cstdint>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,7 @@
 #include <spotify/json/default_codec.hpp>
 #include <spotify/json/encode.hpp>
 #include <spotify/json/encode_exception.hpp>
+#include <spotify/json/padded_string.hpp>
 
 BOOST_AUTO_TEST_SUITE(spotify)
 BOOST_AUTO_TEST_SUITE(json)
@@ -57,6 +59,44 @@ void test_decode_fail(const Codec &codec, const std::string &json) {
   BOOST_CHECK_THROW(codec.decode(c), decode_exception);
 }
 
+/**
+ * Decode the integer both as the whole input (which for short integers is too
+ * little input to read eight bytes at a time), followed by other characters,
+ * and as padded input.
+ */
+template <typename T>
+void test_decode_integer(const std::string &json, const T expected) {
+  const auto codec = number<T>();
+  BOOST_CHECK_EQUAL(test_decode(codec, json), expected);
+  BOOST_CHECK_EQUAL(test_decode_dont_gobble(codec, json + ",        ", json.size()), expected);
+
+  const padded_string padded(json.data(), json.size());
+  decode_context c(padded.data(), padded.size(), decode_context::padded_input());
+  BOOST_CHECK_EQUAL(codec.decode(c), expected);
+  BOOST_CHECK_EQUAL(c.position, c.end);
+}
+
+template <typename T>
+void test_decode_integer_fail(const std::string &json) {
+  test_decode_fail(number<T>(), json);
+  test_decode_fail(number<T>(), json + ",        ");
+}
+
+template <typename T>
+void test_decode_integer_limits() {
+  const auto max = std::numeric_limits<T>::max();
+  const auto min = std::numeric_limits<T>::min();
+  test_decode_integer<T>(std::to_string(max), max);
+  test_decode_integer<T>(std::to_string(min), min);
+  test_decode_integer<T>(std::to_string(max - 1), max - 1);
+  if (uint64_t(max) + 1) {
+    test_decode_integer_fail<T>(std::to_string(uint64_t(max) + 1));
+  }
+  if (min) {
+    test_decode_integer_fail<T>("-" + std::to_string(uint64_t(max) + 2));
+  }
+}
+
 }  // namespace
 
 BOOST_AUTO_TEST_CASE(json_codec_number_should_construct) {
@@ -124,6 +164,34 @@ BOOST_AUTO_TEST_CASE(json_codec_number_should_not_decode_invalid_float_numbers)
   test_decode_fail(number<float>(), "- 1.1");
 }
 
+BOOST_AUTO_TEST_CASE(json_codec_number_should_decode_floating_point_numbers_correctly_rounded) {
+  BOOST_CHECK_EQUAL(test_decode(number<double>(), "-0.12345678901234567"), -0.12345678901234567);
+  BOOST_CHECK_EQUAL(test_decode(number<double>(), "1.7976931348623157e308"), 1.7976931348623157e308);
+  BOOST_CHECK_EQUAL(test_decode(number<double>(), "4.9e-324"), 4.9e-324);
+  BOOST_CHECK_EQUAL(test_decode(number<double>(), "2.2250738585072014E-308"), 2.2250738585072014e-308);
+  BOOST_CHECK_EQUAL(test_decode(number<double>(), "9007199254740993"), 9007199254740992.0);
+  BOOST_CHECK_EQUAL(test_decode(number<double>(), "0.1000000000000000055511151231257827"), 0.1);
+  BOOST_CHECK_EQUAL(test_decode(number<double>(), "1e400"), std::numeric_limits<double>::infinity());
+  BOOST_CHECK_EQUAL(test_decode(number<double>(), "1e-400"), 0.0);
+  BOOST_CHECK_EQUAL(test_decode(number<float>(), "3.4028235e+38"), 3.4028235e38f);
+  BOOST_CHECK_EQUAL(test_decode(number<float>(), "1.4e-45"), 1.4e-45f);
+  BOOST_CHECK_EQUAL(test_decode(number<float>(), "16777217"), 16777216.0f);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_decode_float_without_rounding_twice) {
+  // Halfway between 1 and the next float, so it rounds to even.
+  BOOST_CHECK_EQUAL(test_decode(number<float>(), "1.000000059604644775390625"), 1.0f);
+  // Just above halfway, but it would round to halfway as a double first.
+  BOOST_CHECK_EQUAL(test_decode(number<float>(), "1.000000059604644776"), 1.00000012f);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_decode_floating_point_numbers_followed_by_text) {
+  BOOST_CHECK_EQUAL(test_decode_dont_gobble(number<double>(), "1.5,", 3), 1.5);
+  BOOST_CHECK_EQUAL(test_decode_dont_gobble(number<double>(), "-2.5e-3]", 7), -2.5e-3);
+  BOOST_CHECK_EQUAL(test_decode_dont_gobble(number<double>(), "12345678901234567890123}", 23), 12345678901234567890123.0);
+  BOOST_CHECK_EQUAL(test_decode_dont_gobble(number<float>(), "0.25 ", 4), 0.25f);
+}
+
 /*
  * Encoding Floating Point Numbers
  */
@@ -133,6 +201,51 @@ BOOST_AUTO_TEST_CASE(json_codec_number_should_encode_exactly) {
   BOOST_CHECK_EQUAL(encode(0.5f), "0.5");
 }
 
+BOOST_AUTO_TEST_CASE(json_codec_number_should_encode_shortest_representation) {
+  BOOST_CHECK_EQUAL(encode(0.1), "0.1");
+  BOOST_CHECK_EQUAL(encode(-1.5), "-1.5");
+  BOOST_CHECK_EQUAL(encode(123.456), "123.456");
+  BOOST_CHECK_EQUAL(encode(1.0 / 3.0), "0.3333333333333333");
+  BOOST_CHECK_EQUAL(encode(5e-324), "5e-324");
+  BOOST_CHECK_EQUAL(encode(1.7976931348623157e308), "1.7976931348623157e+308");
+  BOOST_CHECK_EQUAL(encode(9007199254740993.0), "9007199254740992");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_encode_floats_in_single_precision) {
+  BOOST_CHECK_EQUAL(encode(0.1f), "0.1");
+  BOOST_CHECK_EQUAL(encode(1.0f / 3.0f), "0.33333334");
+  BOOST_CHECK_EQUAL(encode(3.4028235e38f), "3.4028235e+38");
+  BOOST_CHECK_EQUAL(encode(1.4e-45f), "1e-45");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_encode_with_ecmascript_layout) {
+  BOOST_CHECK_EQUAL(encode(0.0), "0");
+  BOOST_CHECK_EQUAL(encode(-0.0), "0");
+  BOOST_CHECK_EQUAL(encode(0.000001), "0.000001");
+  BOOST_CHECK_EQUAL(encode(0.0000001), "1e-7");
+  BOOST_CHECK_EQUAL(encode(-0.00000123), "-0.00000123");
+  BOOST_CHECK_EQUAL(encode(1e20), "100000000000000000000");
+  BOOST_CHECK_EQUAL(encode(1e21), "1e+21");
+  BOOST_CHECK_EQUAL(encode(1.5e100), "1.5e+100");
+  BOOST_CHECK_EQUAL(encode(1200.0f), "1200");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_round_trip_floating_point_numbers) {
+  const double doubles[] = {
+      0.1, -2.5e-8, 3.141592653589793, 6.02214076e23, 2.2250738585072014e-308,
+      4.9e-324, 1.7976931348623157e308, 123456789012345680.0, -0.0001 };
+  for (const auto value : doubles) {
+    BOOST_CHECK_EQUAL(test_decode(number<double>(), encode(value)), value);
+  }
+
+  const float floats[] = {
+      0.1f, -2.5e-8f, 3.14159274f, 6.02214076e23f, 1.17549435e-38f,
+      1.4e-45f, 3.4028235e38f, 16777216.0f, -0.0001f };
+  for (const auto value : floats) {
+    BOOST_CHECK_EQUAL(test_decode(number<float>(), encode(value)), value);
+  }
+}
+
 BOOST_AUTO_TEST_CASE(json_codec_number_should_not_encode_not_a_number) {
   BOOST_CHECK_THROW(encode(number<float>(), NAN), encode_exception);
   BOOST_CHECK_THROW(encode(number<double>(), NAN), encode_exception);
@@ -372,6 +485,60 @@ BOOST_AUTO_TEST_CASE(json_codec_number_should_not_gobble_characters_after_unsign
   BOOST_CHECK_EQUAL(test_decode_dont_gobble(number<uint8_t>(), "15.0#", 4), 15);
 }
 
+/*
+ * Decoding Integers Of All Lengths
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_decode_integers_of_all_lengths) {
+  const std::string digits = "1234567890987654321";
+  for (size_t length = 1; length <= digits.size(); length++) {
+    const auto json = digits.substr(0, length);
+    const auto value = std::stoull(json);
+    test_decode_integer<uint64_t>(json, value);
+    test_decode_integer<int64_t>(json, int64_t(value));
+    test_decode_integer<int64_t>("-" + json, -int64_t(value));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_decode_limits_of_all_integer_widths) {
+  test_decode_integer_limits<int8_t>();
+  test_decode_integer_limits<int16_t>();
+  test_decode_integer_limits<int32_t>();
+  test_decode_integer_limits<int64_t>();
+  test_decode_integer_limits<uint8_t>();
+  test_decode_integer_limits<uint16_t>();
+  test_decode_integer_limits<uint32_t>();
+  test_decode_integer_limits<uint64_t>();
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_decode_long_integers_with_leading_zeros) {
+  test_decode_integer<uint64_t>("0000000000000000000000001", 1);
+  test_decode_integer<int32_t>("-00000000000000000000000000000002147483648", -2147483648LL);
+  test_decode_integer_fail<uint64_t>("99999999999999999999");
+  test_decode_integer_fail<uint64_t>("18446744073709551616");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_decode_long_integers_with_decimals_and_exponents) {
+  test_decode_integer<int64_t>("12345678901234.5e2", 1234567890123450);
+  test_decode_integer<int64_t>("-1234567890123456789e-10", -123456789);
+  test_decode_integer<uint64_t>("1234567890123456.789", 1234567890123456);
+  test_decode_integer<uint64_t>("123456789012345678901234e-5", 1234567890123456789);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_number_should_not_decode_digits_in_padding) {
+  const std::string json = "123456789012345678901234567890,";
+  for (size_t size = 1; size <= 19; size++) {
+    decode_context c(json.data(), size, decode_context::padded_input());
+    BOOST_CHECK_EQUAL(number<uint64_t>().decode(c), std::stoull(json.substr(0, size)));
+    BOOST_CHECK_EQUAL(c.position, c.end);
+  }
+
+  const std::string short_json = "1234,5678";
+  decode_context c(short_json.data(), 2, decode_context::padded_input());
+  BOOST_CHECK_EQUAL(number<int>().decode(c), 12);
+  BOOST_CHECK_EQUAL(c.position, c.end);
+}
+
 /*
  * Encoding Unsigned Integers
  */
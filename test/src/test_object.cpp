@@ -14,6 +14,7 @@
  * the License.
  */
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -24,6 +25,7 @@
 #include <spotify/json/codec/string.hpp>
 #include <spotify/json/decode.hpp>
 #include <spotify/json/default_codec.hpp>
+#include <spotify/json/detail/parallel_for.hpp>
 #include <spotify/json/encode.hpp>
 
 #include <spotify/json/test/only_true.hpp>
@@ -144,6 +146,129 @@ BOOST_AUTO_TEST_CASE(json_codec_object_should_overwrite_duplicate_fields) {
   BOOST_CHECK_EQUAL(example.value, "hey2");
 }
 
+BOOST_AUTO_TEST_CASE(json_codec_object_should_decode_fields_with_escaped_keys) {
+  const auto simple = test_decode(default_codec<simple_t>(), R"({"va\u006cue":"hey","\u0073ize":1})");
+  BOOST_CHECK_EQUAL(simple.value, "hey");
+  BOOST_CHECK_EQUAL(simple.size, 1);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_decode_many_fields) {
+  const size_t num_fields = 100;
+  codec::object_t<std::vector<std::string>> codec;
+  std::string json = "{";
+  for (size_t i = 0; i < num_fields; i++) {
+    const auto name = "field_" + std::to_string(i);
+    codec.required(name,
+        [=](const std::vector<std::string> &v) { return v[i]; },
+        [=](std::vector<std::string> &v, std::string value) { v.resize(num_fields); v[i] = value; });
+    json += (i ? ",\"" : "\"") + name + "\":\"" + std::to_string(i) + "\"";
+  }
+
+  const auto decoded = test_decode(codec, json + ",\"unknown\":[1]}");
+  BOOST_REQUIRE_EQUAL(decoded.size(), num_fields);
+  for (size_t i = 0; i < num_fields; i++) {
+    BOOST_CHECK_EQUAL(decoded[i], std::to_string(i));
+  }
+
+  test_decode_fail(codec, json.substr(0, json.rfind(',')) + "}");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_not_count_predictions_by_default) {
+  const auto codec = example_codec();
+  test_decode(codec, R"({"value":"a"})");
+  BOOST_CHECK_EQUAL(codec.predicted_field_hits(), 0);
+  BOOST_CHECK_EQUAL(codec.predicted_field_misses(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_predict_field_order) {
+  auto codec = default_codec<simple_t>();
+  codec.predict_field_order();
+
+  const auto first = test_decode(codec, R"({"value":"a","size":1})");
+  BOOST_CHECK_EQUAL(codec.predicted_field_hits(), 0);
+  BOOST_CHECK_EQUAL(codec.predicted_field_misses(), 2);
+
+  const auto second = test_decode(codec, R"({"value":"b","size":2})");
+  BOOST_CHECK_EQUAL(codec.predicted_field_hits(), 2);
+  BOOST_CHECK_EQUAL(codec.predicted_field_misses(), 2);
+  BOOST_CHECK_EQUAL(first.value, "a");
+  BOOST_CHECK_EQUAL(first.size, 1);
+  BOOST_CHECK_EQUAL(second.value, "b");
+  BOOST_CHECK_EQUAL(second.size, 2);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_decode_when_prediction_is_wrong) {
+  auto codec = default_codec<simple_t>();
+  codec.predict_field_order();
+
+  for (const auto json : {
+      R"({"value":"a","size":1})",
+      R"({"size":1,"value":"a"})",
+      R"({"x":0,"size":1,"y":0,"value":"a","z":0})",
+      R"({"size":1,"size":1,"value":"a","value":"a"})",
+      R"({"value":"a","size":1})" }) {
+    const auto simple = test_decode(codec, json);
+    BOOST_CHECK_EQUAL(simple.value, "a");
+    BOOST_CHECK_EQUAL(simple.size, 1);
+  }
+
+  BOOST_CHECK_EQUAL(codec.predicted_field_hits() + codec.predicted_field_misses(), 15);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_skip_unknown_fields_when_predicting) {
+  auto codec = default_codec<simple_t>();
+  codec.predict_field_order();
+
+  test_decode(codec, R"({"size":1,"x":0,"value":"a"})");
+  test_decode(codec, R"({"size":1,"x":0,"value":"a"})");
+  BOOST_CHECK_EQUAL(codec.predicted_field_hits(), 2);
+  BOOST_CHECK_EQUAL(codec.predicted_field_misses(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_require_required_fields_when_predicting) {
+  auto codec = example_codec();
+  codec.predict_field_order();
+  test_decode(codec, R"({"value":"a"})");
+  test_decode_fail(codec, R"({"simple":{}})");
+  test_decode_fail(codec, R"({})");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_relearn_field_order_when_adding_fields) {
+  codec::object_t<simple_t> codec;
+  codec.optional("size", &simple_t::size);
+  codec.predict_field_order();
+  test_decode(codec, R"({"size":1})");
+  test_decode(codec, R"({"size":1})");
+  BOOST_CHECK_EQUAL(codec.predicted_field_hits(), 1);
+
+  codec.optional("value", &simple_t::value);
+  BOOST_CHECK_EQUAL(codec.predicted_field_hits(), 0);
+  BOOST_CHECK_EQUAL(test_decode(codec, R"({"size":1,"value":"a"})").value, "a");
+  BOOST_CHECK_EQUAL(test_decode(codec, R"({"size":1,"value":"a"})").value, "a");
+  BOOST_CHECK_EQUAL(codec.predicted_field_hits(), 2);
+  BOOST_CHECK_EQUAL(codec.predicted_field_misses(), 2);
+
+  codec.predict_field_order(false);
+  test_decode(codec, R"({"size":1,"value":"a"})");
+  BOOST_CHECK_EQUAL(codec.predicted_field_hits(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_object_should_predict_field_order_from_many_threads) {
+  auto codec = default_codec<simple_t>();
+  codec.predict_field_order();
+
+  // Boost.Test assertions are not thread safe, so only count the results.
+  const std::string jsons[] = { R"({"value":"a","size":1})", R"({"size":1,"value":"a"})" };
+  std::atomic<size_t> num_correct(0);
+  detail::parallel_for(1000, 4, [&](const size_t i) {
+    const auto simple = decode(codec, jsons[i % 2]);
+    num_correct += (simple.value == "a" && simple.size == 1);
+  });
+
+  BOOST_CHECK_EQUAL(num_correct, 1000);
+  BOOST_CHECK_EQUAL(codec.predicted_field_hits() + codec.predicted_field_misses(), 2000);
+}
+
 BOOST_AUTO_TEST_CASE(json_codec_object_should_use_custom_creator_when_decoding) {
   object_t<example_t> codec([]{
     example_t value;
@@ -252,6 +377,18 @@ BOOST_AUTO_TEST_CASE(json_codec_object_should_encode_dummy_fields) {
   BOOST_CHECK_EQUAL(encode(codec, example_t()), R"({"dummy":""})");
 }
 
+BOOST_AUTO_TEST_CASE(json_codec_object_should_encode_keys_with_escape_policy) {
+  object_t<example_t> codec;
+  codec.required("<\xC3\xA5>", string());
+  codec.escape_keys(escape_policy::ascii);
+  codec.required("&", string());
+
+  BOOST_CHECK_EQUAL(encode(codec, example_t()), R"({"<\u00E5>":"","&":""})");
+
+  codec.escape_keys(escape_policy::html_safe);
+  BOOST_CHECK_EQUAL(encode(codec, example_t()), "{\"\\u003C\xC3\xA5\\u003E\":\"\",\"\\u0026\":\"\"}");
+}
+
 BOOST_AUTO_TEST_CASE(json_codec_object_should_encode_getter_field) {
   const auto codec = getset_codec();
   getset_t getset;
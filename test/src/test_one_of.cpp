@@ -14,6 +14,7 @@
  * the License.
  */
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -51,6 +52,34 @@ struct example_t {
   std::string value;
 };
 
+/**
+ * Counts how many times it has been asked to decode, and how many of those
+ * times it could record its error instead of throwing, and then fails.
+ */
+template <bool has_first_tokens>
+struct counting_codec_t {
+  using object_type = std::string;
+
+  object_type decode(decode_context &context) const {
+    ++*calls;
+    *recorded += (context.error != nullptr);
+    detail::fail(context, "counting_codec_t");
+    return object_type();
+  }
+
+  void encode(encode_context &context, const object_type &value) const {}
+
+  std::shared_ptr<int> calls = std::make_shared<int>(0);
+  std::shared_ptr<int> recorded = std::make_shared<int>(0);
+};
+
+template <>
+struct counting_codec_t<true> : counting_codec_t<false> {
+  unsigned first_tokens() const {
+    return detail::token_number;
+  }
+};
+
 }  // namespace
 
 /*
@@ -103,6 +132,18 @@ BOOST_AUTO_TEST_CASE(json_codec_one_of_should_fail_decode_if_all_fail) {
   test_decode_fail(codec, "{}");
 }
 
+BOOST_AUTO_TEST_CASE(json_codec_one_of_should_backtrack_without_throwing) {
+  const counting_codec_t<false> first;
+  const auto codec = one_of(first, string());
+  const std::string json = "\"a\"";
+  decode_context c(json.data(), json.size());
+  BOOST_CHECK_EQUAL(codec.decode(c), "a");
+  BOOST_CHECK_EQUAL(c.position, c.end);
+  BOOST_CHECK(c.error == nullptr);
+  BOOST_CHECK_EQUAL(*first.calls, 1);
+  BOOST_CHECK_EQUAL(*first.recorded, 1);
+}
+
 BOOST_AUTO_TEST_CASE(json_codec_one_of_null) {
   const auto codec = one_of(string(), null<std::string>());
   BOOST_CHECK_EQUAL(test_decode(codec, "\"abc\""), "abc");
@@ -121,6 +162,58 @@ BOOST_AUTO_TEST_CASE(json_codec_one_of_ignore) {
   test_decode_fail(codec, "{");
 }
 
+BOOST_AUTO_TEST_CASE(json_codec_one_of_should_skip_codecs_that_cannot_decode_the_token) {
+  const auto counting = counting_codec_t<true>();
+  const auto codec = one_of(counting, string());
+  BOOST_CHECK_EQUAL(test_decode(codec, "\"abc\""), "abc");
+  BOOST_CHECK_EQUAL(*counting.calls, 0);
+  test_decode_fail(codec, "1");
+  BOOST_CHECK_EQUAL(*counting.calls, 1);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_one_of_should_try_codecs_without_first_tokens) {
+  const auto counting = counting_codec_t<false>();
+  const auto codec = one_of(counting, string());
+  BOOST_CHECK_EQUAL(test_decode(codec, "\"abc\""), "abc");
+  BOOST_CHECK_EQUAL(*counting.calls, 1);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_one_of_should_try_all_codecs_for_unknown_tokens) {
+  const auto counting = counting_codec_t<true>();
+  const auto codec = one_of(counting, string());
+  test_decode_fail(codec, "x");
+  test_decode_fail(codec, "");
+  BOOST_CHECK_EQUAL(*counting.calls, 2);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_one_of_should_fail_with_error_of_last_codec) {
+  const auto codec = one_of(null<std::string>(), string());
+  const std::string json = "1";
+
+  decode_context c(json.c_str(), json.c_str() + json.size());
+  decode_context expected_c(json.c_str(), json.c_str() + json.size());
+  try {
+    string().decode(expected_c);
+    BOOST_FAIL("string codec should fail");
+  } catch (const decode_exception &expected) {
+    try {
+      codec.decode(c);
+      BOOST_FAIL("one_of codec should fail");
+    } catch (const decode_exception &exception) {
+      BOOST_CHECK_EQUAL(std::string(exception.what()), expected.what());
+      BOOST_CHECK_EQUAL(exception.offset(), expected.offset());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_one_of_should_combine_first_tokens) {
+  const auto codec = one_of(string(), null<std::string>());
+  BOOST_CHECK_EQUAL(codec.first_tokens(), detail::token_string | detail::token_null);
+  BOOST_CHECK_EQUAL(
+      one_of(string(), ignore<std::string>()).first_tokens(),
+      unsigned(detail::token_any));
+}
+
 /*
  * Encoding
  */
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/padded_string.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+
+namespace {
+
+void verify_padding(const padded_string &string) {
+  for (std::size_t i = 0; i < decode_padding; i++) {
+    BOOST_CHECK_EQUAL(string.data()[string.size() + i], '\0');
+  }
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_padded_string_should_construct_empty) {
+  const padded_string string;
+  BOOST_CHECK(string.data() != nullptr);
+  BOOST_CHECK_EQUAL(string.size(), 0);
+  verify_padding(string);
+}
+
+BOOST_AUTO_TEST_CASE(json_padded_string_should_construct_with_cstring) {
+  const padded_string string("[1,2]");
+  BOOST_CHECK_EQUAL(std::string(string.data(), string.size()), "[1,2]");
+  verify_padding(string);
+}
+
+BOOST_AUTO_TEST_CASE(json_padded_string_should_construct_with_null_cstring) {
+  const padded_string string(static_cast<const char *>(nullptr));
+  BOOST_CHECK_EQUAL(string.size(), 0);
+  verify_padding(string);
+}
+
+BOOST_AUTO_TEST_CASE(json_padded_string_should_construct_with_data_and_size) {
+  const padded_string string("[1,2]", 3);
+  BOOST_CHECK_EQUAL(std::string(string.data(), string.size()), "[1,");
+  verify_padding(string);
+}
+
+BOOST_AUTO_TEST_CASE(json_padded_string_should_construct_with_std_string) {
+  const padded_string string(std::string("{}"));
+  BOOST_CHECK_EQUAL(std::string(string.data(), string.size()), "{}");
+  verify_padding(string);
+}
+
+BOOST_AUTO_TEST_CASE(json_padded_string_should_copy) {
+  const padded_string original("[true]");
+  const padded_string copy(original);
+  padded_string assigned;
+  assigned = original;
+  BOOST_CHECK(copy.data() != original.data());
+  BOOST_CHECK_EQUAL(std::string(copy.data(), copy.size()), "[true]");
+  BOOST_CHECK_EQUAL(std::string(assigned.data(), assigned.size()), "[true]");
+  verify_padding(copy);
+  verify_padding(assigned);
+}
+
+BOOST_AUTO_TEST_CASE(json_padded_string_should_move) {
+  padded_string original("[true]");
+  const auto data = original.data();
+  const padded_string moved(std::move(original));
+  BOOST_CHECK(moved.data() == data);
+  BOOST_CHECK_EQUAL(moved.size(), 6);
+  BOOST_CHECK_EQUAL(original.size(), 0);
+  verify_padding(original);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/detail/parallel_for.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(detail)
+
+BOOST_AUTO_TEST_CASE(json_parallel_for_should_run_every_task_once) {
+  for (const std::size_t num_threads : { 1, 2, 4, 16 }) {
+    std::vector<std::atomic<int>> runs(1000);
+    for (auto &run : runs) {
+      run = 0;
+    }
+
+    parallel_for(runs.size(), num_threads, [&](const std::size_t i) { runs[i]++; });
+    for (const auto &run : runs) {
+      BOOST_CHECK_EQUAL(run.load(), 1);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_parallel_for_should_run_no_tasks) {
+  parallel_for(0, 4, [](const std::size_t) { BOOST_FAIL("no task should run"); });
+}
+
+BOOST_AUTO_TEST_CASE(json_parallel_for_should_rethrow_exceptions) {
+  BOOST_CHECK_THROW(
+      parallel_for(100, 4, [](const std::size_t i) {
+        if (i == 50) {
+          throw std::runtime_error("task failed");
+        }
+      }),
+      std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(json_default_num_threads_should_be_positive) {
+  BOOST_CHECK_GT(default_num_threads(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // detail
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
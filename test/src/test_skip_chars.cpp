@@ -15,11 +15,13 @@
  */
 
 #include <cstdlib>
+#include <type_traits>
 
 #include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <spotify/json/detail/skip_chars.hpp>
+#include <spotify/json/instruction_set.hpp>
 
 BOOST_AUTO_TEST_SUITE(spotify)
 BOOST_AUTO_TEST_SUITE(json)
@@ -36,14 +38,32 @@ std::string generate(const std::string &tpl, const std::size_t count) {
   return ws;
 }
 
+/**
+ * Use the given instruction set (or the best supported one below it) for as
+ * long as the object lives.
+ */
+struct scoped_instruction_set {
+  explicit scoped_instruction_set(const instruction_set set)
+      : _previous(active_instruction_set()) {
+    use_instruction_set(set);
+  }
+
+  ~scoped_instruction_set() {
+    use_instruction_set(_previous);
+  }
+
+ private:
+  const instruction_set _previous;
+};
+
 template <void (*function)(decode_context &)>
 void verify_skip_any(
-    const bool use_sse,
+    const instruction_set set,
     const std::string &json,
     const std::size_t prefix = 0,
     const std::size_t suffix = 0) {
+  const scoped_instruction_set scope(set);
   auto context = decode_context(json.data() + prefix, json.data() + json.size());
-  *const_cast<bool *>(&context.has_sse42) &= use_sse;
   const auto original_context = context;
   function(context);
   BOOST_CHECK_EQUAL(
@@ -55,15 +75,44 @@ void verify_skip_any(
 }
 
 template <void (*function)(decode_context &)>
-void verify_skip_empty_nullptr(const bool use_sse) {
+void verify_skip_empty_nullptr(const instruction_set set) {
+  const scoped_instruction_set scope(set);
   auto context = decode_context(nullptr, nullptr);
-  *const_cast<bool *>(&context.has_sse42) &= use_sse;
   function(context);
   BOOST_CHECK(context.position == nullptr);
   BOOST_CHECK(context.end == nullptr);
 }
 
-using true_false = boost::mpl::list<boost::true_type, boost::false_type>;
+/**
+ * Like verify_skip_any, but for padded input, with padding that would be
+ * skipped too if the kernel did not stop at the end.
+ */
+template <void (*function)(decode_context &)>
+void verify_skip_any_padded(
+    const instruction_set set,
+    const std::string &json,
+    const char padding,
+    const std::size_t prefix = 0,
+    const std::size_t suffix = 0) {
+  const scoped_instruction_set scope(set);
+  const auto padded = json + std::string(decode_padding, padding);
+  const auto begin = padded.data();
+  const auto end = padded.data() + json.size();
+  auto context = decode_context(begin + prefix, end, decode_context::padded_input());
+  function(context);
+  BOOST_CHECK_EQUAL(
+      reinterpret_cast<intptr_t>(context.position),
+      reinterpret_cast<intptr_t>(end - suffix));
+}
+
+template <instruction_set set>
+using instruction_set_constant = std::integral_constant<instruction_set, set>;
+
+using instruction_sets = boost::mpl::list<
+    instruction_set_constant<instruction_set::scalar>,
+    instruction_set_constant<instruction_set::sse42>,
+    instruction_set_constant<instruction_set::avx2>,
+    instruction_set_constant<instruction_set::avx512bw>>;
 
 }  // namespace
 
@@ -71,84 +120,106 @@ using true_false = boost::mpl::list<boost::true_type, boost::false_type>;
  * skip_any_simple_characters
  */
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_simple_characters, use_sse, true_false) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_simple_characters, set_type, instruction_sets) {
   for (auto n = 0; n < 1024; n++) {
     const auto ws = generate("abcdefghIJKLMNOP:-,;'^¨´`xyz", n);
     const auto with_prefix = "\\" + ws;
     const auto with_suffix = ws + "\"abcde";
-    verify_skip_any<skip_any_simple_characters>(use_sse::value, ws);
-    verify_skip_any<skip_any_simple_characters>(use_sse::value, with_prefix, 1);
-    verify_skip_any<skip_any_simple_characters>(use_sse::value, with_suffix, 0, 6);
+    verify_skip_any<skip_any_simple_characters>(set_type::value, ws);
+    verify_skip_any<skip_any_simple_characters>(set_type::value, with_prefix, 1);
+    verify_skip_any<skip_any_simple_characters>(set_type::value, with_suffix, 0, 6);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_simple_characters_with_padding, set_type, instruction_sets) {
+  for (auto n = 0; n < 256; n++) {
+    const auto ws = generate("abcdefghIJKLMNOP:-,;'^¨´`xyz", n);
+    const auto with_prefix = "\\" + ws;
+    const auto with_suffix = ws + "\"abcde";
+    verify_skip_any_padded<skip_any_simple_characters>(set_type::value, ws, 'a');
+    verify_skip_any_padded<skip_any_simple_characters>(set_type::value, with_prefix, 'a', 1);
+    verify_skip_any_padded<skip_any_simple_characters>(set_type::value, with_suffix, 'a', 0, 6);
   }
 }
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_simple_characters_with_empty_string,
-                              use_sse,
-                              true_false) {
-  verify_skip_empty_nullptr<skip_any_simple_characters>(use_sse::value);
+                              set_type,
+                              instruction_sets) {
+  verify_skip_empty_nullptr<skip_any_simple_characters>(set_type::value);
 }
 
 /*
  * skip_any_whitespace
  */
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_space, use_sse, true_false) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_space, set_type, instruction_sets) {
   for (auto n = 0; n < 1024; n++) {
     const auto ws = generate(" ", n);
     const auto with_prefix = "}" + ws;
     const auto with_suffix = ws + "{ ";
-    verify_skip_any<skip_any_whitespace>(use_sse::value, ws);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_prefix, 1);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_suffix, 0, 2);
+    verify_skip_any<skip_any_whitespace>(set_type::value, ws);
+    verify_skip_any<skip_any_whitespace>(set_type::value, with_prefix, 1);
+    verify_skip_any<skip_any_whitespace>(set_type::value, with_suffix, 0, 2);
   }
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_tabs, use_sse, true_false) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_tabs, set_type, instruction_sets) {
   for (auto n = 0; n < 1024; n++) {
     const auto ws = generate("\t", n);
     const auto with_prefix = "}" + ws;
     const auto with_suffix = ws + "{ ";
-    verify_skip_any<skip_any_whitespace>(use_sse::value, ws);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_prefix, 1);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_suffix, 0, 2);
+    verify_skip_any<skip_any_whitespace>(set_type::value, ws);
+    verify_skip_any<skip_any_whitespace>(set_type::value, with_prefix, 1);
+    verify_skip_any<skip_any_whitespace>(set_type::value, with_suffix, 0, 2);
   }
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_carriage_return, use_sse, true_false) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_carriage_return, set_type, instruction_sets) {
   for (auto n = 0; n < 1024; n++) {
     const auto ws = generate("\r", n);
     const auto with_prefix = "}" + ws;
     const auto with_suffix = ws + "{ ";
-    verify_skip_any<skip_any_whitespace>(use_sse::value, ws);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_prefix, 1);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_suffix, 0, 2);
+    verify_skip_any<skip_any_whitespace>(set_type::value, ws);
+    verify_skip_any<skip_any_whitespace>(set_type::value, with_prefix, 1);
+    verify_skip_any<skip_any_whitespace>(set_type::value, with_suffix, 0, 2);
   }
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_line_feed, use_sse, true_false) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_line_feed, set_type, instruction_sets) {
   for (auto n = 0; n < 1024; n++) {
     const auto ws = generate("\n", n);
     const auto with_prefix = "}" + ws;
     const auto with_suffix = ws + "{ ";
-    verify_skip_any<skip_any_whitespace>(use_sse::value, ws);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_prefix, 1);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_suffix, 0, 2);
+    verify_skip_any<skip_any_whitespace>(set_type::value, ws);
+    verify_skip_any<skip_any_whitespace>(set_type::value, with_prefix, 1);
+    verify_skip_any<skip_any_whitespace>(set_type::value, with_suffix, 0, 2);
   }
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_whitespace, use_sse, true_false) {
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_whitespace, set_type, instruction_sets) {
   for (auto n = 0; n < 1024; n++) {
     const auto ws = generate("\n\t\r\n", n);
     const auto with_prefix = "}" + ws;
     const auto with_suffix = ws + "{ ";
-    verify_skip_any<skip_any_whitespace>(use_sse::value, ws);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_prefix, 1);
-    verify_skip_any<skip_any_whitespace>(use_sse::value, with_suffix, 0, 2);
+    verify_skip_any<skip_any_whitespace>(set_type::value, ws);
+    verify_skip_any<skip_any_whitespace>(set_type::value, with_prefix, 1);
+    verify_skip_any<skip_any_whitespace>(set_type::value, with_suffix, 0, 2);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_whitespace_with_padding, set_type, instruction_sets) {
+  for (auto n = 0; n < 256; n++) {
+    const auto ws = generate("\n\t\r\n ", n);
+    const auto with_prefix = "}" + ws;
+    const auto with_suffix = ws + "{ ";
+    verify_skip_any_padded<skip_any_whitespace>(set_type::value, ws, ' ');
+    verify_skip_any_padded<skip_any_whitespace>(set_type::value, with_prefix, ' ', 1);
+    verify_skip_any_padded<skip_any_whitespace>(set_type::value, with_suffix, ' ', 0, 2);
   }
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_whitespace_with_empty_string, use_sse, true_false) {
-  verify_skip_empty_nullptr<skip_any_whitespace>(use_sse::value);
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_any_whitespace_with_empty_string, set_type, instruction_sets) {
+  verify_skip_empty_nullptr<skip_any_whitespace>(set_type::value);
 }
 
 BOOST_AUTO_TEST_SUITE_END()  // detail
@@ -14,9 +14,15 @@
  * the License.
  */
 
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <spotify/json/detail/skip_value.hpp>
+#include <spotify/json/instruction_set.hpp>
 
 BOOST_AUTO_TEST_SUITE(spotify)
 BOOST_AUTO_TEST_SUITE(json)
@@ -37,6 +43,106 @@ void verify_skip_value(const std::string &json, const size_t extra = 0) {
   BOOST_CHECK_EQUAL(context.end, original_context.end);
 }
 
+/**
+ * Use the given instruction set (or the best supported one below it) for as
+ * long as the object lives.
+ */
+struct scoped_instruction_set {
+  explicit scoped_instruction_set(const instruction_set set)
+      : _previous(active_instruction_set()) {
+    use_instruction_set(set);
+  }
+
+  ~scoped_instruction_set() {
+    use_instruction_set(_previous);
+  }
+
+ private:
+  const instruction_set _previous;
+};
+
+template <instruction_set set>
+using instruction_set_constant = std::integral_constant<instruction_set, set>;
+
+using instruction_sets = boost::mpl::list<
+    instruction_set_constant<instruction_set::scalar>,
+    instruction_set_constant<instruction_set::sse42>,
+    instruction_set_constant<instruction_set::avx2>,
+    instruction_set_constant<instruction_set::avx512bw>>;
+
+/**
+ * The offset after skipping the value, or the error and its offset.
+ */
+template <void (*function)(decode_context &)>
+std::string skip_result(const std::string &json) {
+  auto context = decode_context(json.data(), json.data() + json.size());
+  try {
+    function(context);
+    return std::to_string(context.offset());
+  } catch (const decode_exception &exception) {
+    return std::string(exception.what()) + " at " + std::to_string(exception.offset());
+  }
+}
+
+void verify_skip_same_as_scalar(const instruction_set set, const std::string &json) {
+  const scoped_instruction_set scope(set);
+  BOOST_CHECK_EQUAL(skip_result<skip_value>(json), skip_result<skip_value_scalar>(json));
+}
+
+/**
+ * Skip the value as padded input, followed by padding that is not valid JSON,
+ * and compare with the scalar implementation on unpadded input.
+ */
+void verify_skip_padded_same_as_scalar(const instruction_set set, const std::string &json) {
+  const scoped_instruction_set scope(set);
+  const auto padded = json + std::string(decode_padding, '"') + std::string(decode_padding, '}');
+  auto context = decode_context(padded.data(), json.size(), decode_context::padded_input());
+  std::string result;
+  try {
+    skip_value(context);
+    result = std::to_string(context.offset());
+  } catch (const decode_exception &exception) {
+    result = std::string(exception.what()) + " at " + std::to_string(exception.offset());
+  }
+  BOOST_CHECK_EQUAL(result, skip_result<skip_value_scalar>(json));
+}
+
+const std::vector<std::string> &structural_documents() {
+  static const std::vector<std::string> documents = {
+    R"({})",
+    R"([])",
+    R"({"a":[1,2.5,-3e+4,true,false,null],"b":{"c":"d"}})",
+    R"( { "a" : [ 1 , "x" ] , "b" : { } } )",
+    R"(["\\","\"","a\\\"b","\u00e9\n","{[,:]}"])",
+    R"({"\"":1})",
+    R"([01])",
+    R"([1x])",
+    R"([truex])",
+    R"([1"a"])",
+    R"(["a""b"])",
+    R"([1,])",
+    R"([,1])",
+    R"({"a"})",
+    R"({"a" 1})",
+    R"({"a":1,})",
+    R"({1:2})",
+    R"([}])",
+    R"({])",
+    R"([1 2])",
+    R"(["\x"])",
+    R"(["\u12G4"])",
+    R"(["abc)",
+    R"(["abc\"])",
+    R"([1,[2,[3)",
+    R"([\"a"])",
+    "[\"\x01\"]",
+    "[tru]",
+    "[nul",
+    "[-]",
+  };
+  return documents;
+}
+
 }  // namespace
 
 BOOST_AUTO_TEST_CASE(json_skip_value_string) {
@@ -142,6 +248,112 @@ BOOST_AUTO_TEST_CASE(json_skip_value_should_not_skip_invalid_array) {
   verify_skip_fail("[12");
 }
 
+/*
+ * Structural index
+ */
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_value_should_match_scalar_at_any_block_offset,
+                              set_type,
+                              instruction_sets) {
+  for (const auto &document : structural_documents()) {
+    for (auto n = 0; n < 130; n++) {
+      const auto padding = std::string(n, ' ');
+      verify_skip_same_as_scalar(set_type::value, document);
+      verify_skip_same_as_scalar(set_type::value, "[" + padding + document + "]");
+      verify_skip_same_as_scalar(set_type::value, "{\"" + padding + "\":" + document + "}");
+      verify_skip_same_as_scalar(set_type::value, "[\"" + std::string(n, '\\') + "\"," + document + "]");
+      verify_skip_same_as_scalar(set_type::value, document + padding + "1");
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_value_should_match_scalar_with_padding,
+                              set_type,
+                              instruction_sets) {
+  for (const auto &document : structural_documents()) {
+    for (auto n = 0; n < 130; n++) {
+      const auto padding = std::string(n, ' ');
+      verify_skip_padded_same_as_scalar(set_type::value, "[" + padding + document + "]");
+      verify_skip_padded_same_as_scalar(set_type::value, "[" + padding + document);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_value_should_match_scalar_when_mutated,
+                              set_type,
+                              instruction_sets) {
+  const std::string document = R"({"id":12345,"name":"a \"quoted\" \\ name","tags":["x","y",)"
+      R"("z"],"nested":{"deep":[[[{"k":-1.5e-3}]],[]],"flag":true,"none":null},)"
+      R"("escapes":"\u0041\n\t\/","long":"abcdefghijklmnopqrstuvwxyz0123456789"})";
+  const std::string replacements = "\"\\{}[],: \t0-.eEtrunlfax\x80";
+
+  verify_skip_same_as_scalar(set_type::value, document);
+
+  uint32_t random = 1;
+  for (auto i = 0; i < 20000; i++) {
+    auto mutated = document;
+    for (auto j = 0; j < 1 + (i % 3); j++) {
+      random = random * 1103515245 + 12345;
+      const auto position = (random >> 8) % mutated.size();
+      random = random * 1103515245 + 12345;
+      mutated[position] = replacements[(random >> 8) % replacements.size()];
+    }
+    verify_skip_same_as_scalar(set_type::value, mutated);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_value_should_skip_deeply_nested_values,
+                              set_type,
+                              instruction_sets) {
+  const auto depth = 1000;
+  const auto nested = std::string(depth, '[') + "1" + std::string(depth, ']');
+  verify_skip_same_as_scalar(set_type::value, nested);
+  verify_skip_same_as_scalar(set_type::value, nested.substr(1));
+  verify_skip_same_as_scalar(set_type::value, nested.substr(0, nested.size() - 1));
+
+  const scoped_instruction_set scope(set_type::value);
+  verify_skip_value(nested);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_skip_value_should_skip_wide_values,
+                              set_type,
+                              instruction_sets) {
+  std::string wide = "{";
+  for (auto i = 0; i < 1000; i++) {
+    wide += (i ? ",\"field_" : "\"field_") + std::to_string(i) + "\":";
+    switch (i % 4) {
+      case 0: wide += std::to_string(i * 7919); break;
+      case 1: wide += "\"value \\\" " + std::to_string(i) + "\""; break;
+      case 2: wide += "[true,false,null]"; break;
+      case 3: wide += "{\"x\":-0.5e10}"; break;
+    }
+  }
+  wide += "}";
+
+  const scoped_instruction_set scope(set_type::value);
+  verify_skip_value(wide);
+  verify_skip_value(wide + ",", 1);
+  verify_skip_fail(wide.substr(0, wide.size() - 1));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(json_try_skip_value_should_report_the_same_errors,
+                              set_type,
+                              instruction_sets) {
+  const scoped_instruction_set scope(set_type::value);
+  for (const auto &document : structural_documents()) {
+    auto context = decode_context(document.data(), document.data() + document.size());
+    decode_error error;
+    std::string result;
+    if (try_skip_value(context, error)) {
+      BOOST_CHECK(!error);
+      result = std::to_string(context.offset());
+    } else {
+      result = error.message() + " at " + std::to_string(error.offset());
+    }
+    BOOST_CHECK_EQUAL(result, skip_result<skip_value_scalar>(document));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // detail
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <string>
+#include <utility>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/static_object.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/encode.hpp>
+
+#include <spotify/json/test/only_true.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(codec)
+
+namespace {
+
+struct point_t {
+  int x = 0;
+  int y = 0;
+  std::string label;
+};
+
+struct labeled_point_t : point_t {
+  point_t origin;
+};
+
+auto point_codec() -> decltype(static_object<point_t>(
+    required_field("x", &point_t::x),
+    required_field("y", &point_t::y),
+    optional_field("label", &point_t::label, string()))) {
+  return static_object<point_t>(
+      required_field("x", &point_t::x),
+      required_field("y", &point_t::y),
+      optional_field("label", &point_t::label, string()));
+}
+
+template <typename codec_type>
+typename codec_type::object_type test_decode(const codec_type &codec, const std::string &json) {
+  decode_context c(json.c_str(), json.c_str() + json.size());
+  auto obj = codec.decode(c);
+  BOOST_CHECK_EQUAL(c.position, c.end);
+  return obj;
+}
+
+template <typename codec_type>
+void test_decode_fail(const codec_type &codec, const std::string &json) {
+  decode_context c(json.c_str(), json.c_str() + json.size());
+  BOOST_CHECK_THROW(codec.decode(c), decode_exception);
+}
+
+}  // namespace
+
+/*
+ * Decoding
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_decode_fields) {
+  const auto point = test_decode(point_codec(), R"({"label":"a","y":2,"x":1})");
+  BOOST_CHECK_EQUAL(point.x, 1);
+  BOOST_CHECK_EQUAL(point.y, 2);
+  BOOST_CHECK_EQUAL(point.label, "a");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_decode_with_whitespace) {
+  const auto point = test_decode(point_codec(), R"({ "x" : 1 , "y" : 2 })");
+  BOOST_CHECK_EQUAL(point.x, 1);
+  BOOST_CHECK_EQUAL(point.y, 2);
+  BOOST_CHECK_EQUAL(point.label, "");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_skip_unknown_fields) {
+  const auto point = test_decode(point_codec(), R"({"x":1,"xx":[{}],"":"","y":2,"z":null})");
+  BOOST_CHECK_EQUAL(point.x, 1);
+  BOOST_CHECK_EQUAL(point.y, 2);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_decode_escaped_keys) {
+  const auto point = test_decode(point_codec(), R"({"\u0078":1,"y":2})");
+  BOOST_CHECK_EQUAL(point.x, 1);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_require_required_fields) {
+  test_decode_fail(point_codec(), R"({})");
+  test_decode_fail(point_codec(), R"({"x":1,"label":"a"})");
+  test_decode_fail(point_codec(), R"({"x":1,"x":2})");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_overwrite_duplicate_fields) {
+  const auto point = test_decode(point_codec(), R"({"x":1,"y":2,"x":3})");
+  BOOST_CHECK_EQUAL(point.x, 3);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_not_decode_invalid_input) {
+  test_decode_fail(point_codec(), R"([])");
+  test_decode_fail(point_codec(), R"({"x":"1","y":2})");
+  test_decode_fail(point_codec(), R"({"x":1,"y":2)");
+  test_decode_fail(point_codec(), R"({"x":1,"y":2,})");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_decode_empty_field_list) {
+  const auto codec = static_object<point_t>();
+  test_decode(codec, R"({"x":1})");
+  test_decode_fail(codec, R"(null)");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_decode_nested_objects) {
+  const auto codec = static_object<labeled_point_t>(
+      required_field("x", &labeled_point_t::x),
+      required_field("origin", &labeled_point_t::origin, point_codec()));
+  const auto point = test_decode(codec, R"({"origin":{"x":1,"y":2},"x":3})");
+  BOOST_CHECK_EQUAL(point.x, 3);
+  BOOST_CHECK_EQUAL(point.origin.x, 1);
+  BOOST_CHECK_EQUAL(point.origin.y, 2);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_decode_many_required_fields) {
+  struct big_t { int a, b, c, d, e, f, g, h, i; };
+  const auto codec = static_object<big_t>(
+      required_field("a", &big_t::a), required_field("b", &big_t::b),
+      required_field("c", &big_t::c), required_field("d", &big_t::d),
+      required_field("e", &big_t::e), required_field("f", &big_t::f),
+      required_field("g", &big_t::g), required_field("h", &big_t::h),
+      required_field("i", &big_t::i));
+  const auto big = test_decode(
+      codec, R"({"i":9,"h":8,"g":7,"f":6,"e":5,"d":4,"c":3,"b":2,"a":1})");
+  BOOST_CHECK_EQUAL(big.a + big.b + big.c + big.d + big.e + big.f + big.g + big.h, 36);
+  BOOST_CHECK_EQUAL(big.i, 9);
+  test_decode_fail(codec, R"({"i":9,"h":8,"g":7,"f":6,"e":5,"d":4,"c":3,"b":2,"b":1})");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_be_constexpr) {
+  static constexpr auto codec = static_object<point_t>(
+      required_field("x", &point_t::x, number<int>()),
+      required_field("y", &point_t::y, number<int>()),
+      optional_field("label", &point_t::label, string()));
+  const auto point = test_decode(codec, R"({"x":1,"y":2,"label":"a"})");
+  BOOST_CHECK_EQUAL(point.x, 1);
+  BOOST_CHECK_EQUAL(point.label, "a");
+  BOOST_CHECK_EQUAL(encode(codec, point), R"({"x":1,"y":2,"label":"a"})");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_have_first_tokens) {
+  BOOST_CHECK_EQUAL(point_codec().first_tokens(), unsigned(detail::token_object));
+}
+
+/*
+ * Encoding
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_encode_fields_in_order) {
+  point_t point;
+  point.x = 1;
+  point.y = -2;
+  point.label = "a";
+  BOOST_CHECK_EQUAL(encode(point_codec(), point), R"({"x":1,"y":-2,"label":"a"})");
+  BOOST_CHECK_EQUAL(encode(static_object<point_t>(), point), "{}");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_encode_like_object) {
+  auto dynamic_codec = object<point_t>();
+  dynamic_codec.required("x", &point_t::x);
+  dynamic_codec.required("y", &point_t::y);
+  dynamic_codec.optional("label", &point_t::label, string());
+
+  point_t point;
+  point.x = 17;
+  point.label = "\"quoted\"";
+  BOOST_CHECK_EQUAL(encode(point_codec(), point), encode(dynamic_codec, point));
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_escape_keys) {
+  const auto codec = static_object<point_t>(
+      required_field("\"x\"", &point_t::x),
+      required_field("y\n", &point_t::y));
+  point_t point;
+  const auto json = encode(codec, point);
+  BOOST_CHECK_EQUAL(json, R"({"\"x\"":0,"y\n":0})");
+  BOOST_CHECK_EQUAL(test_decode(codec, R"({"\"x\"":1,"y\n":0})").x, 1);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_escape_keys_with_escape_policy) {
+  const auto codec = static_object<point_t>(
+      required_field("\xC3\xA5", &point_t::x),
+      required_field("<y>", &point_t::y),
+      optional_field("\"", &point_t::label));
+  const auto encode_with_policy = [&](const escape_policy escaping) {
+    encode_context context;
+    context.escaping = escaping;
+    codec.encode(context, point_t());
+    return std::string(context.data(), context.size());
+  };
+
+  BOOST_CHECK_EQUAL(encode_with_policy(escape_policy::standard), "{\"\xC3\xA5\":0,\"<y>\":0,\"\\\"\":\"\"}");
+  BOOST_CHECK_EQUAL(encode_with_policy(escape_policy::ascii), "{\"\\u00E5\":0,\"<y>\":0,\"\\\"\":\"\"}");
+  BOOST_CHECK_EQUAL(
+      encode_with_policy(escape_policy::html_safe),
+      "{\"\xC3\xA5\":0,\"\\u003Cy\\u003E\":0,\"\\\"\":\"\"}");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_static_object_should_respect_should_encode) {
+  using data_t = std::pair<bool, bool>;
+  const auto codec = static_object<data_t>(
+      optional_field("first", &data_t::first, only_true_t()),
+      required_field("second", &data_t::second, only_true_t()));
+  BOOST_CHECK_EQUAL(encode(codec, data_t(true, false)), R"({"first":true})");
+  BOOST_CHECK_EQUAL(encode(codec, data_t(false, false)), "{}");
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // codec
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
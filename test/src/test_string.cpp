@@ -267,6 +267,28 @@ BOOST_AUTO_TEST_CASE(json_codec_string_should_encode_escaped_control_characters)
   BOOST_CHECK_EQUAL(encode(std::string("\x01\x02")), "\"\\u0001\\u0002\"");
 }
 
+/*
+ * Encoding With Escape Policies
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_string_should_encode_with_escaping_of_context) {
+  encode_context context;
+  context.escaping = escape_policy::html_safe;
+  string().encode(context, "<b>");
+  BOOST_CHECK_EQUAL(std::string(context.data(), context.size()), "\"\\u003Cb\\u003E\"");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_should_encode_with_escaping_of_codec) {
+  encode_context context;
+  context.escaping = escape_policy::html_safe;
+  string(escape_policy::ascii).encode(context, "<\xC3\xA5>");
+  BOOST_CHECK_EQUAL(std::string(context.data(), context.size()), "\"<\\u00E5>\"");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_should_encode_trusted_strings_as_is) {
+  BOOST_CHECK_EQUAL(encode(string(escape_policy::trusted), std::string("a\\b")), "\"a\\b\"");
+}
+
 BOOST_AUTO_TEST_SUITE_END()  // codec
 BOOST_AUTO_TEST_SUITE_END()  // json
 BOOST_AUTO_TEST_SUITE_END()  // spotify
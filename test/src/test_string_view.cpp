@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/map.hpp>
+#include <spotify/json/codec/string_view.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/encode.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(codec)
+
+namespace {
+
+string_ref string_view_parse(const std::string &string) {
+  const auto codec = string_view();
+  auto ctx = decode_context(string.data(), string.data() + string.size());
+  const auto result = codec.decode(ctx);
+  BOOST_CHECK_EQUAL(ctx.position, ctx.end);
+  return result;
+}
+
+void string_view_parse_fail(const std::string &string) {
+  auto ctx = decode_context(string.data(), string.data() + string.size());
+  BOOST_CHECK_THROW(string_view().decode(ctx), decode_exception);
+}
+
+}  // namespace
+
+/*
+ * string_ref
+ */
+
+BOOST_AUTO_TEST_CASE(json_string_ref_should_construct_empty) {
+  const auto ref = string_ref();
+  BOOST_CHECK(ref.empty());
+  BOOST_CHECK_EQUAL(ref.size(), 0);
+  BOOST_CHECK_EQUAL(ref.str(), "");
+}
+
+BOOST_AUTO_TEST_CASE(json_string_ref_should_refer_to_std_string) {
+  const auto string = std::string("abc");
+  const auto ref = string_ref(string);
+  BOOST_CHECK_EQUAL(ref.data(), string.data());
+  BOOST_CHECK_EQUAL(ref.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(json_string_ref_should_compare_contents) {
+  const auto string = std::string("abc");
+  BOOST_CHECK(string_ref(string) == "abc");
+  BOOST_CHECK(string_ref(string) != "abd");
+  BOOST_CHECK(string_ref(string) != "ab");
+  BOOST_CHECK(string_ref() == "");
+}
+
+BOOST_AUTO_TEST_CASE(json_string_ref_should_write_to_stream) {
+  std::ostringstream stream;
+  stream << string_ref("abcdef", 3);
+  BOOST_CHECK_EQUAL(stream.str(), "abc");
+}
+
+/*
+ * Constructing
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_construct_with_helper) {
+  string_view();
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_construct_with_default_codec) {
+  default_codec<string_ref>();
+}
+
+/*
+ * Decoding
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_decode_in_place) {
+  const auto json = std::string("\"abc\"");
+  const auto ref = string_view_parse(json);
+  BOOST_CHECK_EQUAL(ref.data(), json.data() + 1);
+  BOOST_CHECK_EQUAL(ref, "abc");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_decode_empty) {
+  BOOST_CHECK_EQUAL(string_view_parse("\"\""), "");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_decode_utf8) {
+  BOOST_CHECK_EQUAL(string_view_parse("\"\xE2\x98\x83\""), "\xE2\x98\x83");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_decode_map_values) {
+  const auto json = std::string("{\"a\":\"x\",\"b\":\"yz\"}");
+  const auto map = decode<std::map<std::string, string_ref>>(json);
+  BOOST_REQUIRE_EQUAL(map.size(), 2);
+  BOOST_CHECK_EQUAL(map.at("a"), "x");
+  BOOST_CHECK_EQUAL(map.at("b"), "yz");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_not_decode_escaped_strings) {
+  string_view_parse_fail("\"\\n\"");
+  string_view_parse_fail("\"abc\\\"\"");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_not_decode_invalid) {
+  string_view_parse_fail("");
+  string_view_parse_fail("\"");
+  string_view_parse_fail("\"abc");
+  string_view_parse_fail("abc");
+}
+
+/*
+ * Encoding
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_string_view_should_encode) {
+  BOOST_CHECK_EQUAL(encode(string_ref("abc")), "\"abc\"");
+  BOOST_CHECK_EQUAL(encode(string_ref("a\"b")), "\"a\\\"b\"");
+  BOOST_CHECK_EQUAL(encode(string_ref()), "\"\"");
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // codec
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
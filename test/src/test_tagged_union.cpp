@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <memory>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/number.hpp>
+#include <spotify/json/codec/object.hpp>
+#include <spotify/json/codec/smart_ptr.hpp>
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/codec/tagged_union.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/encode.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(codec)
+
+namespace {
+
+struct media {
+  virtual ~media() = default;
+  std::string name;
+};
+
+struct track : media {
+  int duration = 0;
+};
+
+struct episode : media {
+  std::string show;
+};
+
+struct empty_media : media {
+};
+
+tagged_union_t<std::shared_ptr<media>> media_codec() {
+  auto track_codec = object<track>();
+  track_codec.required("name", &track::name);
+  track_codec.required("duration", &track::duration);
+
+  auto episode_codec = object<episode>();
+  episode_codec.required("name", &episode::name);
+  episode_codec.required("show", &episode::show);
+
+  auto codec = tagged_union<std::shared_ptr<media>>("type");
+  codec.variant("track", shared_ptr(track_codec));
+  codec.variant("episode", shared_ptr(episode_codec));
+  codec.variant("empty", shared_ptr(object<empty_media>()));
+  return codec;
+}
+
+struct shape {
+  std::string kind;
+  int size = 0;
+};
+
+tagged_union_t<shape> shape_codec() {
+  auto square = object<shape>();
+  square.required("side", &shape::size);
+
+  auto circle = object<shape>();
+  circle.required("radius", &shape::size);
+
+  auto codec = tagged_union<shape>("kind");
+  codec.variant("square", square, [](const shape &s) { return s.kind == "square"; });
+  codec.variant("circle", circle, [](const shape &s) { return s.kind == "circle"; });
+  return codec;
+}
+
+/**
+ * A codec for whole objects, without the methods for decoding one field at a
+ * time that object_t has.
+ */
+struct whole_shape_codec {
+  using object_type = shape;
+
+  whole_shape_codec() : codec(object<shape>()) {
+    codec.required("kind", &shape::kind);
+    codec.required("side", &shape::size);
+  }
+
+  object_type decode(decode_context &context) const {
+    return codec.decode(context);
+  }
+
+  void encode(encode_context &context, const object_type &value) const {
+    codec.encode(context, value);
+  }
+
+  object_t<shape> codec;
+};
+
+template <typename Codec>
+typename Codec::object_type test_decode(const Codec &codec, const std::string &json) {
+  decode_context c(json.c_str(), json.c_str() + json.size());
+  auto obj = codec.decode(c);
+  BOOST_CHECK_EQUAL(c.position, c.end);
+  return obj;
+}
+
+template <typename Codec>
+void test_decode_fail(const Codec &codec, const std::string &json, const std::string &what) {
+  decode_context c(json.c_str(), json.c_str() + json.size());
+  try {
+    codec.decode(c);
+    BOOST_FAIL("decode should have failed");
+  } catch (const decode_exception &exception) {
+    BOOST_CHECK_EQUAL(std::string(exception.what()), what);
+  }
+}
+
+}  // namespace
+
+/*
+ * Decoding
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_decode_with_tag_first) {
+  const auto value = test_decode(media_codec(), R"({"type":"track","name":"a","duration":3})");
+  const auto t = std::dynamic_pointer_cast<track>(value);
+  BOOST_REQUIRE(t);
+  BOOST_CHECK_EQUAL(t->name, "a");
+  BOOST_CHECK_EQUAL(t->duration, 3);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_decode_with_tag_last) {
+  const auto value = test_decode(
+      media_codec(),
+      R"({ "name" : "b", "extra" : {"x":[1,"}"]} , "show" : "c" , "type" : "episode" })");
+  const auto e = std::dynamic_pointer_cast<episode>(value);
+  BOOST_REQUIRE(e);
+  BOOST_CHECK_EQUAL(e->show, "c");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_skip_fields_before_tag) {
+  const auto value = test_decode(
+      media_codec(),
+      R"({"name":"b","extra":{"type":"track"},"show":"c","type":"episode"})");
+  const auto e = std::dynamic_pointer_cast<episode>(value);
+  BOOST_REQUIRE(e);
+  BOOST_CHECK_EQUAL(e->name, "b");
+  BOOST_CHECK_EQUAL(e->show, "c");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_decode_with_predicate_variants) {
+  const auto value = test_decode(shape_codec(), R"({"radius":5,"kind":"circle"})");
+  BOOST_CHECK_EQUAL(value.size, 5);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_decode_escaped_tag) {
+  const auto value = test_decode(media_codec(), "{\"ty\\u0070e\":\"tr\\u0061ck\",\"name\":\"a\",\"duration\":3}");
+  BOOST_CHECK(std::dynamic_pointer_cast<track>(value));
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_pass_tag_to_variant) {
+  auto square = object<shape>();
+  square.required("kind", &shape::kind);
+  square.required("side", &shape::size);
+  auto codec = tagged_union<shape>("kind");
+  codec.variant("square", square, [](const shape &) { return true; });
+
+  const auto value = test_decode(codec, R"({ "side" : 2 , "kind" : "square" , "x" : [] })");
+  BOOST_CHECK_EQUAL(value.kind, "square");
+  BOOST_CHECK_EQUAL(value.size, 2);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_decode_whole_object_without_partial_decoding) {
+  auto codec = tagged_union<shape>("kind");
+  codec.variant("square", whole_shape_codec(), [](const shape &) { return true; });
+
+  const auto value = test_decode(codec, R"({"side":4,"kind":"square","x":1})");
+  BOOST_CHECK_EQUAL(value.kind, "square");
+  BOOST_CHECK_EQUAL(value.size, 4);
+  test_decode_fail(codec, R"({"kind":"square"})", "Missing required field(s)");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_report_error_offsets_without_throwing) {
+  const std::string json = R"({"name":"a","type":"album"})";
+  std::shared_ptr<media> value;
+  decode_error error;
+  BOOST_CHECK(!try_decode(value, media_codec(), json, error));
+  BOOST_CHECK_EQUAL(error.message(), "Encountered unknown variant tag");
+  BOOST_CHECK_EQUAL(error.offset(), 19);
+
+  BOOST_CHECK(!try_decode(value, media_codec(), std::string(R"({"type":"track","name":1})"), error));
+  BOOST_CHECK_EQUAL(error.offset(), 23);
+
+  const std::string before_tag = R"({"duration":"x","type":"track"})";
+  BOOST_CHECK(!try_decode(value, media_codec(), before_tag, error));
+  try {
+    decode(media_codec(), before_tag);
+    BOOST_FAIL("decode should have failed");
+  } catch (const decode_exception &exception) {
+    BOOST_CHECK_EQUAL(error.message(), exception.what());
+    BOOST_CHECK_EQUAL(error.offset(), exception.offset());
+  }
+
+  BOOST_CHECK(!try_decode(value, media_codec(), std::string(R"({"type":"track","name":"a"})"), error));
+  BOOST_CHECK_EQUAL(error.message(), "Missing required field(s)");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_not_decode_without_tag) {
+  test_decode_fail(media_codec(), R"({"name":"a"})", "Missing variant tag field");
+  test_decode_fail(media_codec(), R"({})", "Missing variant tag field");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_not_decode_unknown_tag) {
+  test_decode_fail(media_codec(), R"({"type":"album"})", "Encountered unknown variant tag");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_not_decode_invalid_variant) {
+  test_decode_fail(media_codec(), R"({"type":"track","name":"a"})", "Missing required field(s)");
+  test_decode_fail(media_codec(), R"({"type":1})", "Unexpected input");
+  test_decode_fail(media_codec(), R"([])", "Unexpected input");
+}
+
+/*
+ * Encoding
+ */
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_encode_with_tag) {
+  const auto t = std::make_shared<track>();
+  t->name = "a";
+  t->duration = 3;
+  BOOST_CHECK_EQUAL(
+      encode(media_codec(), std::shared_ptr<media>(t)),
+      R"({"type":"track","name":"a","duration":3})");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_encode_empty_variant) {
+  const std::shared_ptr<media> value = std::make_shared<empty_media>();
+  BOOST_CHECK_EQUAL(encode(media_codec(), value), R"({"type":"empty"})");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_encode_with_predicate_variants) {
+  shape s;
+  s.kind = "square";
+  s.size = 2;
+  BOOST_CHECK_EQUAL(encode(shape_codec(), s), R"({"kind":"square","side":2})");
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_not_encode_unknown_variant) {
+  const std::shared_ptr<media> value = std::make_shared<media>();
+  BOOST_CHECK_THROW(encode(media_codec(), value), encode_exception);
+}
+
+BOOST_AUTO_TEST_CASE(json_codec_tagged_union_should_round_trip) {
+  const auto json = R"({"type":"episode","name":"b","show":"c"})";
+  BOOST_CHECK_EQUAL(encode(media_codec(), decode(media_codec(), json)), json);
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // codec
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/detail/decode_string.hpp>
+#include <spotify/json/detail/unescape.hpp>
+#include <spotify/json/instruction_set.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(detail)
+
+namespace {
+
+const instruction_set all_instruction_sets[] = {
+  instruction_set::scalar,
+  instruction_set::sse42,
+  instruction_set::avx2,
+  instruction_set::avx512bw
+};
+
+/**
+ * Use the given instruction set (or the best supported one below it) for as
+ * long as the object lives.
+ */
+struct scoped_instruction_set {
+  explicit scoped_instruction_set(const instruction_set set)
+      : _previous(active_instruction_set()) {
+    use_instruction_set(set);
+  }
+
+  ~scoped_instruction_set() {
+    use_instruction_set(_previous);
+  }
+
+ private:
+  const instruction_set _previous;
+};
+
+/**
+ * A JSON string with the given number of escape sequences, each preceded by
+ * run_length simple characters, and the string that it decodes to.
+ */
+std::pair<std::string, std::string> generate(const std::size_t count, const std::size_t run_length) {
+  static const char *escaped[] = { "\\n", "\\\"", "\\\\", "\\/", "\\t", "\\u20AC", "\\u00e5", "\\u0041" };
+  static const char *unescaped[] = { "\n", "\"", "\\", "/", "\t", "\xE2\x82\xAC", "\xC3\xA5", "A" };
+
+  std::pair<std::string, std::string> result("\"", "");
+  for (std::size_t i = 0; i < count; i++) {
+    const auto run = std::string(run_length, char('a' + i % 26));
+    result.first += run + escaped[i % 8];
+    result.second += run + unescaped[i % 8];
+  }
+  result.first += "tail\"";
+  result.second += "tail";
+  return result;
+}
+
+std::string decode(const std::string &json) {
+  auto context = decode_context(json.data(), json.data() + json.size());
+  const auto result = decode_string<std::string>(context);
+  BOOST_CHECK_EQUAL(context.position, context.end);
+  return result;
+}
+
+void verify_unescape_fails(const std::string &json) {
+  // The string must start with a simple character and then a backslash.
+  auto context = decode_context(json.data() + 3, json.data() + json.size());
+  const auto original_position = context.position;
+  std::string out;
+  BOOST_CHECK(!try_unescape(context, json.data() + 1, out));
+  BOOST_CHECK_EQUAL(context.position, original_position);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_unescape_should_decode_escape_sequences) {
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    BOOST_CHECK_EQUAL(decode("\"\\\"\""), "\"");
+    BOOST_CHECK_EQUAL(decode("\"\\\\\""), "\\");
+    BOOST_CHECK_EQUAL(decode("\"\\/\\b\\f\\n\\r\\t\""), "/\b\f\n\r\t");
+    BOOST_CHECK_EQUAL(decode("\"\\u0000\""), std::string(1, '\0'));
+    BOOST_CHECK_EQUAL(decode("\"\\u007F\\u0080\\u07FF\\u0800\\uFFFF\""),
+        "\x7F" "\xC2\x80" "\xDF\xBF" "\xE0\xA0\x80" "\xEF\xBF\xBF");
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_unescape_should_decode_runs_of_all_lengths) {
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    for (std::size_t run_length = 0; run_length < 70; run_length++) {
+      const auto strings = generate(20, run_length);
+      BOOST_CHECK_EQUAL(decode(strings.first), strings.second);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_unescape_should_decode_escape_dense_strings) {
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    const auto strings = generate(10000, 1);
+    BOOST_CHECK_EQUAL(decode(strings.first), strings.second);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_unescape_should_stop_at_closing_quote) {
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    const auto json = std::string("\"a\\\\\",\"b\\\"\"");
+    auto context = decode_context(json.data(), json.data() + json.size());
+    BOOST_CHECK_EQUAL(decode_string<std::string>(context), "a\\");
+    BOOST_CHECK_EQUAL(context.offset(), 5);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_unescape_should_give_up_on_invalid_strings) {
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    verify_unescape_fails("\"a\\n");
+    verify_unescape_fails("\"a\\");
+    verify_unescape_fails("\"a\\x\"");
+    verify_unescape_fails("\"a\\u12\"");
+    verify_unescape_fails("\"a\\u12G4\"");
+    verify_unescape_fails("\"a\\nbcdefghijklmnopqrstuvwxyz0123456789\\q\"");
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_unescape_should_report_errors_like_before) {
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    const auto check = [](const std::string &json, const char *message, const std::size_t offset) {
+      auto context = decode_context(json.data(), json.data() + json.size());
+      try {
+        decode_string<std::string>(context);
+        BOOST_ERROR("Expected decode_exception");
+      } catch (const decode_exception &exception) {
+        BOOST_CHECK_EQUAL(exception.what(), message);
+        BOOST_CHECK_EQUAL(exception.offset(), offset);
+      }
+    };
+
+    check("\"a\\nb", "Unterminated string", 5);
+    check("\"a\\xb\"", "Invalid escape character", 3);
+    check("\"a\\u12G4\"", "\\u must be followed by 4 hex digits", 7);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // detail
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2017 Spotify AB
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <spotify/json/codec/string.hpp>
+#include <spotify/json/decode.hpp>
+#include <spotify/json/decode_error.hpp>
+#include <spotify/json/decode_exception.hpp>
+#include <spotify/json/detail/decode_string.hpp>
+#include <spotify/json/detail/skip_value.hpp>
+#include <spotify/json/instruction_set.hpp>
+
+BOOST_AUTO_TEST_SUITE(spotify)
+BOOST_AUTO_TEST_SUITE(json)
+BOOST_AUTO_TEST_SUITE(detail)
+
+namespace {
+
+const instruction_set all_instruction_sets[] = {
+  instruction_set::scalar,
+  instruction_set::sse42,
+  instruction_set::avx2,
+  instruction_set::avx512bw
+};
+
+/**
+ * Use the given instruction set (or the best supported one below it) for as
+ * long as the object lives.
+ */
+struct scoped_instruction_set {
+  explicit scoped_instruction_set(const instruction_set set)
+      : _previous(active_instruction_set()) {
+    use_instruction_set(set);
+  }
+
+  ~scoped_instruction_set() {
+    use_instruction_set(_previous);
+  }
+
+ private:
+  const instruction_set _previous;
+};
+
+/**
+ * Padding of every length up to a few chunks, so that the interesting bytes
+ * end up at every position of a chunk, and across chunk boundaries.
+ */
+const std::size_t max_padding = 70;
+
+std::string decode_strict(const std::string &json) {
+  auto context = decode_context(json.data(), json.data() + json.size());
+  context.strict_utf8 = true;
+  const auto result = decode_string<std::string>(context);
+  BOOST_CHECK_EQUAL(context.position, context.end);
+  return result;
+}
+
+void verify_decode_strict_fails(const std::string &json, const char *message, const std::size_t offset) {
+  auto context = decode_context(json.data(), json.data() + json.size());
+  context.strict_utf8 = true;
+  try {
+    decode_string<std::string>(context);
+    BOOST_ERROR("Expected decode_exception for " << json);
+  } catch (const decode_exception &exception) {
+    BOOST_CHECK_EQUAL(exception.what(), message);
+    BOOST_CHECK_EQUAL(exception.offset(), offset);
+  }
+}
+
+void verify_skip_strict_fails(const std::string &json, const decode_error::code_type code, const std::size_t offset) {
+  auto context = decode_context(json.data(), json.data() + json.size());
+  context.strict_utf8 = true;
+  decode_error error;
+  BOOST_CHECK(!try_skip_value(context, error));
+  BOOST_CHECK_EQUAL(error.code(), code);
+  BOOST_CHECK_EQUAL(error.offset(), offset);
+}
+
+/**
+ * Invalid sequences, each followed by the offset of the byte that the error
+ * is reported at, relative to the start of the sequence.
+ */
+const std::pair<const char *, std::size_t> invalid_sequences[] = {
+  { "\x80", 0 },                  // continuation byte without a lead byte
+  { "\xBF\xBF", 0 },              // two continuation bytes
+  { "\xC3\xA9\xA9", 2 },          // one continuation byte too many
+  { "\xC0\x80", 0 },              // overlong two byte sequence
+  { "\xC1\xBF", 0 },              // overlong two byte sequence
+  { "\xE0\x9F\xBF", 0 },          // overlong three byte sequence
+  { "\xF0\x8F\xBF\xBF", 0 },      // overlong four byte sequence
+  { "\xED\xA0\x80", 0 },          // encoded surrogate
+  { "\xF4\x90\x80\x80", 0 },      // past U+10FFFF
+  { "\xF5\x80\x80\x80", 0 },      // invalid lead byte
+  { "\xFF", 0 },                  // invalid lead byte
+  { "\xC3" "a", 0 },              // missing continuation byte
+  { "\xE2\x82" "a", 0 },          // missing continuation byte
+  { "\xF0\x9F\x98" "a", 0 },      // missing continuation byte
+  { "\xE2\x82", 0 },              // cut off by the closing quote
+  { "\xC3\\n", 0 }                // cut off by an escape sequence
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(json_utf8_should_be_off_by_default) {
+  const auto json = std::string("\"\xFF\xC0\x80\xED\xA0\x80\"");
+  auto context = decode_context(json.data(), json.data() + json.size());
+  BOOST_CHECK(!context.strict_utf8);
+  BOOST_CHECK_EQUAL(decode_string<std::string>(context), "\xFF\xC0\x80\xED\xA0\x80");
+}
+
+BOOST_AUTO_TEST_CASE(json_utf8_should_accept_valid_utf8) {
+  const auto valid = std::string(
+      "\x7F" "\xC2\x80" "\xDF\xBF" "\xE0\xA0\x80" "\xED\x9F\xBF" "\xEE\x80\x80" "\xEF\xBF\xBF"
+      "\xF0\x90\x80\x80" "\xF4\x8F\xBF\xBF" "\xC3\xA5\xC3\xA4\xC3\xB6" "\xF0\x9F\x98\x80");
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    for (std::size_t padding = 0; padding < max_padding; padding++) {
+      const auto before = std::string(padding, 'a');
+      BOOST_CHECK_EQUAL(decode_strict("\"" + before + valid + "\""), before + valid);
+      BOOST_CHECK_EQUAL(decode_strict("\"" + before + valid + "\\n" + valid + "\""), before + valid + "\n" + valid);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_utf8_should_reject_invalid_utf8) {
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    for (const auto &sequence : invalid_sequences) {
+      for (std::size_t padding = 0; padding < max_padding; padding++) {
+        const auto before = "\"" + std::string(padding, 'a');
+        const auto offset = before.size() + sequence.second;
+        verify_decode_strict_fails(before + sequence.first + "\"", "Invalid UTF-8", offset);
+        verify_decode_strict_fails(before + sequence.first + std::string(40, 'b') + "\"", "Invalid UTF-8", offset);
+        verify_skip_strict_fails(before + sequence.first + "\"", decode_error::invalid_utf8, offset);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_utf8_should_reject_invalid_utf8_after_escape_sequences) {
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    verify_decode_strict_fails("\"a\\nb\xC0\x80\"", "Invalid UTF-8", 5);
+    verify_decode_strict_fails("\"\xC3\xA5\\u00e5\xFF\"", "Invalid UTF-8", 9);
+    verify_skip_strict_fails("\"a\\nb\xC0\x80\"", decode_error::invalid_utf8, 5);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_utf8_should_not_validate_past_the_string) {
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    const auto json = std::string("\"\xC3\xA5\"\xFF\xFF");
+    auto context = decode_context(json.data(), json.data() + json.size());
+    context.strict_utf8 = true;
+    BOOST_CHECK_EQUAL(decode_string<std::string>(context), "\xC3\xA5");
+    BOOST_CHECK_EQUAL(context.offset(), 4);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_utf8_should_report_unterminated_strings) {
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    verify_decode_strict_fails("\"abc\xE2\x82", "Unterminated string", 6);
+    verify_decode_strict_fails("\"" + std::string(40, 'a') + "\xF0\x9F", "Unterminated string", 43);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_utf8_should_decode_surrogate_pairs) {
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    for (const auto strict : { false, true }) {
+      auto json = std::string("\"a\\uD83D\\uDE00b\\ud800\\udc00\\uDBFF\\uDFFF\"");
+      auto context = decode_context(json.data(), json.data() + json.size());
+      context.strict_utf8 = strict;
+      BOOST_CHECK_EQUAL(decode_string<std::string>(context),
+          "a" "\xF0\x9F\x98\x80" "b" "\xF0\x90\x80\x80" "\xF4\x8F\xBF\xBF");
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_utf8_should_encode_unpaired_surrogates_by_default) {
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    const auto json = std::string("\"\\uD83Da\\uDE00\\uD83D\\u0041\\uD83D\"");
+    auto context = decode_context(json.data(), json.data() + json.size());
+    BOOST_CHECK_EQUAL(decode_string<std::string>(context),
+        "\xED\xA0\xBD" "a" "\xED\xB8\x80" "\xED\xA0\xBD" "A" "\xED\xA0\xBD");
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_utf8_should_reject_unpaired_surrogates) {
+  const auto message = "Unpaired surrogate in \\u escape sequence";
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    verify_decode_strict_fails("\"ab\\uD83D\"", message, 3);
+    verify_decode_strict_fails("\"ab\\uD83Dx\"", message, 3);
+    verify_decode_strict_fails("\"ab\\uD83D\\u0041\"", message, 3);
+    verify_decode_strict_fails("\"ab\\uD83D\\uD83D\\uDE00\"", message, 3);
+    verify_decode_strict_fails("\"ab\\uDE00\"", message, 3);
+    verify_skip_strict_fails("\"ab\\uD83D\"", decode_error::unpaired_surrogate, 3);
+    verify_skip_strict_fails("\"ab\\uD83D\\u0041\"", decode_error::unpaired_surrogate, 3);
+    verify_skip_strict_fails("\"ab\\uDE00\"", decode_error::unpaired_surrogate, 3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_utf8_should_skip_values_in_strict_mode) {
+  for (const auto set : all_instruction_sets) {
+    const scoped_instruction_set scope(set);
+    const auto json = std::string("[{\"\xC3\xA5\":\"\\uD83D\\uDE00\xF0\x9F\x98\x80\"},\"" + std::string(40, 'a') + "\"]");
+    auto context = decode_context(json.data(), json.data() + json.size());
+    context.strict_utf8 = true;
+    decode_error error;
+    BOOST_CHECK(try_skip_value(context, error));
+    BOOST_CHECK_EQUAL(context.position, context.end);
+    verify_skip_strict_fails("[{\"a\":[1,\"\xC0\x80\"]}]", decode_error::invalid_utf8, 10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(json_utf8_should_decode_strict_utf8_documents) {
+  const auto codec = codec::string();
+  BOOST_CHECK_EQUAL(decode_strict_utf8(codec, std::string("\"\xC3\xA5\\uD83D\\uDE00\"")), "\xC3\xA5\xF0\x9F\x98\x80");
+  BOOST_CHECK_THROW(decode_strict_utf8(codec, std::string("\"\xC3\"")), decode_exception);
+  BOOST_CHECK_THROW(decode_strict_utf8(codec, std::string("\"\\uDE00\"")), decode_exception);
+  BOOST_CHECK_EQUAL(decode(codec, std::string("\"\xC3\"")), "\xC3");
+}
+
+BOOST_AUTO_TEST_SUITE_END()  // detail
+BOOST_AUTO_TEST_SUITE_END()  // json
+BOOST_AUTO_TEST_SUITE_END()  // spotify